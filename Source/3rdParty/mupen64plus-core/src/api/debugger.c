@@ -34,6 +34,7 @@
 #include "debugger/dbg_memory.h"
 #include "device/device.h"
 #include "device/memory/memory.h"
+#include "device/r4300/cached_interp.h"
 #include "device/r4300/r4300_core.h"
 #include "device/r4300/tlb.h"
 #include "m64p_debugger.h"
@@ -143,6 +144,10 @@ EXPORT int CALL DebugGetState(m64p_dbg_state statenum)
             return get_r4300_emumode(&g_dev.r4300);
         case M64P_DBG_CPU_NEXT_INTERRUPT:
             return *r4300_cp0_next_interrupt(&g_dev.r4300.cp0);
+        case M64P_DBG_CPU_CACHED_PAGES_ALLOCATED:
+            return g_dev.r4300.cached_interp.arena.pages_allocated;
+        case M64P_DBG_CPU_CACHED_ARENA_KB:
+            return (int)(get_arena_memsize(&g_dev.r4300.cached_interp.arena) / 1024);
         default:
             DebugMessage(M64MSG_WARNING, "Bug: invalid m64p_dbg_state input in DebugGetState()");
             return 0;
@@ -36,6 +36,7 @@
 #include "m64p_config.h"
 #include "m64p_frontend.h"
 #include "m64p_types.h"
+#include "backends/file_storage.h"
 #include "main/cheat.h"
 #include "main/eventloop.h"
 #include "main/main.h"
@@ -371,6 +372,16 @@ EXPORT m64p_error CALL CoreDoCommand(m64p_command Command, int ParamInt, void *P
                 return M64ERR_INCOMPATIBLE;
         case M64CMD_NETPLAY_CLOSE:
             return netplay_stop();
+        case M64CMD_NETPLAY_GET_STATS:
+            if (ParamInt != sizeof(m64p_netplay_stats) || ParamPtr == NULL)
+                return M64ERR_INPUT_INVALID;
+            return netplay_get_stats((m64p_netplay_stats*)ParamPtr);
+        case M64CMD_NETPLAY_SET_ROLLBACK:
+            return netplay_set_rollback(ParamInt);
+        case M64CMD_STORAGE_GET_STATS:
+            if (ParamInt != sizeof(m64p_storage_stats) || ParamPtr == NULL)
+                return M64ERR_INPUT_INVALID;
+            return get_file_storage_stats((m64p_storage_stats*)ParamPtr);
         default:
             return M64ERR_INPUT_INVALID;
     }
@@ -21,7 +21,10 @@
 
 #include "file_storage.h"
 
+#include <SDL.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "api/callbacks.h"
 #include "api/m64p_types.h"
@@ -29,13 +32,161 @@
 #include "device/dd/dd_controller.h"
 #include "main/util.h"
 #include "main/netplay.h"
+#include "main/workqueue.h"
+#include "osal/files.h"
+
+/* changes are written once the game stopped touching the storage for
+ * FILE_STORAGE_FLUSH_DELAY ms, or at the latest FILE_STORAGE_FLUSH_MAX_DELAY ms
+ * after the first change, so games saving every frame still get flushed */
+#define FILE_STORAGE_FLUSH_DELAY     500
+#define FILE_STORAGE_FLUSH_MAX_DELAY 3000
+
+struct file_storage_flush
+{
+    struct file_storage* fstorage;
+    char* filename;
+    uint8_t* data;
+    size_t size;
+    size_t dirty_start;
+    size_t dirty_end;
+    unsigned int queued;
+    struct work_struct work;
+    struct list_head failed;
+};
+
+static LIST_HEAD(l_dirty_storages);
+static SDL_atomic_t l_pending_flushes;
+
+/* both are written by the workqueue, so they're guarded by l_flush_lock */
+static SDL_SpinLock l_flush_lock;
+static LIST_HEAD(l_failed_flushes);
+static m64p_storage_stats l_stats;
+
+static void file_storage_flush_work(struct work_struct* work)
+{
+    struct file_storage_flush* flush = container_of(work, struct file_storage_flush, work);
+    char* tmp_filename = formatstr("%s.tmp", flush->filename);
+    file_status_t err = file_open_error;
+
+    /* write the whole storage next to the old file, then swap it in,
+     * so a crash never leaves a half written save behind */
+    if (tmp_filename != NULL) {
+        err = write_to_file(tmp_filename, flush->data, flush->size);
+        if (err == file_ok && osal_file_replace(tmp_filename, flush->filename) != 0) {
+            err = write_to_file(flush->filename, flush->data, flush->size);
+        }
+        remove(tmp_filename);
+        free(tmp_filename);
+    }
+
+    switch(err)
+    {
+    case file_open_error:
+        DebugMessage(M64MSG_WARNING, "couldn't open storage file '%s' for writing", flush->filename);
+        break;
+    case file_write_error:
+        DebugMessage(M64MSG_WARNING, "failed to write storage file '%s'", flush->filename);
+        break;
+    default:
+        break;
+    }
+
+    free(flush->filename);
+    free(flush->data);
+    flush->filename = NULL;
+    flush->data = NULL;
+
+    SDL_AtomicLock(&l_flush_lock);
+    if (err == file_ok) {
+        ++l_stats.flushes;
+        l_stats.bytes_written += flush->size;
+        l_stats.bytes_dirty += flush->dirty_end - flush->dirty_start;
+    }
+    else {
+        ++l_stats.flush_errors;
+    }
+
+    l_stats.last_flush_ms = SDL_GetTicks() - flush->queued;
+    if (l_stats.last_flush_ms > l_stats.max_flush_ms)
+        l_stats.max_flush_ms = l_stats.last_flush_ms;
+
+    /* the dirty list belongs to the emulation thread,
+     * so it puts the storage back on it, see requeue_failed_flushes */
+    if (err != file_ok) {
+        list_add_tail(&flush->failed, &l_failed_flushes);
+        flush = NULL;
+    }
+    SDL_AtomicUnlock(&l_flush_lock);
+
+    free(flush);
+
+    SDL_AtomicAdd(&l_pending_flushes, -1);
+}
+
+static void mark_file_storage_dirty(struct file_storage* fstorage, size_t start, size_t end, unsigned int now)
+{
+    if (list_empty(&fstorage->dirty)) {
+        fstorage->dirty_start = start;
+        fstorage->dirty_end = end;
+        fstorage->dirty_first = now;
+        list_add_tail(&fstorage->dirty, &l_dirty_storages);
+    }
+    else {
+        if (start < fstorage->dirty_start)
+            fstorage->dirty_start = start;
+        if (end > fstorage->dirty_end)
+            fstorage->dirty_end = end;
+    }
+    fstorage->dirty_last = now;
+}
+
+/* puts storages whose write failed back on the dirty list,
+ * so they're written again once the flush delay has passed */
+static void requeue_failed_flushes(void)
+{
+    struct file_storage_flush* flush;
+    struct file_storage_flush* safe;
+    LIST_HEAD(failed);
+    unsigned int now = SDL_GetTicks();
+
+    SDL_AtomicLock(&l_flush_lock);
+    if (!list_empty(&l_failed_flushes)) {
+        failed.next = l_failed_flushes.next;
+        failed.prev = l_failed_flushes.prev;
+        failed.next->prev = &failed;
+        failed.prev->next = &failed;
+        INIT_LIST_HEAD(&l_failed_flushes);
+    }
+    SDL_AtomicUnlock(&l_flush_lock);
+
+    list_for_each_entry_safe_t(flush, safe, &failed, struct file_storage_flush, failed) {
+        list_del(&flush->failed);
+        mark_file_storage_dirty(flush->fstorage, flush->dirty_start, flush->dirty_end, now);
+        free(flush);
+    }
+}
+
+static int is_file_storage_initialized(const struct file_storage* fstorage)
+{
+    /* storages which were never set up by init_file_storage, or
+     * which were cleared after closing them, have no list head */
+    return fstorage->dirty.next != NULL;
+}
+
+void init_file_storage(struct file_storage* fstorage, uint8_t* data, size_t size, const char* filename)
+{
+    fstorage->data = data;
+    fstorage->size = size;
+    fstorage->filename = filename;
+    fstorage->dirty_start = 0;
+    fstorage->dirty_end = 0;
+    INIT_LIST_HEAD(&fstorage->dirty);
+}
 
 int open_file_storage(struct file_storage* fstorage, size_t size, const char* filename)
 {
     /* ! Take ownership of filename ! */
-    fstorage->filename = filename;
-    fstorage->size = size;
-    fstorage->first_access = 1;
+    init_file_storage(fstorage, NULL, size, filename);
 
     /* allocate memory for holding data */
     fstorage->data = malloc(fstorage->size);
@@ -56,10 +207,7 @@ int open_file_storage(struct file_storage* fstorage, size_t size, const char* fi
 
 int open_rom_file_storage(struct file_storage* fstorage, const char* filename)
 {
-    fstorage->data = NULL;
-    fstorage->size = 0;
-    fstorage->filename = NULL;
-    fstorage->first_access = 1;
+    init_file_storage(fstorage, NULL, 0, NULL);
 
     file_status_t err = load_file(filename, (void**)&fstorage->data, &fstorage->size);
 
@@ -73,10 +221,101 @@ int open_rom_file_storage(struct file_storage* fstorage, const char* filename)
 
 void close_file_storage(struct file_storage* fstorage)
 {
+    if (is_file_storage_initialized(fstorage)) {
+        flush_file_storage(fstorage);
+        wait_file_storages();
+
+        /* retry a failed write once, after that the changes are lost */
+        requeue_failed_flushes();
+        flush_file_storage(fstorage);
+        wait_file_storages();
+        requeue_failed_flushes();
+
+        if (!list_empty(&fstorage->dirty)) {
+            DebugMessage(M64MSG_ERROR, "couldn't write storage file '%s', changes are lost", fstorage->filename);
+            list_del_init(&fstorage->dirty);
+        }
+    }
+
     free((void*)fstorage->data);
     free((void*)fstorage->filename);
 }
 
+void flush_file_storage(struct file_storage* fstorage)
+{
+    if (!is_file_storage_initialized(fstorage) || list_empty(&fstorage->dirty))
+        return;
+
+    list_del_init(&fstorage->dirty);
+
+    /* the emulation keeps modifying the storage, so the workqueue gets its own copy */
+    struct file_storage_flush* flush = malloc(sizeof(*flush));
+    if (flush != NULL) {
+        flush->filename = strdup(fstorage->filename);
+        flush->data = malloc(fstorage->size);
+    }
+
+    if (flush == NULL || flush->filename == NULL || flush->data == NULL) {
+        DebugMessage(M64MSG_WARNING, "couldn't allocate memory to flush storage file '%s'", fstorage->filename);
+        if (flush != NULL) {
+            free(flush->filename);
+            free(flush->data);
+            free(flush);
+        }
+        SDL_AtomicLock(&l_flush_lock);
+        ++l_stats.flush_errors;
+        SDL_AtomicUnlock(&l_flush_lock);
+        return;
+    }
+
+    memcpy(flush->data, fstorage->data, fstorage->size);
+    flush->fstorage = fstorage;
+    flush->size = fstorage->size;
+    flush->dirty_start = fstorage->dirty_start;
+    flush->dirty_end = fstorage->dirty_end;
+    flush->queued = SDL_GetTicks();
+    fstorage->dirty_start = 0;
+    fstorage->dirty_end = 0;
+
+    SDL_AtomicAdd(&l_pending_flushes, 1);
+    init_work(&flush->work, file_storage_flush_work);
+    queue_work(&flush->work);
+}
+
+void flush_file_storages(int force)
+{
+    struct file_storage* fstorage;
+    struct file_storage* safe;
+    unsigned int now;
+
+    requeue_failed_flushes();
+
+    now = SDL_GetTicks();
+    list_for_each_entry_safe_t(fstorage, safe, &l_dirty_storages, struct file_storage, dirty) {
+        if (force
+         || (now - fstorage->dirty_last) >= FILE_STORAGE_FLUSH_DELAY
+         || (now - fstorage->dirty_first) >= FILE_STORAGE_FLUSH_MAX_DELAY) {
+            flush_file_storage(fstorage);
+        }
+    }
+}
+
+void wait_file_storages(void)
+{
+    while (SDL_AtomicGet(&l_pending_flushes) > 0) {
+        SDL_Delay(1);
+    }
+}
+
+m64p_error get_file_storage_stats(m64p_storage_stats* stats)
+{
+    SDL_AtomicLock(&l_flush_lock);
+    *stats = l_stats;
+    SDL_AtomicUnlock(&l_flush_lock);
+    stats->pending_flushes = SDL_AtomicGet(&l_pending_flushes);
+    return M64ERR_SUCCESS;
+}
+
 
 static uint8_t* file_storage_data(const void* storage)
 {
@@ -96,36 +335,17 @@ static void file_storage_save(void* storage, size_t start, size_t size)
         return;
 
     struct file_storage* fstorage = (struct file_storage*)storage;
+    unsigned int now = SDL_GetTicks();
 
-    file_status_t err;
-
-    /* On first save access ignore start/size and write full storage content,
-     * otherwise write only updated chunk */
-    if (fstorage->first_access) {
-        fstorage->first_access = 0;
-        err = write_to_file(fstorage->filename, fstorage->data, fstorage->size);
-    }
-    else {
-        err = write_chunk_to_file(fstorage->filename, fstorage->data + start, size, start);
-    }
-
-    switch(err)
-    {
-    case file_open_error:
-        DebugMessage(M64MSG_WARNING, "couldn't open storage file '%s' for writing", fstorage->filename);
-        break;
-    case file_write_error:
-        DebugMessage(M64MSG_WARNING, "failed to write storage file '%s'", fstorage->filename);
-        break;
-    default:
-        break;
-    }
+    /* only record the change, the file is written later by flush_file_storages */
+    mark_file_storage_dirty(fstorage, start, start + size, now);
 }
 
 static void file_storage_parent_save(void* storage, size_t start, size_t size)
 {
-    struct file_storage* fstorage = (struct file_storage*)((struct file_storage*)storage)->filename;
-    file_storage_save(fstorage, start, size);
+    struct file_storage* sub_fstorage = (struct file_storage*)storage;
+    struct file_storage* fstorage = (struct file_storage*)sub_fstorage->filename;
+    file_storage_save(fstorage, (size_t)(sub_fstorage->data - fstorage->data) + start, size);
 }
 
 static void dummy_save(void* storage, size_t start, size_t size)
@@ -25,19 +25,39 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "api/m64p_types.h"
+#include "main/list.h"
+
 struct file_storage
 {
     uint8_t* data;
     size_t size;
     const char* filename;
-    int first_access;
+
+    /* write-back state: changes are coalesced into a dirty range
+     * which is written out later by the workqueue */
+    size_t dirty_start;
+    size_t dirty_end;
+    unsigned int dirty_first;
+    unsigned int dirty_last;
+    struct list_head dirty;
 };
 
 
+void init_file_storage(struct file_storage* storage, uint8_t* data, size_t size, const char* filename);
 int open_file_storage(struct file_storage* storage, size_t size, const char* filename);
 int open_rom_file_storage(struct file_storage* storage, const char* filename);
 void close_file_storage(struct file_storage* storage);
 
+/* queue the pending changes of a storage for writing */
+void flush_file_storage(struct file_storage* storage);
+/* queue the storages whose changes have settled, or all of them if force is set */
+void flush_file_storages(int force);
+/* wait until every queued write has hit the disk */
+void wait_file_storages(void);
+
+m64p_error get_file_storage_stats(m64p_storage_stats* stats);
+
 extern const struct storage_backend_interface g_ifile_storage;
 extern const struct storage_backend_interface g_ifile_storage_ro;
 extern const struct storage_backend_interface g_isubfile_storage;
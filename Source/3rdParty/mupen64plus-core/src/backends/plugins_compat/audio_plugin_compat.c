@@ -26,6 +26,7 @@
 #include "device/rcp/ri/ri_controller.h"
 #include "device/rcp/vi/vi_controller.h"
 #include "device/rdram/rdram.h"
+#include "main/netplay.h"
 #include "main/rom.h"
 #include "plugin/plugin.h"
 
@@ -45,6 +46,11 @@ static void audio_plugin_push_samples(void* aout, const void* buffer, size_t siz
 {
     /* abuse core & audio plugin implementation to approximate desired effect */
     struct ai_controller* ai = (struct ai_controller*)aout;
+
+    /* samples replayed after a netplay rollback have already been played */
+    if (netplay_is_resimulating())
+        return;
+
     uint32_t saved_ai_length = ai->regs[AI_LEN_REG];
     uint32_t saved_ai_dram = ai->regs[AI_DRAM_ADDR_REG];
 
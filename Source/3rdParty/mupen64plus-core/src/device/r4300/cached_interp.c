@@ -736,6 +736,76 @@ static uint32_t update_invalid_addr(struct r4300_core* r4300, uint32_t addr)
     }
 }
 
+/* number of pages carved out of a single arena chunk */
+#define ARENA_PAGES_PER_CHUNK 32
+
+struct cached_interp_chunk
+{
+    struct cached_interp_chunk* next;
+    size_t used;
+    unsigned char pages[];
+};
+
+static void init_arena(struct cached_interp_arena* arena)
+{
+    memset(arena, 0, sizeof(*arena));
+}
+
+static void release_arena(struct cached_interp_arena* arena)
+{
+    struct cached_interp_chunk* chunk = arena->chunks;
+
+    while (chunk != NULL)
+    {
+        struct cached_interp_chunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->chunks = NULL;
+    arena->chunk_count = 0;
+    arena->pages_allocated = 0;
+}
+
+static struct precomp_instr* arena_alloc_page(struct cached_interp_arena* arena, size_t memsize)
+{
+    struct cached_interp_chunk* chunk = arena->chunks;
+    void* page;
+
+    /* all cached interpreter blocks span a full 4KB page,
+     * so every page handed out by the arena has the same size */
+    if (arena->page_size == 0) {
+        /* keep pages pointer-aligned within a chunk */
+        arena->page_size = (memsize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    }
+    assert(memsize <= arena->page_size);
+
+    if (chunk == NULL || chunk->used == ARENA_PAGES_PER_CHUNK)
+    {
+        chunk = malloc(sizeof(*chunk) + ARENA_PAGES_PER_CHUNK * arena->page_size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+
+        chunk->next = arena->chunks;
+        chunk->used = 0;
+        arena->chunks = chunk;
+        ++arena->chunk_count;
+    }
+
+    page = chunk->pages + chunk->used * arena->page_size;
+    ++chunk->used;
+    ++arena->pages_allocated;
+
+    memset(page, 0, arena->page_size);
+    return (struct precomp_instr*)page;
+}
+
+size_t get_arena_memsize(const struct cached_interp_arena* arena)
+{
+    return (size_t)arena->chunk_count * ARENA_PAGES_PER_CHUNK * arena->page_size;
+}
+
 int get_block_length(const struct precomp_block *block)
 {
     return (block->end-block->start)/4;
@@ -772,14 +842,11 @@ void cached_interp_init_block(struct r4300_core* r4300, uint32_t address)
     /* allocate block instructions */
     if (!b->block)
     {
-        size_t memsize = get_block_memsize(b);
-        b->block = (struct precomp_instr*)malloc(memsize);
+        b->block = arena_alloc_page(&r4300->cached_interp.arena, get_block_memsize(b));
         if (!b->block) {
             DebugMessage(M64MSG_ERROR, "Memory error: couldn't allocate memory for cached interpreter.");
             return;
         }
-
-        memset(b->block, 0, memsize);
     }
 
     /* reset block instructions (addr + ops) */
@@ -820,10 +887,9 @@ void cached_interp_init_block(struct r4300_core* r4300, uint32_t address)
 
 void cached_interp_free_block(struct precomp_block* block)
 {
-    if (block->block) {
-        free(block->block);
-        block->block = NULL;
-    }
+    /* the page itself is released together with the arena,
+     * blocks are never freed while the arena is still in use */
+    block->block = NULL;
 }
 
 void cached_interp_recompile_block(struct r4300_core* r4300, const uint32_t* iw, struct precomp_block* block, uint32_t func)
@@ -927,6 +993,7 @@ void init_blocks(struct cached_interp* cinterp)
         cinterp->invalid_code[i] = 1;
         cinterp->blocks[i] = NULL;
     }
+    init_arena(&cinterp->arena);
 }
 
 void free_blocks(struct cached_interp* cinterp)
@@ -941,6 +1008,7 @@ void free_blocks(struct cached_interp* cinterp)
             cinterp->blocks[i] = NULL;
         }
     }
+    release_arena(&cinterp->arena);
 }
 
 void invalidate_cached_code_hacktarux(struct r4300_core* r4300, uint32_t address, size_t size)
@@ -29,6 +29,7 @@
 
 struct r4300_core;
 struct cached_interp;
+struct cached_interp_arena;
 struct r4300_idec;
 struct precomp_block;
 struct precomp_instr;
@@ -43,6 +44,8 @@ void cached_interp_free_block(struct precomp_block* block);
 
 void cached_interp_recompile_block(struct r4300_core* r4300, const uint32_t* iw, struct precomp_block* block, uint32_t func);
 
+size_t get_arena_memsize(const struct cached_interp_arena* arena);
+
 void init_blocks(struct cached_interp* cinterp);
 void free_blocks(struct cached_interp* cinterp);
 
@@ -141,6 +141,7 @@ enum r4300_cp0_registers
 
 
 enum { INTERRUPT_NODES_POOL_CAPACITY = 16 };
+enum { INTERRUPT_TYPES_COUNT = 16 };
 
 struct interrupt_event
 {
@@ -151,7 +152,9 @@ struct interrupt_event
 struct node
 {
     struct interrupt_event data;
-    struct node *next;
+    unsigned int seq;  /* insertion order, keeps events with equal count in FIFO order */
+    int front;         /* set for events forced to the front of the queue (CHECK_INT) */
+    size_t pos;        /* index of the node in the heap */
 };
 
 struct pool
@@ -161,10 +164,21 @@ struct pool
     size_t index;
 };
 
+/* Indexed binary min-heap of pending events.
+ * heap[0] is always the next event to be triggered. */
 struct interrupt_queue
 {
     struct pool pool;
-    struct node* first;
+    struct node* heap[INTERRUPT_NODES_POOL_CAPACITY];
+    size_t size;
+
+    /* per-type lookup, by_type[i] is only meaningful when type_count[i] == 1 */
+    struct node* by_type[INTERRUPT_TYPES_COUNT];
+    unsigned int type_count[INTERRUPT_TYPES_COUNT];
+
+    /* count value all pending events are compared against */
+    unsigned int base;
+    unsigned int seq;
 };
 
 struct interrupt_handler
@@ -44,11 +44,12 @@
 #include "device/rcp/ai/ai_controller.h"
 #include "device/rcp/vi/vi_controller.h"
 #include "main/main.h"
+#include "main/netplay.h"
 #include "main/savestates.h"
 
 
 /***************************************************************************
- * Pool of Single Linked List Nodes
+ * Pool of Interrupt Queue Nodes
  **************************************************************************/
 
 static struct node* alloc_node(struct pool* p);
@@ -94,11 +95,15 @@ static void clear_pool(struct pool* p)
 
 static void clear_queue(struct interrupt_queue* q)
 {
-    q->first = NULL;
+    q->size = 0;
+    q->base = 0;
+    q->seq = 0;
+    memset(q->by_type, 0, sizeof(q->by_type));
+    memset(q->type_count, 0, sizeof(q->type_count));
     clear_pool(&q->pool);
 }
 
-static int before_event(const struct cp0* cp0, unsigned int evt1, unsigned int evt2, int type2)
+static unsigned int get_event_base(const struct cp0* cp0)
 {
     const uint32_t* cp0_regs = r4300_cp0_regs((struct cp0*)cp0); /* OK to cast away const qualifier */
     uint32_t count = cp0_regs[CP0_COUNT_REG];
@@ -108,8 +113,169 @@ static int before_event(const struct cp0* cp0, unsigned int evt1, unsigned int e
     if (*cp0_cycle_count > 0)
         count -= *cp0_cycle_count;
 
-    if ((evt1 - count) < (evt2 - count)) return 1;
-    else return 0;
+    return count;
+}
+
+static int before_event(const struct interrupt_queue* q, const struct node* e1, const struct node* e2)
+{
+    uint32_t count1, count2;
+
+    /* events forced to the front are ordered last-in first-out */
+    if (e1->front != e2->front) return e1->front;
+    if (e1->front) return (int)(e1->seq - e2->seq) > 0;
+
+    count1 = e1->data.count - q->base;
+    count2 = e2->data.count - q->base;
+
+    if (count1 != count2) return count1 < count2;
+
+    /* events with the same count are ordered first-in first-out */
+    return (int)(e1->seq - e2->seq) < 0;
+}
+
+static int get_type_index(int type)
+{
+    int i;
+
+    for (i = 0; i < INTERRUPT_TYPES_COUNT; ++i)
+    {
+        if (type == (1 << i)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void swap_nodes(struct interrupt_queue* q, size_t i, size_t j)
+{
+    struct node* e = q->heap[i];
+
+    q->heap[i] = q->heap[j];
+    q->heap[j] = e;
+    q->heap[i]->pos = i;
+    q->heap[j]->pos = j;
+}
+
+static void sift_up(struct interrupt_queue* q, size_t i)
+{
+    while (i > 0)
+    {
+        size_t parent = (i - 1) / 2;
+
+        if (!before_event(q, q->heap[i], q->heap[parent])) {
+            break;
+        }
+
+        swap_nodes(q, i, parent);
+        i = parent;
+    }
+}
+
+static void sift_down(struct interrupt_queue* q, size_t i)
+{
+    for (;;)
+    {
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        size_t smallest = i;
+
+        if (left < q->size && before_event(q, q->heap[left], q->heap[smallest])) {
+            smallest = left;
+        }
+        if (right < q->size && before_event(q, q->heap[right], q->heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
+        }
+
+        swap_nodes(q, i, smallest);
+        i = smallest;
+    }
+}
+
+/* returns the pending event of the given type which will be triggered first */
+static struct node* find_event(const struct interrupt_queue* q, int type)
+{
+    struct node* found = NULL;
+    size_t i;
+    int index = get_type_index(type);
+
+    if (index >= 0)
+    {
+        if (q->type_count[index] == 0) {
+            return NULL;
+        }
+        if (q->type_count[index] == 1) {
+            return q->by_type[index];
+        }
+    }
+
+    /* duplicate (or unknown) event type, fallback to a scan of the heap */
+    for (i = 0; i < q->size; ++i)
+    {
+        if (q->heap[i]->data.type == type &&
+            (found == NULL || before_event(q, q->heap[i], found))) {
+            found = q->heap[i];
+        }
+    }
+
+    return found;
+}
+
+static void push_node(struct interrupt_queue* q, struct node* event)
+{
+    int index = get_type_index(event->data.type);
+
+    event->seq = q->seq++;
+    event->pos = q->size;
+    q->heap[q->size++] = event;
+    sift_up(q, event->pos);
+
+    if (index >= 0)
+    {
+        q->by_type[index] = event;
+        ++q->type_count[index];
+    }
+}
+
+static void remove_node(struct interrupt_queue* q, struct node* event)
+{
+    size_t pos = event->pos;
+    int index = get_type_index(event->data.type);
+
+    if (pos != --q->size)
+    {
+        swap_nodes(q, pos, q->size);
+        sift_down(q, pos);
+        sift_up(q, pos);
+    }
+
+    free_node(&q->pool, event);
+
+    if (index >= 0 && --q->type_count[index] == 1)
+    {
+        size_t i;
+
+        for (i = 0; q->heap[i]->data.type != event->data.type; ++i);
+        q->by_type[index] = q->heap[i];
+    }
+}
+
+static void update_next_interrupt(struct cp0* cp0)
+{
+    const uint32_t* cp0_regs = r4300_cp0_regs(cp0);
+    unsigned int* cp0_next_interrupt = r4300_cp0_next_interrupt(cp0);
+    int* cp0_cycle_count = r4300_cp0_cycle_count(cp0);
+
+    *cp0_next_interrupt = (cp0->q.size != 0)
+        ? cp0->q.heap[0]->data.count
+        : 0;
+
+    *cp0_cycle_count = (cp0->q.size != 0)
+        ? (cp0_regs[CP0_COUNT_REG] - cp0->q.heap[0]->data.count)
+        : 0;
 }
 
 unsigned int add_random_interrupt_time(struct r4300_core* r4300)
@@ -135,12 +301,8 @@ void add_interrupt_event(struct cp0* cp0, int type, unsigned int delay)
 void add_interrupt_event_count(struct cp0* cp0, int type, unsigned int count)
 {
     struct node* event;
-    struct node* e;
-    const uint32_t* cp0_regs = r4300_cp0_regs(cp0);
-    unsigned int* cp0_next_interrupt = r4300_cp0_next_interrupt(cp0);
-    int* cp0_cycle_count = r4300_cp0_cycle_count(cp0);
 
-    if (get_event(&cp0->q, type)) {
+    if (find_event(&cp0->q, type)) {
         DebugMessage(M64MSG_WARNING, "two events of type 0x%x in interrupt queue", type);
     }
 
@@ -153,127 +315,60 @@ void add_interrupt_event_count(struct cp0* cp0, int type, unsigned int count)
 
     event->data.count = count;
     event->data.type = type;
+    event->front = 0;
 
-    if (cp0->q.first == NULL)
-    {
-        cp0->q.first = event;
-        event->next = NULL;
-    }
-    else if (before_event(cp0, count, cp0->q.first->data.count, cp0->q.first->data.type))
-    {
-        event->next = cp0->q.first;
-        cp0->q.first = event;
-    }
-    else
-    {
-        for (e = cp0->q.first;
-            e->next != NULL &&
-            (!before_event(cp0, count, e->next->data.count, e->next->data.type));
-            e = e->next);
-
-        if (e->next == NULL)
-        {
-            e->next = event;
-            event->next = NULL;
-        }
-        else
-        {
-            for(; e->next != NULL && e->next->data.count == count; e = e->next);
+    cp0->q.base = get_event_base(cp0);
+    push_node(&cp0->q, event);
 
-            event->next = e->next;
-            e->next = event;
-        }
-    }
-    *cp0_next_interrupt = cp0->q.first->data.count;
-    *cp0_cycle_count = cp0_regs[CP0_COUNT_REG] - cp0->q.first->data.count;
+    update_next_interrupt(cp0);
 }
 
 void remove_interrupt_event(struct cp0* cp0)
 {
-    struct node* e;
-    const uint32_t* cp0_regs = r4300_cp0_regs(cp0);
-    unsigned int* cp0_next_interrupt = r4300_cp0_next_interrupt(cp0);
-    int* cp0_cycle_count = r4300_cp0_cycle_count(cp0);
-
-    e = cp0->q.first;
-    cp0->q.first = e->next;
-    free_node(&cp0->q.pool, e);
-
-    *cp0_next_interrupt = (cp0->q.first != NULL)
-        ? cp0->q.first->data.count
-        : 0;
-
-    *cp0_cycle_count = (cp0->q.first != NULL)
-        ? (cp0_regs[CP0_COUNT_REG] - cp0->q.first->data.count)
-        : 0;
+    remove_node(&cp0->q, cp0->q.heap[0]);
+    update_next_interrupt(cp0);
 }
 
 unsigned int* get_event(const struct interrupt_queue* q, int type)
 {
-    struct node* e = q->first;
+    struct node* e = find_event(q, type);
 
-    if (e == NULL) {
-        return NULL;
-    }
-
-    if (e->data.type == type) {
-        return &e->data.count;
-    }
-
-    for (; e->next != NULL && e->next->data.type != type; e = e->next);
-
-    return (e->next != NULL)
-        ? &e->next->data.count
+    return (e != NULL)
+        ? &e->data.count
         : NULL;
 }
 
 int get_next_event_type(const struct interrupt_queue* q)
 {
-    return (q->first == NULL)
+    return (q->size == 0)
         ? 0
-        : q->first->data.type;
+        : q->heap[0]->data.type;
 }
 
 void remove_event(struct interrupt_queue* q, int type)
 {
-    struct node* to_del;
-    struct node* e = q->first;
+    struct node* e = find_event(q, type);
 
-    if (e == NULL) {
-        return;
-    }
-
-    if (e->data.type == type)
-    {
-        q->first = e->next;
-        free_node(&q->pool, e);
-    }
-    else
-    {
-        for (; e->next != NULL && e->next->data.type != type; e = e->next);
-
-        if (e->next != NULL)
-        {
-            to_del = e->next;
-            e->next = to_del->next;
-            free_node(&q->pool, to_del);
-        }
+    if (e != NULL) {
+        remove_node(q, e);
     }
 }
 
 void translate_event_queue(struct cp0* cp0, unsigned int base)
 {
-    struct node* e;
+    size_t i;
     uint32_t* cp0_regs = r4300_cp0_regs(cp0);
     int* cp0_cycle_count = r4300_cp0_cycle_count(cp0);
 
     remove_event(&cp0->q, COMPARE_INT);
     remove_event(&cp0->q, SPECIAL_INT);
 
-    for (e = cp0->q.first; e != NULL; e = e->next)
+    /* shifting every event by the same amount keeps the heap ordered */
+    for (i = 0; i < cp0->q.size; ++i)
     {
-        e->data.count = (e->data.count - cp0_regs[CP0_COUNT_REG]) + base;
+        cp0->q.heap[i]->data.count = (cp0->q.heap[i]->data.count - cp0_regs[CP0_COUNT_REG]) + base;
     }
+    cp0->q.base = (cp0->q.base - cp0_regs[CP0_COUNT_REG]) + base;
 
     cp0_regs[CP0_COUNT_REG] = base;
     add_interrupt_event_count(cp0, SPECIAL_INT, ((cp0_regs[CP0_COUNT_REG] & UINT32_C(0x80000000)) ^ UINT32_C(0x80000000)));
@@ -285,20 +380,32 @@ void translate_event_queue(struct cp0* cp0, unsigned int base)
     cp0_regs[CP0_COUNT_REG] -= cp0->count_per_op;
 
     /* Update next interrupt in case first event is COMPARE_INT */
-    *cp0_cycle_count = cp0_regs[CP0_COUNT_REG] - cp0->q.first->data.count;
+    *cp0_cycle_count = cp0_regs[CP0_COUNT_REG] - cp0->q.heap[0]->data.count;
 }
 
 int save_eventqueue_infos(const struct cp0* cp0, char *buf)
 {
     int len;
-    struct node* e;
+    size_t i, j;
+    struct node* events[INTERRUPT_NODES_POOL_CAPACITY];
+
+    /* events are saved in trigger order, sort a copy of the heap */
+    for (i = 0; i < cp0->q.size; ++i)
+    {
+        struct node* e = cp0->q.heap[i];
+
+        for (j = i; j > 0 && before_event(&cp0->q, e, events[j - 1]); --j) {
+            events[j] = events[j - 1];
+        }
+        events[j] = e;
+    }
 
     len = 0;
 
-    for (e = cp0->q.first; e != NULL; e = e->next)
+    for (i = 0; i < cp0->q.size; ++i)
     {
-        memcpy(buf + len    , &e->data.type , 4);
-        memcpy(buf + len + 4, &e->data.count, 4);
+        memcpy(buf + len    , &events[i]->data.type , 4);
+        memcpy(buf + len + 4, &events[i]->data.count, 4);
         len += 8;
     }
 
@@ -361,19 +468,10 @@ void r4300_check_interrupt(struct r4300_core* r4300, uint32_t cause_ip, int set_
 
         event->data.count = *cp0_next_interrupt = cp0_regs[CP0_COUNT_REG];
         event->data.type = CHECK_INT;
+        event->front = 1;
         *cp0_cycle_count = 0;
 
-        if (r4300->cp0.q.first == NULL)
-        {
-            r4300->cp0.q.first = event;
-            event->next = NULL;
-        }
-        else
-        {
-            event->next = r4300->cp0.q.first;
-            r4300->cp0.q.first = event;
-
-        }
+        push_node(&r4300->cp0.q, event);
     }
 }
 
@@ -406,7 +504,7 @@ void compare_int_handler(void* opaque)
     cp0_regs[CP0_COUNT_REG] -= r4300->cp0.count_per_op;
 
     /* Update next interrupt in case first event is COMPARE_INT */
-    *cp0_cycle_count = cp0_regs[CP0_COUNT_REG] - r4300->cp0.q.first->data.count;
+    *cp0_cycle_count = cp0_regs[CP0_COUNT_REG] - r4300->cp0.q.heap[0]->data.count;
 
     raise_maskable_interrupt(r4300, CP0_CAUSE_IP7);
 }
@@ -534,10 +632,6 @@ static void call_interrupt_handler(const struct cp0* cp0, size_t index)
 
 void gen_interrupt(struct r4300_core* r4300)
 {
-    uint32_t* cp0_regs = r4300_cp0_regs(&r4300->cp0);
-    unsigned int* cp0_next_interrupt = r4300_cp0_next_interrupt(&r4300->cp0);
-    int* cp0_cycle_count = r4300_cp0_cycle_count(&r4300->cp0);
-
     if (*r4300_stop(r4300) == 1)
     {
         g_gs_vi_counter = 0; // debug
@@ -556,6 +650,9 @@ void gen_interrupt(struct r4300_core* r4300)
             return;
         }
 
+        if (netplay_load_snapshot())
+            return;
+
         if (r4300->reset_hard_job)
         {
             call_interrupt_handler(&r4300->cp0, 11);
@@ -568,20 +665,14 @@ void gen_interrupt(struct r4300_core* r4300)
         uint32_t dest = r4300->skip_jump;
         r4300->skip_jump = 0;
 
-        *cp0_next_interrupt = (r4300->cp0.q.first != NULL)
-            ? r4300->cp0.q.first->data.count
-            : 0;
-
-        *cp0_cycle_count = (r4300->cp0.q.first != NULL)
-            ? (cp0_regs[CP0_COUNT_REG] - r4300->cp0.q.first->data.count)
-            : 0;
+        update_next_interrupt(&r4300->cp0);
 
         r4300->cp0.last_addr = dest;
         generic_jump_to(r4300, dest);
         return;
     }
 
-    switch (r4300->cp0.q.first->data.type)
+    switch (r4300->cp0.q.heap[0]->data.type)
     {
         case VI_INT:
             call_interrupt_handler(&r4300->cp0, 0);
@@ -657,7 +748,7 @@ void gen_interrupt(struct r4300_core* r4300)
             break;
 
         default:
-            DebugMessage(M64MSG_ERROR, "Unknown interrupt queue event type %.8X.", r4300->cp0.q.first->data.type);
+            DebugMessage(M64MSG_ERROR, "Unknown interrupt queue event type %.8X.", r4300->cp0.q.heap[0]->data.type);
             remove_interrupt_event(&r4300->cp0);
             exception_general(r4300);
             break;
@@ -665,6 +756,8 @@ void gen_interrupt(struct r4300_core* r4300)
 
     if (!r4300->cp0.interrupt_unsafe_state)
     {
+        netplay_save_snapshot();
+
         if (savestates_get_job() == savestates_job_save)
         {
             savestates_save();
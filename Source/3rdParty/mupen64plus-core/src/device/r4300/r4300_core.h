@@ -44,12 +44,31 @@ struct mi_controller;
 struct rdram;
 
 struct jump_table;
+struct cached_interp_chunk;
+
+/* Slab allocator backing the precomp_instr arrays of the cached interpreter.
+ * Every page has the same size, so pages are carved out of large chunks
+ * instead of hitting malloc for each block. Blocks are only freed all at
+ * once, so pages aren't returned individually, the whole arena is released.
+ */
+struct cached_interp_arena
+{
+    struct cached_interp_chunk* chunks;
+    size_t page_size;
+
+    /* statistics (exposed through DebugGetState) */
+    unsigned int chunk_count;
+    unsigned int pages_allocated;
+};
+
 struct cached_interp
 {
     char invalid_code[0x100000];
     struct precomp_block* blocks[0x100000];
     struct precomp_block* actual;
 
+    struct cached_interp_arena arena;
+
     void (*fin_block)(void);
     void (*not_compiled)(void);
     void (*not_compiled2)(void);
@@ -1051,6 +1051,7 @@ static void pause_loop(void)
 {
     if(g_rom_pause)
     {
+        flush_file_storages(1);
         osd_render();  // draw Paused message in case gfx.updateScreen didn't do it
         VidExt_GL_SwapBuffers();
         while(g_rom_pause)
@@ -1073,6 +1074,7 @@ void new_vi(void)
 
     apply_speed_limiter();
     main_check_inputs();
+    flush_file_storages(0);
 
     pause_loop();
 
@@ -1348,17 +1350,11 @@ static int load_dd_disk(struct dd_disk* dd_disk, const struct storage_backend_in
     {
     case 0: /* Full disk */
         *dd_idisk = &g_istorage_disk_full;
-        fstorage_save->filename = save_filename;
-        fstorage_save->data = fstorage->data;
-        fstorage_save->size = fstorage->size;
-        fstorage_save->first_access = 1;
+        init_file_storage(fstorage_save, fstorage->data, fstorage->size, save_filename);
         break;
     case 1: /* RAM only */
         *dd_idisk = &g_istorage_disk_ram_only;
-        fstorage_save->filename = save_filename;
-        fstorage_save->data = &fstorage->data[offset_ram];
-        fstorage_save->size = size_ram;
-        fstorage_save->first_access = 1;
+        init_file_storage(fstorage_save, &fstorage->data[offset_ram], size_ram, save_filename);
         break;
     default: /* read only */
         *dd_idisk = &g_istorage_disk_read_only;
@@ -1424,7 +1420,10 @@ no_disk:
 static void close_dd_disk(struct dd_disk* disk)
 {
     if (disk->save_storage != NULL) {
-        /* no need to close save_storage as it is a child of disk->storage */
+        /* no need to close save_storage as it is a child of disk->storage,
+         * but its pending changes still have to be written */
+        flush_file_storage(disk->save_storage);
+        wait_file_storages();
         free(disk->save_storage);
         disk->save_storage = NULL;
     }
@@ -1766,7 +1765,6 @@ m64p_error main_run(void)
             cin_compats[i].last_pak_type = Controls[i].Plugin;
             cin_compats[i].last_input = 0;
             cin_compats[i].netplay_count = 0;
-            cin_compats[i].event_first = NULL;
 
             Controls[i].Plugin = PLUGIN_NONE;
 
@@ -1794,7 +1792,6 @@ m64p_error main_run(void)
             cin_compats[i].last_pak_type = Controls[i].Plugin;
             cin_compats[i].last_input = 0;
             cin_compats[i].netplay_count = 0;
-            cin_compats[i].event_first = NULL;
 
             l_gb_carts_data[i].control_id = (int)i;
 
@@ -28,12 +28,37 @@
 #include "plugin/plugin.h"
 #include "backends/plugins_compat/plugins_compat.h"
 #include "netplay.h"
+#include "savestates.h"
 
 #include <SDL_net.h>
 #if !defined(WIN32)
 #include <netinet/ip.h>
 #endif
 
+//Every input packet also carries the previous inputs of that player,
+//so a single lost packet doesn't stall the other clients
+#define NETPLAY_INPUT_REDUNDANCY 2
+
+#define UDP_SEND_PACKET_SIZE ((CP0_REGS_COUNT * 4) + 5)
+#define UDP_RECV_PACKET_SIZE 512
+
+//An input that has been handed to the game (rollback mode only)
+//It is kept around so the game can be re-simulated with the same inputs after a rollback
+struct netplay_input {
+    struct netplay_event event;
+    uint32_t vi;
+    uint8_t predicted;
+};
+
+//The emulator state at the start of a VI (rollback mode only)
+struct netplay_snapshot {
+    unsigned char *data;
+    uint32_t vi;
+    uint32_t count[4];
+    uint8_t plugin[4];
+    uint8_t valid;
+};
+
 static int l_canFF;
 static int l_netplay_controller;
 static int l_netplay_control[4];
@@ -49,6 +74,25 @@ static struct controller_input_compat *l_cin_compats;
 static uint8_t l_plugin[4];
 static uint8_t l_buffer_target;
 static uint8_t l_player_lag[4];
+static struct netplay_event l_events[4][NETPLAY_EVENT_BUFFER_SIZE];
+static uint16_t l_event_count[4];
+static struct netplay_event l_sent_events[4][NETPLAY_INPUT_REDUNDANCY];
+static uint32_t l_next_received_count[4];
+static UDPpacket *l_send_packet;
+static UDPpacket *l_recv_packet;
+static m64p_netplay_stats l_stats;
+static int l_rollback_frames;
+static struct netplay_input l_inputs[4][NETPLAY_EVENT_BUFFER_SIZE];
+static uint32_t l_confirmed_count[4];
+static uint8_t l_rollback_pending;
+static uint32_t l_rollback_count[4];
+static struct netplay_snapshot *l_snapshots;
+static uint32_t l_snapshot_count;
+static uint8_t l_snapshot_job;
+static uint8_t l_resimulating;
+static uint32_t l_resim_end;
+static uint32_t l_vi_start_count[4];
+static uint32_t l_vi_reads[4];
 
 //UDP packet formats
 #define UDP_SEND_KEY_INFO 0
@@ -73,6 +117,53 @@ struct __UDPSocket {
 
 #define CS4 32
 
+static void netplay_clear_events()
+{
+    memset(l_events, 0, sizeof(l_events));
+    memset(l_event_count, 0, sizeof(l_event_count));
+    memset(l_sent_events, 0, sizeof(l_sent_events));
+    memset(l_next_received_count, 0, sizeof(l_next_received_count));
+    memset(l_inputs, 0, sizeof(l_inputs));
+    memset(l_confirmed_count, 0, sizeof(l_confirmed_count));
+    memset(l_vi_start_count, 0, sizeof(l_vi_start_count));
+    memset(l_vi_reads, 0, sizeof(l_vi_reads));
+    l_rollback_pending = 0;
+    l_resimulating = 0;
+}
+
+static void netplay_free_snapshots()
+{
+    if (l_snapshots == NULL)
+        return;
+
+    for (uint32_t i = 0; i < l_snapshot_count; ++i)
+        free(l_snapshots[i].data);
+    free(l_snapshots);
+    l_snapshots = NULL;
+    l_snapshot_count = 0;
+    l_snapshot_job = 0;
+}
+
+static int netplay_alloc_snapshots()
+{
+    //One snapshot per VI we are allowed to run ahead, plus the current one
+    l_snapshot_count = l_rollback_frames + 1;
+    l_snapshots = calloc(l_snapshot_count, sizeof(struct netplay_snapshot));
+    if (l_snapshots == NULL)
+        return 0;
+
+    for (uint32_t i = 0; i < l_snapshot_count; ++i)
+    {
+        l_snapshots[i].data = calloc(1, M64P_SAVESTATE_SIZE);
+        if (l_snapshots[i].data == NULL)
+        {
+            netplay_free_snapshots();
+            return 0;
+        }
+    }
+    return 1;
+}
+
 m64p_error netplay_start(const char* host, int port)
 {
     if (SDLNet_Init() < 0)
@@ -115,6 +206,23 @@ m64p_error netplay_start(const char* host, int port)
         return M64ERR_SYSTEM_FAIL;
     }
 
+    //packets are allocated once and re-used for every message
+    l_send_packet = SDLNet_AllocPacket(UDP_SEND_PACKET_SIZE);
+    l_recv_packet = SDLNet_AllocPacket(UDP_RECV_PACKET_SIZE);
+    if (l_send_packet == NULL || l_recv_packet == NULL)
+    {
+        DebugMessage(M64MSG_ERROR, "Netplay: could not allocate UDP packets");
+        SDLNet_FreePacket(l_send_packet);
+        SDLNet_FreePacket(l_recv_packet);
+        l_send_packet = NULL;
+        l_recv_packet = NULL;
+        SDLNet_TCP_Close(l_tcpSocket);
+        l_tcpSocket = NULL;
+        SDLNet_UDP_Close(l_udpSocket);
+        l_udpSocket = NULL;
+        return M64ERR_SYSTEM_FAIL;
+    }
+
     for (int i = 0; i < 4; ++i)
     {
         l_netplay_control[i] = -1;
@@ -129,6 +237,10 @@ m64p_error netplay_start(const char* host, int port)
     l_vi_counter = 0;
     l_status = 0;
     l_reg_id = 0;
+    l_cin_compats = NULL;
+    l_rollback_frames = 0;
+    memset(&l_stats, 0, sizeof(l_stats));
+    netplay_clear_events();
 
     return M64ERR_SUCCESS;
 }
@@ -139,26 +251,20 @@ m64p_error netplay_stop()
         return M64ERR_INVALID_STATE;
     else
     {
-        if (l_cin_compats != NULL)
-        {
-            for (int i = 0; i < 4; ++i)
-            {
-                struct netplay_event* current = l_cin_compats[i].event_first;
-                struct netplay_event* next;
-                while (current != NULL)
-                {
-                    next = current->next;
-                    free(current);
-                    current = next;
-                }
-            }
-        }
+        netplay_clear_events();
+        netplay_free_snapshots();
+        l_rollback_frames = 0;
 
         char output_data[5];
         output_data[0] = TCP_DISCONNECT_NOTICE;
         SDLNet_Write32(l_reg_id, &output_data[1]);
         SDLNet_TCP_Send(l_tcpSocket, &output_data[0], 5);
 
+        SDLNet_FreePacket(l_send_packet);
+        SDLNet_FreePacket(l_recv_packet);
+        l_send_packet = NULL;
+        l_recv_packet = NULL;
+
         SDLNet_UDP_Unbind(l_udpSocket, l_udpChannel);
         SDLNet_UDP_Close(l_udpSocket);
         SDLNet_TCP_Close(l_tcpSocket);
@@ -179,41 +285,136 @@ int netplay_is_init()
 static uint8_t buffer_size(uint8_t control_id)
 {
     //This function returns the size of the local input buffer
-    uint8_t counter = 0;
-    struct netplay_event* current = l_cin_compats[control_id].event_first;
-    while (current != NULL)
+    return (l_event_count[control_id] > UINT8_MAX) ? UINT8_MAX : (uint8_t)l_event_count[control_id];
+}
+
+static struct netplay_event* netplay_event_slot(uint8_t control_id, uint32_t count)
+{
+    //Events are stored in a ring buffer indexed by their count
+    return &l_events[control_id][count & (NETPLAY_EVENT_BUFFER_SIZE - 1)];
+}
+
+static void netplay_send_packet(UDPpacket *packet)
+{
+    SDLNet_UDP_Send(l_udpSocket, l_udpChannel, packet);
+    ++l_stats.packets_sent;
+}
+
+static struct netplay_input* netplay_input_slot(uint8_t control_id, uint32_t count)
+{
+    //Inputs handed to the game share the indexing of the event ring buffer
+    return &l_inputs[control_id][count & (NETPLAY_EVENT_BUFFER_SIZE - 1)];
+}
+
+static struct netplay_input* netplay_fed_input(uint8_t control_id, uint32_t count)
+{
+    //Returns the input the game used for this event, if it has already been handed out
+    struct netplay_input* input = netplay_input_slot(control_id, count);
+    if (l_rollback_frames == 0 || !input->event.valid || input->event.count != count)
+        return NULL;
+    return input;
+}
+
+static void netplay_update_confirmed(uint8_t control_id)
+{
+    //Every input before l_confirmed_count has been confirmed by the server
+    struct netplay_input* input;
+    while ((input = netplay_fed_input(control_id, l_confirmed_count[control_id])) != NULL && !input->predicted)
+        ++l_confirmed_count[control_id];
+}
+
+static const struct netplay_input* netplay_oldest_prediction(uint8_t control_id)
+{
+    const struct netplay_input* input = netplay_fed_input(control_id, l_confirmed_count[control_id]);
+    return (input != NULL && input->predicted) ? input : NULL;
+}
+
+static int netplay_has_predictions()
+{
+    if (l_rollback_pending)
+        return 1;
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        if (netplay_oldest_prediction(i) != NULL)
+            return 1;
+    }
+    return 0;
+}
+
+static int netplay_can_predict()
+{
+    //We can only run ahead if the state at the start of this VI has been saved,
+    //and if the oldest unconfirmed prediction is still covered by a snapshot
+    if (l_snapshots == NULL || l_snapshot_job)
+        return 0;
+
+    const struct netplay_snapshot* snapshot = &l_snapshots[l_vi_counter % l_snapshot_count];
+    if (!snapshot->valid || snapshot->vi != l_vi_counter)
+        return 0;
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        const struct netplay_input* oldest = netplay_oldest_prediction(i);
+        if (oldest != NULL && (l_vi_counter - oldest->vi) >= (uint32_t)l_rollback_frames)
+            return 0;
+    }
+    return 1;
+}
+
+static int netplay_confirm_input(uint8_t control_id, uint32_t count, uint32_t keys, uint8_t plugin)
+{
+    //Returns 1 if the game has already used an input for this event
+    //If that input was a wrong prediction, a rollback to before it is scheduled
+    struct netplay_input* input = netplay_fed_input(control_id, count);
+    if (input == NULL)
+        return 0;
+
+    if (!input->predicted)
+    {
+        ++l_stats.events_discarded;
+        return 1;
+    }
+
+    if (input->event.buttons != keys || input->event.plugin != plugin)
     {
-        current = current->next;
-        ++counter;
+        input->event.buttons = keys;
+        input->event.plugin = plugin;
+        ++l_stats.mispredictions;
+
+        if (!(l_rollback_pending & (1 << control_id)) || (int32_t)(count - l_rollback_count[control_id]) < 0)
+            l_rollback_count[control_id] = count;
+        l_rollback_pending |= 1 << control_id;
     }
-    return counter;
+
+    input->predicted = 0;
+    netplay_update_confirmed(control_id);
+    ++l_stats.events_received;
+    return 1;
 }
 
 static void netplay_request_input(uint8_t control_id)
 {
-    UDPpacket *packet = SDLNet_AllocPacket(12);
+    //in rollback mode we also need the inputs we are still running ahead of
+    const struct netplay_input* oldest = netplay_oldest_prediction(control_id);
+    uint32_t count = (oldest != NULL) ? oldest->event.count : l_cin_compats[control_id].netplay_count;
+
+    UDPpacket *packet = l_send_packet;
     packet->data[0] = UDP_REQUEST_KEY_INFO;
     packet->data[1] = control_id; //The player we need input for
     SDLNet_Write32(l_reg_id, &packet->data[2]); //our registration ID
-    SDLNet_Write32(l_cin_compats[control_id].netplay_count, &packet->data[6]); //the current event count
+    SDLNet_Write32(count, &packet->data[6]); //the first event count we need
     packet->data[10] = l_spectator; //whether we are a spectator
     packet->data[11] = buffer_size(control_id); //our local buffer size
     packet->len = 12;
-    SDLNet_UDP_Send(l_udpSocket, l_udpChannel, packet);
-    SDLNet_FreePacket(packet);
+    netplay_send_packet(packet);
 }
 
 static int check_valid(uint8_t control_id, uint32_t count)
 {
     //Check if we already have this event recorded locally, returns 1 if we do
-    struct netplay_event* current = l_cin_compats[control_id].event_first;
-    while (current != NULL)
-    {
-        if (current->count == count) //event already recorded
-            return 1;
-        current = current->next;
-    }
-    return 0;
+    const struct netplay_event* event = netplay_event_slot(control_id, count);
+    return event->valid && event->count == count;
 }
 
 static int netplay_require_response(void* opaque)
@@ -232,6 +433,7 @@ static int netplay_require_response(void* opaque)
             return 0;
         }
         netplay_request_input(control_id);
+        ++l_stats.input_requests;
         SDL_Delay(5);
     }
     return 1;
@@ -240,11 +442,12 @@ static int netplay_require_response(void* opaque)
 static void netplay_process()
 {
     //In this function we process data we have received from the server
-    UDPpacket *packet = SDLNet_AllocPacket(512);
+    UDPpacket *packet = l_recv_packet;
     uint32_t curr, count, keys;
     uint8_t plugin, player, current_status;
     while (SDLNet_UDP_Recv(l_udpSocket, packet) == 1)
     {
+        ++l_stats.packets_received;
         switch (packet->data[0])
         {
             case UDP_RECEIVE_KEY_INFO:
@@ -267,31 +470,42 @@ static void netplay_process()
                     l_status = current_status;
                 }
                 curr = 5;
-                //this loop processes input data from the server, inserting new events into the linked list for each player
-                //it skips events that we have already recorded, or if we receive data for an event that has already happened
+                //this loop processes input data from the server, inserting new events into the ring buffer for each player
+                //it skips events that we have already recorded, if we receive data for an event that has already happened,
+                //or if the event is too far ahead to fit in the ring buffer
                 for (uint8_t i = 0; i < packet->data[4]; ++i)
                 {
                     count = SDLNet_Read32(&packet->data[curr]);
                     curr += 4;
-
-                    if (((count - l_cin_compats[player].netplay_count) > (UINT32_MAX / 2)) || (check_valid(player, count))) //event doesn't need to be recorded
-                    {
-                        curr += 5;
-                        continue;
-                    }
-
                     keys = SDLNet_Read32(&packet->data[curr]);
                     curr += 4;
                     plugin = packet->data[curr];
                     curr += 1;
 
-                    //insert new event at beginning of linked list
-                    struct netplay_event* new_event = (struct netplay_event*)malloc(sizeof(struct netplay_event));
+                    //a jump in the event counts means events were lost on their way to us
+                    if ((int32_t)(count - l_next_received_count[player]) >= 0)
+                    {
+                        l_stats.events_missed += count - l_next_received_count[player];
+                        l_next_received_count[player] = count + 1;
+                    }
+
+                    if (netplay_confirm_input(player, count, keys, plugin)) //the game already ran with an input for this event
+                        continue;
+
+                    if (((count - l_cin_compats[player].netplay_count) >= NETPLAY_EVENT_BUFFER_SIZE) || (check_valid(player, count))) //event doesn't need to be recorded
+                    {
+                        ++l_stats.events_discarded;
+                        continue;
+                    }
+
+                    //the slot is free, every event before netplay_count has been consumed
+                    struct netplay_event* new_event = netplay_event_slot(player, count);
                     new_event->count = count;
                     new_event->buttons = keys;
                     new_event->plugin = plugin;
-                    new_event->next = l_cin_compats[player].event_first;
-                    l_cin_compats[player].event_first = new_event;
+                    new_event->valid = 1;
+                    ++l_event_count[player];
+                    ++l_stats.events_received;
                 }
                 break;
             default:
@@ -299,7 +513,6 @@ static void netplay_process()
                 break;
         }
     }
-    SDLNet_FreePacket(packet);
 }
 
 static int netplay_ensure_valid(uint8_t control_id)
@@ -312,43 +525,115 @@ static int netplay_ensure_valid(uint8_t control_id)
     if (l_udpChannel == -1)
         return 0;
 
+    uint32_t start = SDL_GetTicks();
+    ++l_stats.input_stalls;
+
     SDL_Thread* thread = SDL_CreateThread(netplay_require_response, "Netplay key request", &control_id);
 
     while (!check_valid(control_id, l_cin_compats[control_id].netplay_count) && l_udpChannel != -1)
         netplay_process();
     int success;
     SDL_WaitThread(thread, &success);
+
+    uint32_t wait = SDL_GetTicks() - start;
+    l_stats.input_wait_ms += wait;
+    if (wait > l_stats.input_wait_max_ms)
+        l_stats.input_wait_max_ms = wait;
+
     return success;
 }
 
-static void netplay_delete_event(struct netplay_event* current, uint8_t control_id)
+static void netplay_feed_input(uint8_t control_id, const struct netplay_event* event, uint8_t predicted)
+{
+    //Record the input handed to the game, so it can be replayed or corrected after a rollback
+    if (l_rollback_frames == 0)
+        return;
+
+    struct netplay_input* input = netplay_input_slot(control_id, event->count);
+    input->event = *event;
+    input->event.valid = 1;
+    input->vi = l_vi_counter;
+    input->predicted = predicted;
+    netplay_update_confirmed(control_id);
+}
+
+static uint32_t netplay_replay_input(uint8_t control_id, struct netplay_input* input)
 {
-    //This function deletes an event from the linked list
-    struct netplay_event* find = l_cin_compats[control_id].event_first;
-    while (find != NULL)
+    //We are re-simulating after a rollback, this event has already been handed to the game
+    //Confirmed inputs are replayed as is, predictions are made again from the (possibly corrected) previous input
+    if (input->predicted)
     {
-        if (find->next == current)
+        const struct netplay_input* previous = netplay_fed_input(control_id, input->event.count - 1);
+        if (previous != NULL)
         {
-            find->next = current->next;
-            break;
+            input->event.buttons = previous->event.buttons;
+            input->event.plugin = previous->event.plugin;
         }
-        find = find->next;
     }
-    if (current == l_cin_compats[control_id].event_first)
-        l_cin_compats[control_id].event_first = l_cin_compats[control_id].event_first->next;
-    free(current);
+    input->vi = l_vi_counter;
+    Controls[control_id].Plugin = input->event.plugin;
+    ++l_cin_compats[control_id].netplay_count;
+    return input->event.buttons;
+}
+
+static const struct netplay_event* netplay_sent_input(uint8_t control_id)
+{
+    //In rollback mode our own input is used as soon as it has been sent,
+    //the server relays it unchanged, so it can't turn out to be wrong
+    const struct netplay_event* sent = &l_sent_events[control_id][0];
+    if (l_rollback_frames == 0 || l_netplay_control[control_id] == -1 ||
+        !sent->valid || sent->count != l_cin_compats[control_id].netplay_count)
+        return NULL;
+    return sent;
+}
+
+static uint32_t netplay_use_sent_input(uint8_t control_id, const struct netplay_event* sent)
+{
+    //the copy the server echoes back is discarded, the game already ran with this input
+    netplay_feed_input(control_id, sent, 0);
+    Controls[control_id].Plugin = sent->plugin;
+    ++l_cin_compats[control_id].netplay_count;
+    return sent->buttons;
+}
+
+static uint32_t netplay_predict_input(uint8_t control_id)
+{
+    //The input of a remote player hasn't arrived yet, assume they are still holding the same buttons
+    struct netplay_event event;
+    const struct netplay_input* previous = netplay_fed_input(control_id, l_cin_compats[control_id].netplay_count - 1);
+
+    event.count = l_cin_compats[control_id].netplay_count;
+    event.buttons = (previous != NULL) ? previous->event.buttons : 0;
+    event.plugin = (previous != NULL) ? previous->event.plugin : Controls[control_id].Plugin;
+    event.valid = 1;
+    netplay_feed_input(control_id, &event, 1);
+    ++l_stats.input_predictions;
+
+    Controls[control_id].Plugin = event.plugin;
+    ++l_cin_compats[control_id].netplay_count;
+    return event.buttons;
 }
 
 static uint32_t netplay_get_input(uint8_t control_id)
 {
     uint32_t keys;
     netplay_process();
+
+    struct netplay_input* replay = netplay_fed_input(control_id, l_cin_compats[control_id].netplay_count);
+    if (replay != NULL)
+        return netplay_replay_input(control_id, replay);
+
     netplay_request_input(control_id);
 
     //l_buffer_target is set by the server upon registration
     //l_player_lag is how far behind we are from the lead player
     //buffer_size is the local buffer size
-    if (l_player_lag[control_id] > 0 && buffer_size(control_id) > l_buffer_target)
+    if (l_resimulating)
+    {
+        l_canFF = 1;
+        main_core_state_set(M64CORE_SPEED_LIMITER, 0);
+    }
+    else if (l_player_lag[control_id] > 0 && buffer_size(control_id) > l_buffer_target)
     {
         l_canFF = 1;
         main_core_state_set(M64CORE_SPEED_LIMITER, 0);
@@ -359,16 +644,26 @@ static uint32_t netplay_get_input(uint8_t control_id)
         l_canFF = 0;
     }
 
+    if (!check_valid(control_id, l_cin_compats[control_id].netplay_count))
+    {
+        const struct netplay_event* sent = netplay_sent_input(control_id);
+        if (sent != NULL)
+            return netplay_use_sent_input(control_id, sent);
+
+        if (netplay_can_predict())
+            return netplay_predict_input(control_id);
+    }
+
     if (netplay_ensure_valid(control_id))
     {
-        //We grab the event from the linked list, the delete it once it has been used
+        //We grab the event from the ring buffer, then release its slot once it has been used
         //Finally we increment the event counter
-        struct netplay_event* current = l_cin_compats[control_id].event_first;
-        while (current->count != l_cin_compats[control_id].netplay_count)
-            current = current->next;
+        struct netplay_event* current = netplay_event_slot(control_id, l_cin_compats[control_id].netplay_count);
         keys = current->buttons;
         Controls[control_id].Plugin = current->plugin;
-        netplay_delete_event(current, control_id);
+        netplay_feed_input(control_id, current, 0);
+        current->valid = 0;
+        --l_event_count[control_id];
         ++l_cin_compats[control_id].netplay_count;
     }
     else
@@ -381,17 +676,47 @@ static uint32_t netplay_get_input(uint8_t control_id)
     return keys;
 }
 
+static uint32_t netplay_write_event(uint8_t* data, const struct netplay_event* event)
+{
+    SDLNet_Write32(event->count, &data[0]); //event count
+    SDLNet_Write32(event->buttons, &data[4]); //key data
+    data[8] = event->plugin; //plugin
+    return 9;
+}
+
 static void netplay_send_input(uint8_t control_id, uint32_t keys)
 {
-    UDPpacket *packet = SDLNet_AllocPacket(11);
+    struct netplay_event* history = l_sent_events[control_id];
+    struct netplay_event event;
+
+    event.count = l_cin_compats[control_id].netplay_count;
+    event.buttons = keys;
+    event.plugin = l_plugin[control_id];
+    event.valid = 1;
+
+    UDPpacket *packet = l_send_packet;
     packet->data[0] = UDP_SEND_KEY_INFO;
     packet->data[1] = control_id; //player number
-    SDLNet_Write32(l_cin_compats[control_id].netplay_count, &packet->data[2]); // current event count
-    SDLNet_Write32(keys, &packet->data[6]); //key data
-    packet->data[10] = l_plugin[control_id]; //current plugin
-    packet->len = 11;
-    SDLNet_UDP_Send(l_udpSocket, l_udpChannel, packet);
-    SDLNet_FreePacket(packet);
+    uint32_t curr = 2;
+    curr += netplay_write_event(&packet->data[curr], &event);
+
+    //the previous inputs follow in the same datagram, the server ignores events it already has
+    //servers which don't know about them only read the current input
+    uint8_t* previous_count = &packet->data[curr++];
+    *previous_count = 0;
+    for (int i = 0; i < NETPLAY_INPUT_REDUNDANCY; ++i)
+    {
+        if (history[i].valid && history[i].count != event.count)
+        {
+            curr += netplay_write_event(&packet->data[curr], &history[i]);
+            ++*previous_count;
+        }
+    }
+    packet->len = curr;
+    netplay_send_packet(packet);
+
+    memmove(&history[1], &history[0], (NETPLAY_INPUT_REDUNDANCY - 1) * sizeof(history[0]));
+    history[0] = event;
 }
 
 uint8_t netplay_register_player(uint8_t player, uint8_t plugin, uint8_t rawdata, uint32_t reg_id)
@@ -533,6 +858,31 @@ void netplay_sync_settings(uint32_t *count_per_op, uint32_t *count_per_op_denom_
     }
 }
 
+static int netplay_needs_snapshot()
+{
+    //The state only has to be saved if the coming VI may predict an input,
+    //which is when a remote player's input for the events it is expected to read hasn't arrived yet.
+    //If the game reads more events than expected, it waits for the input instead of predicting it
+    netplay_process();
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        if (!Controls[i].Present || l_netplay_control[i] != -1)
+            continue;
+
+        //expect as many reads as during the last VI, but at least one
+        uint32_t reads = (l_vi_reads[i] > 0) ? l_vi_reads[i] : 1;
+        for (uint32_t j = 0; j < reads; ++j)
+        {
+            uint32_t count = l_cin_compats[i].netplay_count + j;
+            const struct netplay_input* input = netplay_fed_input(i, count);
+            if ((input != NULL) ? input->predicted : !check_valid(i, count))
+                return 1;
+        }
+    }
+    return 0;
+}
+
 void netplay_check_sync(struct cp0* cp0)
 {
     //This function is used to check if games have desynced
@@ -543,10 +893,11 @@ void netplay_check_sync(struct cp0* cp0)
 
     const uint32_t* cp0_regs = r4300_cp0_regs(cp0);
 
-    if (l_vi_counter % 600 == 0)
+    //In rollback mode the state is only compared once every input it depends on has been confirmed
+    if (l_vi_counter % 600 == 0 && !netplay_has_predictions())
     {
         uint32_t packet_len = (CP0_REGS_COUNT * 4) + 5;
-        UDPpacket *packet = SDLNet_AllocPacket(packet_len);
+        UDPpacket *packet = l_send_packet;
         packet->data[0] = UDP_SYNC_DATA;
         SDLNet_Write32(l_vi_counter, &packet->data[1]); //current VI count
         for (int i = 0; i < CP0_REGS_COUNT; ++i)
@@ -554,10 +905,116 @@ void netplay_check_sync(struct cp0* cp0)
             SDLNet_Write32(cp0_regs[i], &packet->data[(i * 4) + 5]);
         }
         packet->len = packet_len;
-        SDLNet_UDP_Send(l_udpSocket, l_udpChannel, packet);
-        SDLNet_FreePacket(packet);
+        netplay_send_packet(packet);
     }
     ++l_vi_counter;
+
+    if (l_resimulating && l_vi_counter == l_resim_end)
+    {
+        //we have caught up with where we were before the rollback
+        l_resimulating = 0;
+        l_canFF = 0;
+        main_core_state_set(M64CORE_SPEED_LIMITER, 1);
+    }
+
+    if (l_snapshots == NULL)
+        return;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        l_vi_reads[i] = l_cin_compats[i].netplay_count - l_vi_start_count[i];
+        l_vi_start_count[i] = l_cin_compats[i].netplay_count;
+    }
+
+    //the state at the start of the next VI is saved as soon as it is safe to do so
+    l_snapshot_job = netplay_needs_snapshot();
+}
+
+int netplay_is_resimulating()
+{
+    return l_resimulating;
+}
+
+void netplay_save_snapshot()
+{
+    //This function runs at the end of gen_interrupt, when the emulator state can be saved
+    if (!l_snapshot_job)
+        return;
+    l_snapshot_job = 0;
+
+    struct netplay_snapshot* snapshot = &l_snapshots[l_vi_counter % l_snapshot_count];
+    savestates_save_m64p_buffer(snapshot->data);
+    snapshot->vi = l_vi_counter;
+    for (int i = 0; i < 4; ++i)
+    {
+        snapshot->count[i] = l_cin_compats[i].netplay_count;
+        snapshot->plugin[i] = Controls[i].Plugin;
+    }
+    snapshot->valid = 1;
+}
+
+int netplay_load_snapshot()
+{
+    //This function runs at the start of gen_interrupt, when the emulator state can be replaced
+    //It restores the newest snapshot taken before every mispredicted input, returns 1 if it did
+    if (!l_rollback_pending)
+        return 0;
+
+    struct netplay_snapshot* target = NULL;
+    for (uint32_t i = 0; i < l_snapshot_count; ++i)
+    {
+        struct netplay_snapshot* snapshot = &l_snapshots[i];
+        if (!snapshot->valid)
+            continue;
+
+        int usable = 1;
+        for (int j = 0; j < 4; ++j)
+        {
+            if ((l_rollback_pending & (1 << j)) && (int32_t)(snapshot->count[j] - l_rollback_count[j]) > 0)
+                usable = 0;
+        }
+
+        if (usable && (target == NULL || (int32_t)(snapshot->vi - target->vi) > 0))
+            target = snapshot;
+    }
+
+    l_rollback_pending = 0;
+    if (target == NULL || !savestates_load_m64p_buffer(target->data))
+    {
+        DebugMessage(M64MSG_ERROR, "Netplay: could not roll back to VI %u", l_vi_counter);
+        return 0;
+    }
+
+    //snapshots taken after the target were based on wrong inputs
+    for (uint32_t i = 0; i < l_snapshot_count; ++i)
+    {
+        if ((int32_t)(l_snapshots[i].vi - target->vi) > 0)
+            l_snapshots[i].valid = 0;
+    }
+
+    if (!l_resimulating)
+        l_resim_end = l_vi_counter;
+    l_resimulating = (target->vi != l_resim_end);
+
+    ++l_stats.rollbacks;
+    l_stats.resimulated_vis += l_vi_counter - target->vi;
+
+    l_vi_counter = target->vi;
+    for (int i = 0; i < 4; ++i)
+    {
+        l_cin_compats[i].netplay_count = target->count[i];
+        l_vi_start_count[i] = target->count[i];
+        Controls[i].Plugin = target->plugin[i];
+    }
+    l_snapshot_job = 0;
+
+    if (l_resimulating)
+    {
+        l_canFF = 1;
+        main_core_state_set(M64CORE_SPEED_LIMITER, 0);
+    }
+
+    return 1;
 }
 
 void netplay_read_registration(struct controller_input_compat* cin_compats)
@@ -568,6 +1025,14 @@ void netplay_read_registration(struct controller_input_compat* cin_compats)
         return;
 
     l_cin_compats = cin_compats;
+    netplay_clear_events();
+
+    netplay_free_snapshots();
+    if (l_rollback_frames > 0 && !netplay_alloc_snapshots())
+    {
+        DebugMessage(M64MSG_WARNING, "Netplay: could not allocate rollback snapshots, using delay-based netplay");
+        l_rollback_frames = 0;
+    }
 
     uint32_t reg_id;
     char output_data = TCP_GET_REGISTRATION;
@@ -614,7 +1079,9 @@ static void netplay_send_raw_input(struct pif* pif)
     {
         if (l_netplay_control[i] != -1)
         {
-            if (pif->channels[i].tx && pif->channels[i].tx_buf[0] == JCMD_CONTROLLER_READ)
+            //inputs replayed after a rollback have already been sent
+            if (pif->channels[i].tx && pif->channels[i].tx_buf[0] == JCMD_CONTROLLER_READ &&
+                netplay_fed_input(i, l_cin_compats[i].netplay_count) == NULL)
                 netplay_send_input(i, *(uint32_t*)pif->channels[i].rx_buf);
         }
     }
@@ -701,3 +1168,28 @@ m64p_error netplay_receive_config(char* data, int size)
     else
         return M64ERR_INVALID_STATE;
 }
+
+m64p_error netplay_get_stats(m64p_netplay_stats* stats)
+{
+    if (!netplay_is_init())
+        return M64ERR_NOT_INIT;
+
+    *stats = l_stats;
+    return M64ERR_SUCCESS;
+}
+
+m64p_error netplay_set_rollback(int frames)
+{
+    //Rollback has to be enabled before the game starts, 0 disables it
+    if (!netplay_is_init())
+        return M64ERR_NOT_INIT;
+
+    if (frames < 0 || frames > NETPLAY_MAX_ROLLBACK_FRAMES)
+        return M64ERR_INPUT_INVALID;
+
+    if (l_cin_compats != NULL)
+        return M64ERR_INVALID_STATE;
+
+    l_rollback_frames = frames;
+    return M64ERR_SUCCESS;
+}
@@ -28,11 +28,19 @@
 
 #define NETPLAY_CORE_VERSION 1
 
+/* size of the per-player input ring buffer, must be a power of two
+ * and larger than any buffer target the server can hand out */
+#define NETPLAY_EVENT_BUFFER_SIZE 256
+
+/* how many VIs rollback netplay may run ahead of the confirmed inputs,
+ * every VI costs one in-memory savestate */
+#define NETPLAY_MAX_ROLLBACK_FRAMES 7
+
 struct netplay_event {
     uint32_t buttons;
     uint8_t plugin;
+    uint8_t valid;
     uint32_t count;
-    struct netplay_event* next;
 };
 
 struct controller_input_compat;
@@ -54,6 +62,11 @@ void netplay_read_registration(struct controller_input_compat* cin_compats);
 void netplay_update_input(struct pif* pif);
 m64p_error netplay_send_config(char* data, int size);
 m64p_error netplay_receive_config(char* data, int size);
+m64p_error netplay_get_stats(m64p_netplay_stats* stats);
+m64p_error netplay_set_rollback(int frames);
+int netplay_is_resimulating();
+void netplay_save_snapshot();
+int netplay_load_snapshot();
 
 #else
 
@@ -131,6 +144,30 @@ static osal_inline m64p_error netplay_receive_config(char* data, int size)
     return M64ERR_INCOMPATIBLE;
 }
 
+static osal_inline m64p_error netplay_get_stats(m64p_netplay_stats* stats)
+{
+    return M64ERR_INCOMPATIBLE;
+}
+
+static osal_inline m64p_error netplay_set_rollback(int frames)
+{
+    return M64ERR_INCOMPATIBLE;
+}
+
+static osal_inline int netplay_is_resimulating()
+{
+    return 0;
+}
+
+static osal_inline void netplay_save_snapshot()
+{
+}
+
+static osal_inline int netplay_load_snapshot()
+{
+    return 0;
+}
+
 #endif
 
 #endif
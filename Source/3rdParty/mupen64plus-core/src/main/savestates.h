@@ -40,6 +40,9 @@ typedef enum _savestates_type
     savestates_type_pj64_unc
 } savestates_type;
 
+/* size of an uncompressed m64p savestate, header included */
+#define M64P_SAVESTATE_SIZE (16788288 + 1024 + 4 + 4096)
+
 savestates_job savestates_get_job(void);
 void savestates_set_job(savestates_job j, savestates_type t, const char *fn);
 void savestates_init(void);
@@ -48,6 +51,10 @@ void savestates_deinit(void);
 int savestates_load(void);
 int savestates_save(void);
 
+/* in-memory m64p savestates, the buffer must hold M64P_SAVESTATE_SIZE bytes */
+void savestates_save_m64p_buffer(void *buffer);
+int savestates_load_m64p_buffer(const void *buffer);
+
 void savestates_select_slot(unsigned int s);
 unsigned int savestates_get_slot(void);
 void savestates_set_autoinc_slot(int b);
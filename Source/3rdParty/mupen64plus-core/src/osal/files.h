@@ -67,5 +67,10 @@ extern const char * osal_get_user_cachepath(void);
 extern FILE * osal_file_open (const char *filename, const char *mode);
 extern gzFile osal_gzopen(const char *filename, const char *mode);
 
+/* Atomically replace newpath with oldpath.
+ * Returns zero on success, nonzero on failure.
+ */
+extern int osal_file_replace(const char *oldpath, const char *newpath);
+
 #endif /* OSAL_FILES_H */
 
@@ -241,3 +241,8 @@ gzFile osal_gzopen(const char *filename, const char *mode)
 {
     return gzopen(filename, mode);
 }
+
+int osal_file_replace(const char *oldpath, const char *newpath)
+{
+    return rename(oldpath, newpath);
+}
@@ -220,3 +220,12 @@ gzFile osal_gzopen(const char *filename, const char *mode)
     MultiByteToWideChar(CP_UTF8, 0, filename, -1, wstr_filename, PATH_MAX);
     return gzopen_w(wstr_filename, mode);
 }
+
+int osal_file_replace(const char *oldpath, const char *newpath)
+{
+    wchar_t wstr_oldpath[PATH_MAX];
+    wchar_t wstr_newpath[PATH_MAX];
+    MultiByteToWideChar(CP_UTF8, 0, oldpath, -1, wstr_oldpath, PATH_MAX);
+    MultiByteToWideChar(CP_UTF8, 0, newpath, -1, wstr_newpath, PATH_MAX);
+    return MoveFileExW(wstr_oldpath, wstr_newpath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+}
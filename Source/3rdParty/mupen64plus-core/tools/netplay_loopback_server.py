@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+#
+# Minimal netplay server for testing the mupen64plus netplay client
+#
+# It implements the subset of the netplay server protocol the core uses:
+# player registration, settings and save file sync over TCP, and it stores
+# the UDP_SEND_KEY_INFO events of every player (including the previous
+# events packed after the first one) and answers UDP_REQUEST_KEY_INFO with
+# the events it has, which echoes every player's input back to all clients.
+#
+# With --bot-player it also plays one player itself. Its input changes every
+# few events and is held back until the lowest registered player has sent the
+# event --bot-lag counts later, like a remote player whose input arrives late.
+# Clients running ahead in rollback mode then mispredict its input and have to
+# roll back. A negative --bot-lag makes the bot's input arrive early instead.
+#
+# usage: netplay_loopback_server.py [--port 45000] [--buffer-target 2]
+#                                   [--bot-player 2] [--bot-lag 3]
+
+import argparse
+import socket
+import socketserver
+import struct
+import threading
+import time
+
+UDP_SEND_KEY_INFO = 0
+UDP_RECEIVE_KEY_INFO = 1
+UDP_REQUEST_KEY_INFO = 2
+UDP_SYNC_DATA = 4
+
+TCP_SEND_SAVE = 1
+TCP_RECEIVE_SAVE = 2
+TCP_SEND_SETTINGS = 3
+TCP_RECEIVE_SETTINGS = 4
+TCP_REGISTER_PLAYER = 5
+TCP_GET_REGISTRATION = 6
+TCP_DISCONNECT_NOTICE = 7
+
+SETTINGS_SIZE = 24
+PLUGIN_NONE = 1
+
+# events per UDP_RECEIVE_KEY_INFO, they have to fit in the 512 byte packet
+MAX_EVENTS_PER_PACKET = 32
+
+# a held back bot event is released anyway once it has been requested
+# for this long, so a client that can't run ahead doesn't wait forever
+BOT_RELEASE_TIMEOUT = 0.2
+
+
+def bot_keys(count):
+    # changes every 5 events, so predicting "same as before" is wrong now and then
+    return ((count // 5) * 0x9E3779B1) & 0xFFFF
+
+
+class Server:
+    def __init__(self, args):
+        self.lock = threading.Lock()
+        self.condition = threading.Condition(self.lock)
+        self.buffer_target = args.buffer_target
+        self.bot_player = args.bot_player - 1 if args.bot_player else None
+        self.bot_lag = args.bot_lag
+        self.registrations = [None] * 4
+        self.events = [dict() for _ in range(4)]
+        self.settings = None
+        self.saves = {}
+        self.bot_requested = {}
+
+        if self.bot_player is not None:
+            self.registrations[self.bot_player] = (0xB07, PLUGIN_NONE, 0)
+
+    # TCP
+
+    def register(self, player, plugin, rawdata, reg_id):
+        with self.lock:
+            if player >= 4 or self.registrations[player] is not None:
+                return 0
+            self.registrations[player] = (reg_id, plugin, rawdata)
+            return 1
+
+    def registration_data(self):
+        with self.lock:
+            data = b""
+            for registration in self.registrations:
+                if registration is None:
+                    data += struct.pack(">IBB", 0, 0, 0)
+                else:
+                    data += struct.pack(">IBB", *registration)
+            return data
+
+    def set_settings(self, data):
+        with self.condition:
+            self.settings = data
+            self.condition.notify_all()
+
+    def wait_settings(self):
+        with self.condition:
+            self.condition.wait_for(lambda: self.settings is not None)
+            return self.settings
+
+    def set_save(self, extension, data):
+        with self.condition:
+            self.saves[extension] = data
+            self.condition.notify_all()
+
+    def wait_save(self, extension):
+        with self.condition:
+            self.condition.wait_for(lambda: extension in self.saves)
+            return self.saves[extension]
+
+    # UDP
+
+    def store_event(self, player, count, keys, plugin):
+        if player < 4 and count not in self.events[player]:
+            self.events[player][count] = (keys, plugin)
+
+    def lead_count(self):
+        # the newest event every human player has sent
+        counts = []
+        for player in range(4):
+            if player != self.bot_player and self.registrations[player] is not None:
+                counts.append(max(self.events[player].keys(), default=-1))
+        return min(counts, default=-1)
+
+    def release_bot_events(self, requested):
+        if self.bot_player is None:
+            return
+
+        now = time.monotonic()
+        if requested is not None and requested not in self.bot_requested:
+            self.bot_requested[requested] = now
+
+        lead = self.lead_count()
+        events = self.events[self.bot_player]
+        count = max(events.keys(), default=-1) + 1
+        while True:
+            late = count in self.bot_requested and now - self.bot_requested[count] > BOT_RELEASE_TIMEOUT
+            if count >= self.bot_lag and lead < count + self.bot_lag and not late:
+                break
+            events[count] = (bot_keys(count), PLUGIN_NONE)
+            count += 1
+
+    def handle_udp(self, sock, data, address):
+        with self.lock:
+            if data[0] == UDP_SEND_KEY_INFO and len(data) >= 11:
+                player = data[1]
+                count, keys, plugin = struct.unpack(">IIB", data[2:11])
+                self.store_event(player, count, keys, plugin)
+
+                # previous events packed after the current one
+                if len(data) >= 12:
+                    offset = 12
+                    for _ in range(data[11]):
+                        if offset + 9 > len(data):
+                            break
+                        count, keys, plugin = struct.unpack(">IIB", data[offset:offset + 9])
+                        self.store_event(player, count, keys, plugin)
+                        offset += 9
+
+                self.release_bot_events(None)
+            elif data[0] == UDP_REQUEST_KEY_INFO and len(data) >= 12:
+                player = data[1]
+                count = struct.unpack(">I", data[6:10])[0]
+                if player >= 4:
+                    return
+
+                if player == self.bot_player:
+                    self.release_bot_events(count)
+
+                events = []
+                while len(events) < MAX_EVENTS_PER_PACKET and count in self.events[player]:
+                    keys, plugin = self.events[player][count]
+                    events.append(struct.pack(">IIB", count, keys, plugin))
+                    count += 1
+
+                packet = struct.pack(">BBBBB", UDP_RECEIVE_KEY_INFO, player, 0, 0, len(events)) + b"".join(events)
+                sock.sendto(packet, address)
+            elif data[0] == UDP_SYNC_DATA:
+                # a single client has nothing to compare its state against
+                pass
+
+
+def recv_exactly(sock, size):
+    data = b""
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError
+        data += chunk
+    return data
+
+
+def recv_string(sock):
+    data = b""
+    while True:
+        byte = recv_exactly(sock, 1)
+        if byte == b"\0":
+            return data.decode()
+        data += byte
+
+
+class TcpHandler(socketserver.BaseRequestHandler):
+    def handle(self):
+        server = self.server.netplay
+        sock = self.request
+        try:
+            while True:
+                request = recv_exactly(sock, 1)[0]
+                if request == TCP_REGISTER_PLAYER:
+                    player, plugin, rawdata, reg_id = struct.unpack(">BBBI", recv_exactly(sock, 7))
+                    accepted = server.register(player, plugin, rawdata, reg_id)
+                    sock.sendall(bytes([accepted, server.buffer_target]))
+                elif request == TCP_GET_REGISTRATION:
+                    sock.sendall(server.registration_data())
+                elif request == TCP_SEND_SETTINGS:
+                    server.set_settings(recv_exactly(sock, SETTINGS_SIZE))
+                elif request == TCP_RECEIVE_SETTINGS:
+                    sock.sendall(server.wait_settings())
+                elif request == TCP_SEND_SAVE:
+                    extension = recv_string(sock)
+                    size = struct.unpack(">I", recv_exactly(sock, 4))[0]
+                    server.set_save(extension, recv_exactly(sock, size))
+                elif request == TCP_RECEIVE_SAVE:
+                    sock.sendall(server.wait_save(recv_string(sock)))
+                elif request == TCP_DISCONNECT_NOTICE:
+                    return
+        except ConnectionError:
+            return
+
+
+class TcpServer(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="minimal netplay server for testing")
+    parser.add_argument("--port", type=int, default=45000)
+    parser.add_argument("--buffer-target", type=int, default=2)
+    parser.add_argument("--bot-player", type=int, choices=[1, 2, 3, 4])
+    parser.add_argument("--bot-lag", type=int, default=3)
+    args = parser.parse_args()
+
+    server = Server(args)
+
+    tcp = TcpServer(("", args.port), TcpHandler)
+    tcp.netplay = server
+    threading.Thread(target=tcp.serve_forever, daemon=True).start()
+
+    udp = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    udp.bind(("", args.port))
+    print("netplay loopback server listening on port %d" % args.port, flush=True)
+
+    while True:
+        data, address = udp.recvfrom(512)
+        if data:
+            server.handle_udp(udp, data, address)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,242 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - netplay_rollback_test.c                                 *
+ *   Mupen64Plus homepage: https://mupen64plus.org/                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Runs the rollback netplay client (src/main/netplay.c) against the loopback
+ * server in tools/netplay_loopback_server.py, with a toy game in place of the
+ * emulator. The game hashes the inputs of player 1 (local) and player 2 (the
+ * server's bot, whose input arrives late) every VI, and its state is what the
+ * netplay snapshots save and restore.
+ *
+ * The test passes when the client mispredicted and rolled back, and the game
+ * state of every VI whose inputs have been confirmed equals the state of a run
+ * with the real inputs, i.e. the rollbacks converged.
+ *
+ * To build and run it, go to the root of the mupen64plus-core source and type:
+ *
+ * gcc -std=gnu99 -O2 -DM64P_NETPLAY -Isrc -Isrc/api -Itools/netplay_rollback_test/sdl_shim \
+ *     -o netplay_rollback_test tools/netplay_rollback_test/netplay_rollback_test.c \
+ *     tools/netplay_rollback_test/sdl_shim/sdl_shim.c src/main/netplay.c -lpthread
+ * python3 tools/netplay_loopback_server.py --port 45000 --bot-player 2 --bot-lag 3 &
+ * ./netplay_rollback_test 45000
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "api/callbacks.h"
+#include "api/m64p_types.h"
+#include "backends/api/joybus.h"
+#include "backends/plugins_compat/plugins_compat.h"
+#include "device/pif/pif.h"
+#include "device/r4300/cp0.h"
+#include "main/main.h"
+#include "main/netplay.h"
+#include "main/savestates.h"
+#include "main/util.h"
+#include "plugin/plugin.h"
+
+/* VIs to run, and the VIs at the end whose inputs
+ * may not have been confirmed when the test stops */
+#define TEST_VIS 600
+#define TEST_UNCONFIRMED_VIS 32
+
+#define ROLLBACK_FRAMES 7
+
+/* matches bot_keys() in the loopback server */
+static uint32_t bot_keys(uint32_t count)
+{
+    return ((count / 5) * 0x9E3779B1u) & 0xFFFF;
+}
+
+static uint32_t local_keys(uint32_t count)
+{
+    return (count * 0x01000193u) >> 16;
+}
+
+static uint64_t mix(uint64_t hash, uint32_t p1, uint32_t p2)
+{
+    hash ^= ((uint64_t)p1 << 32) | p2;
+    hash *= 0x100000001b3ull;
+    return hash ^ (hash >> 29);
+}
+
+/* the toy game, this is all a snapshot has to hold */
+struct game_state {
+    uint32_t vi;
+    uint64_t hash;
+};
+
+static struct game_state l_game;
+static uint64_t l_hashes[TEST_VIS + 1];
+static uint32_t l_snapshots_saved;
+
+/* the parts of the core netplay.c links against */
+
+CONTROL Controls[NUM_CONTROLLER];
+
+void DebugMessage(int level, const char *message, ...)
+{
+    va_list args;
+    va_start(args, message);
+    printf("netplay_rollback_test: level %d: ", level);
+    vprintf(message, args);
+    printf("\n");
+    va_end(args);
+}
+
+m64p_error main_core_state_set(m64p_core_param param, int val)
+{
+    (void)param;
+    (void)val;
+    return M64ERR_SUCCESS;
+}
+
+uint32_t* r4300_cp0_regs(struct cp0* cp0)
+{
+    static uint32_t regs[CP0_REGS_COUNT];
+    (void)cp0;
+    return regs;
+}
+
+file_status_t read_from_file(const char *filename, void *data, size_t size)
+{
+    (void)filename;
+    (void)data;
+    (void)size;
+    return file_open_error;
+}
+
+void savestates_save_m64p_buffer(void *buffer)
+{
+    memcpy(buffer, &l_game, sizeof(l_game));
+    ++l_snapshots_saved;
+}
+
+int savestates_load_m64p_buffer(const void *buffer)
+{
+    memcpy(&l_game, buffer, sizeof(l_game));
+    return 1;
+}
+
+/* one VI of the toy game, it reads the controllers once */
+static void run_game_vi(struct pif* pif)
+{
+    *(uint32_t*)pif->channels[0].rx_buf = local_keys(l_game.vi);
+    netplay_update_input(pif);
+
+    uint32_t p1 = *(uint32_t*)pif->channels[0].rx_buf;
+    uint32_t p2 = *(uint32_t*)pif->channels[1].rx_buf;
+    l_game.hash = mix(l_game.hash, p1, p2);
+    ++l_game.vi;
+
+    if (l_game.vi <= TEST_VIS)
+        l_hashes[l_game.vi] = l_game.hash;
+}
+
+int main(int argc, char *argv[])
+{
+    int port = (argc > 1) ? atoi(argv[1]) : 45000;
+
+    static uint8_t tx[PIF_CHANNELS_COUNT], rx[PIF_CHANNELS_COUNT];
+    static uint8_t tx_buf[PIF_CHANNELS_COUNT][8], rx_buf[PIF_CHANNELS_COUNT][8];
+    static struct controller_input_compat cin_compats[4];
+    struct pif pif;
+    memset(&pif, 0, sizeof(pif));
+    for (int i = 0; i < 4; ++i)
+    {
+        tx[i] = 1;
+        tx_buf[i][0] = JCMD_CONTROLLER_READ;
+        pif.channels[i].tx = &tx[i];
+        pif.channels[i].tx_buf = tx_buf[i];
+        pif.channels[i].rx = &rx[i];
+        pif.channels[i].rx_buf = rx_buf[i];
+    }
+
+    if (netplay_start("127.0.0.1", port) != M64ERR_SUCCESS)
+        return 1;
+
+    if (!netplay_register_player(0, PLUGIN_NONE, 0, 0x1234))
+    {
+        printf("netplay_rollback_test: player 1 could not be registered\n");
+        return 1;
+    }
+    netplay_set_controller(0);
+    netplay_set_rollback(ROLLBACK_FRAMES);
+    netplay_read_registration(cin_compats);
+
+    if (!Controls[1].Present)
+    {
+        printf("netplay_rollback_test: the server has to play player 2 (--bot-player 2)\n");
+        return 1;
+    }
+
+    /* same order as the VI interrupt: the state is rolled back instead of
+     * finishing the VI, otherwise the VI is counted and the state saved */
+    struct cp0 *cp0 = NULL;
+    while (l_game.vi < TEST_VIS)
+    {
+        run_game_vi(&pif);
+
+        if (netplay_load_snapshot())
+            continue;
+
+        netplay_check_sync(cp0);
+        netplay_save_snapshot();
+    }
+
+    m64p_netplay_stats stats;
+    netplay_get_stats(&stats);
+    netplay_stop();
+
+    printf("VIs: %u, snapshots saved: %u\n", TEST_VIS, l_snapshots_saved);
+    printf("predictions: %u, mispredictions: %u, rollbacks: %u, resimulated VIs: %u\n",
+        stats.input_predictions, stats.mispredictions, stats.rollbacks, stats.resimulated_vis);
+    printf("stalls: %u, events missed: %u\n", stats.input_stalls, stats.events_missed);
+
+    /* replay the real inputs */
+    uint64_t hash = 0;
+    int diverged = 0;
+    for (uint32_t vi = 0; vi < TEST_VIS - TEST_UNCONFIRMED_VIS; ++vi)
+    {
+        hash = mix(hash, local_keys(vi), bot_keys(vi));
+        if (hash != l_hashes[vi + 1])
+        {
+            printf("state diverged after VI %u\n", vi);
+            diverged = 1;
+            break;
+        }
+    }
+
+    if (stats.rollbacks == 0)
+    {
+        printf("FAIL: no rollback happened\n");
+        return 1;
+    }
+    if (diverged)
+    {
+        printf("FAIL: rollbacks did not converge\n");
+        return 1;
+    }
+
+    printf("PASS: %u rollbacks converged to the confirmed inputs\n", stats.rollbacks);
+    return 0;
+}
@@ -0,0 +1,17 @@
+/* Minimal stand-in for the parts of SDL2 netplay.c uses,
+ * implemented on top of pthreads in sdl_shim.c */
+
+#ifndef SDL_SHIM_H
+#define SDL_SHIM_H
+
+#include <stdint.h>
+
+typedef struct SDL_Thread SDL_Thread;
+typedef int (*SDL_ThreadFunction)(void *data);
+
+SDL_Thread* SDL_CreateThread(SDL_ThreadFunction fn, const char *name, void *data);
+void SDL_WaitThread(SDL_Thread *thread, int *status);
+uint32_t SDL_GetTicks(void);
+void SDL_Delay(uint32_t ms);
+
+#endif
@@ -0,0 +1,62 @@
+/* Minimal stand-in for the parts of SDL2_net netplay.c uses,
+ * implemented on top of BSD sockets in sdl_shim.c */
+
+#ifndef SDL_NET_SHIM_H
+#define SDL_NET_SHIM_H
+
+#include <stdint.h>
+
+#include "SDL.h"
+
+typedef struct {
+    uint32_t host; /* network byte order */
+    uint16_t port; /* network byte order */
+} IPaddress;
+
+typedef struct _UDPsocket *UDPsocket;
+typedef struct _TCPsocket *TCPsocket;
+
+typedef struct {
+    int channel;
+    uint8_t *data;
+    int len;
+    int maxlen;
+    int status;
+    IPaddress address;
+} UDPpacket;
+
+int SDLNet_Init(void);
+void SDLNet_Quit(void);
+int SDLNet_ResolveHost(IPaddress *address, const char *host, uint16_t port);
+
+UDPpacket* SDLNet_AllocPacket(int size);
+void SDLNet_FreePacket(UDPpacket *packet);
+
+UDPsocket SDLNet_UDP_Open(uint16_t port);
+void SDLNet_UDP_Close(UDPsocket sock);
+int SDLNet_UDP_Bind(UDPsocket sock, int channel, const IPaddress *address);
+void SDLNet_UDP_Unbind(UDPsocket sock, int channel);
+int SDLNet_UDP_Send(UDPsocket sock, int channel, UDPpacket *packet);
+int SDLNet_UDP_Recv(UDPsocket sock, UDPpacket *packet);
+
+TCPsocket SDLNet_TCP_Open(IPaddress *ip);
+void SDLNet_TCP_Close(TCPsocket sock);
+int SDLNet_TCP_Send(TCPsocket sock, const void *data, int len);
+int SDLNet_TCP_Recv(TCPsocket sock, void *data, int maxlen);
+
+static inline void SDLNet_Write32(uint32_t value, void *area)
+{
+    uint8_t *p = (uint8_t*)area;
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+static inline uint32_t SDLNet_Read32(const void *area)
+{
+    const uint8_t *p = (const uint8_t*)area;
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+#endif
@@ -0,0 +1,242 @@
+/* SDL2 and SDL2_net stand-ins for the netplay rollback test,
+ * so it only needs a C compiler and the POSIX socket API */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SDL_net.h"
+
+/* netplay.c reads the socket descriptor from the
+ * second member, like it does with SDL2_net */
+struct _UDPsocket {
+    int ready;
+    int channel;
+    struct sockaddr_in peer;
+};
+
+struct _TCPsocket {
+    int fd;
+};
+
+struct SDL_Thread {
+    pthread_t thread;
+    SDL_ThreadFunction fn;
+    void *data;
+    int status;
+};
+
+static void* thread_main(void *opaque)
+{
+    SDL_Thread *thread = opaque;
+    thread->status = thread->fn(thread->data);
+    return NULL;
+}
+
+SDL_Thread* SDL_CreateThread(SDL_ThreadFunction fn, const char *name, void *data)
+{
+    (void)name;
+    SDL_Thread *thread = calloc(1, sizeof(*thread));
+    if (thread == NULL)
+        return NULL;
+
+    thread->fn = fn;
+    thread->data = data;
+    if (pthread_create(&thread->thread, NULL, thread_main, thread) != 0)
+    {
+        free(thread);
+        return NULL;
+    }
+    return thread;
+}
+
+void SDL_WaitThread(SDL_Thread *thread, int *status)
+{
+    if (thread == NULL)
+        return;
+
+    pthread_join(thread->thread, NULL);
+    if (status != NULL)
+        *status = thread->status;
+    free(thread);
+}
+
+uint32_t SDL_GetTicks(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+void SDL_Delay(uint32_t ms)
+{
+    struct timespec delay = { ms / 1000, (ms % 1000) * 1000000 };
+    nanosleep(&delay, NULL);
+}
+
+int SDLNet_Init(void)
+{
+    return 0;
+}
+
+void SDLNet_Quit(void)
+{
+}
+
+int SDLNet_ResolveHost(IPaddress *address, const char *host, uint16_t port)
+{
+    struct addrinfo hints, *result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+
+    if (getaddrinfo(host, NULL, &hints, &result) != 0)
+        return -1;
+
+    address->host = ((struct sockaddr_in*)result->ai_addr)->sin_addr.s_addr;
+    address->port = htons(port);
+    freeaddrinfo(result);
+    return 0;
+}
+
+UDPpacket* SDLNet_AllocPacket(int size)
+{
+    UDPpacket *packet = calloc(1, sizeof(*packet));
+    if (packet == NULL)
+        return NULL;
+
+    packet->data = calloc(1, size);
+    if (packet->data == NULL)
+    {
+        free(packet);
+        return NULL;
+    }
+    packet->maxlen = size;
+    return packet;
+}
+
+void SDLNet_FreePacket(UDPpacket *packet)
+{
+    if (packet == NULL)
+        return;
+
+    free(packet->data);
+    free(packet);
+}
+
+UDPsocket SDLNet_UDP_Open(uint16_t port)
+{
+    UDPsocket sock = calloc(1, sizeof(*sock));
+    if (sock == NULL)
+        return NULL;
+
+    sock->channel = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock->channel < 0)
+    {
+        free(sock);
+        return NULL;
+    }
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    if (bind(sock->channel, (struct sockaddr*)&local, sizeof(local)) < 0)
+    {
+        close(sock->channel);
+        free(sock);
+        return NULL;
+    }
+    return sock;
+}
+
+void SDLNet_UDP_Close(UDPsocket sock)
+{
+    if (sock == NULL)
+        return;
+
+    close(sock->channel);
+    free(sock);
+}
+
+int SDLNet_UDP_Bind(UDPsocket sock, int channel, const IPaddress *address)
+{
+    (void)channel;
+    memset(&sock->peer, 0, sizeof(sock->peer));
+    sock->peer.sin_family = AF_INET;
+    sock->peer.sin_addr.s_addr = address->host;
+    sock->peer.sin_port = address->port;
+    return 0;
+}
+
+void SDLNet_UDP_Unbind(UDPsocket sock, int channel)
+{
+    (void)sock;
+    (void)channel;
+}
+
+int SDLNet_UDP_Send(UDPsocket sock, int channel, UDPpacket *packet)
+{
+    (void)channel;
+    ssize_t sent = sendto(sock->channel, packet->data, packet->len, 0, (struct sockaddr*)&sock->peer, sizeof(sock->peer));
+    return sent == packet->len ? 1 : 0;
+}
+
+int SDLNet_UDP_Recv(UDPsocket sock, UDPpacket *packet)
+{
+    ssize_t len = recv(sock->channel, packet->data, packet->maxlen, MSG_DONTWAIT);
+    if (len < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+    packet->len = (int)len;
+    packet->channel = 0;
+    return 1;
+}
+
+TCPsocket SDLNet_TCP_Open(IPaddress *ip)
+{
+    TCPsocket sock = calloc(1, sizeof(*sock));
+    if (sock == NULL)
+        return NULL;
+
+    sock->fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in peer;
+    memset(&peer, 0, sizeof(peer));
+    peer.sin_family = AF_INET;
+    peer.sin_addr.s_addr = ip->host;
+    peer.sin_port = ip->port;
+    if (sock->fd < 0 || connect(sock->fd, (struct sockaddr*)&peer, sizeof(peer)) < 0)
+    {
+        if (sock->fd >= 0)
+            close(sock->fd);
+        free(sock);
+        return NULL;
+    }
+    return sock;
+}
+
+void SDLNet_TCP_Close(TCPsocket sock)
+{
+    if (sock == NULL)
+        return;
+
+    close(sock->fd);
+    free(sock);
+}
+
+int SDLNet_TCP_Send(TCPsocket sock, const void *data, int len)
+{
+    return (int)send(sock->fd, data, len, 0);
+}
+
+int SDLNet_TCP_Recv(TCPsocket sock, void *data, int maxlen)
+{
+    return (int)recv(sock->fd, data, maxlen, 0);
+}
@@ -30,6 +30,7 @@
 
 #include "module.h"
 #include "su.h"
+#include "vu/avx2.h"
 
 #include "m64p_common.h"
 
@@ -363,6 +364,48 @@ EXPORT void CALL DllConfig(p_void hParent)
 
 #endif
 
+#ifdef SP_TASK_BENCHMARK
+/*
+ * Reports how many millions of RSP instructions per second the interpreter
+ * runs for each type of task, once every 1024 tasks of that type.
+ */
+static void benchmark_task(OSTask_type task_type, clock_t ticks, u64 count)
+{
+    static const char* names[] = { "graphics", "audio", "other" };
+    static clock_t total_ticks[3];
+    static u64 total_count[3];
+    static unsigned int tasks[3];
+    double seconds;
+    int kind;
+
+    if (task_type == M_GFXTASK)
+        kind = 0;
+    else if (task_type == M_AUDTASK)
+        kind = 1;
+    else
+        kind = 2;
+
+    total_ticks[kind] += ticks;
+    total_count[kind] += count;
+    if (++tasks[kind] < 1024)
+        return;
+
+    seconds = (double)total_ticks[kind] / CLOCKS_PER_SEC;
+    if (seconds > 0) {
+#if defined(M64P_PLUGIN_API)
+        DebugMessage(M64MSG_INFO, "%s tasks:  %.2f MIPS",
+            names[kind], total_count[kind] / seconds / 1e6);
+#else
+        printf("%s tasks:  %.2f MIPS\n",
+            names[kind], total_count[kind] / seconds / 1e6);
+#endif
+    }
+    total_ticks[kind] = 0;
+    total_count[kind] = 0;
+    tasks[kind] = 0;
+}
+#endif
+
 EXPORT unsigned int CALL DoRspCycles(unsigned int cycles)
 {
     static char task_debug[] = "unknown task type:  0x????????";
@@ -467,7 +510,17 @@ EXPORT unsigned int CALL DoRspCycles(unsigned int cycles)
     for (i = 0; i < NUMBER_OF_SCALAR_REGISTERS; i++)
         MFC0_count[i] = 0;
 #endif
+#ifdef SP_TASK_BENCHMARK
+    {
+        const u64 count = SP_instructions_run;
+        const clock_t start = clock();
+
+        run_task();
+        benchmark_task(task_type, clock() - start, SP_instructions_run - count);
+    }
+#else
     run_task();
+#endif
 
 /*
  * An optional EMMS when compiling with Intel SIMD or MMX support.
@@ -527,6 +580,12 @@ EXPORT void CALL InitiateRSP(RSP_INFO Rsp_Info, pu32 CycleCount)
         *CycleCount = 0;
     update_conf(CFG_FILE);
 
+    if (VU_select_AVX2()) {
+#if defined(M64P_PLUGIN_API)
+        DebugMessage(M64MSG_INFO, "Using AVX2 vector unit operations.");
+#endif
+    }
+
     RSP_INFO_NAME = Rsp_Info;
     DRAM = GET_RSP_INFO(RDRAM);
     if (Rsp_Info.DMEM == Rsp_Info.IMEM) /* usually dummy RSP data for testing */
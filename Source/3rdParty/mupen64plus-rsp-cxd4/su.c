@@ -1790,39 +1790,6 @@ PROFILE_MODE int REGIMM(u32 inst, u32 PC)
     return 1;
 }
 
-PROFILE_MODE void MWC2_load(u32 inst)
-{
-    s16 offset;
-    const unsigned int base    = (inst >> 21) % (1 << 5);
-    const unsigned int vt      = (inst >> 16) % (1 << 5);
-    const unsigned int element = (inst >>  7) % (1 << 4);
-
-#if defined(ARCH_MIN_SSE2) && !defined(SSE2NEON)
-    offset   = (s16)inst;
-    offset <<= 5 + 4; /* safe on x86, skips 5-bit rd, 4-bit element */
-    offset >>= 5 + 4;
-#else
-    offset = (inst & 64) ? -(s16)(~inst%64 + 1) : (s16)(inst % 64);
-#endif
-    LWC2[IW_RD(inst)](vt, element, offset, base);
-}
-PROFILE_MODE void MWC2_store(u32 inst)
-{
-    s16 offset;
-    const unsigned int base    = (inst >> 21) % (1 << 5);
-    const unsigned int vt      = (inst >> 16) % (1 << 5);
-    const unsigned int element = (inst >>  7) % (1 << 4);
-
-#if defined(ARCH_MIN_SSE2) && !defined(SSE2NEON)
-    offset = (s16)inst;
-    offset <<= 5 + 4; /* safe on x86, skips 5-bit rd, 4-bit element */
-    offset >>= 5 + 4;
-#else
-    offset = (inst & 64) ? -(s16)(~inst%64 + 1) : (s16)(inst % 64);
-#endif
-    SWC2[IW_RD(inst)](vt, element, offset, base);
-}
-
 PROFILE_MODE void COP0(u32 inst)
 {
     const unsigned int rd = IW_RD(inst);
@@ -1841,130 +1808,208 @@ PROFILE_MODE void COP0(u32 inst)
     }
 }
 
-PROFILE_MODE void COP2(u32 inst)
+/*
+ * Computational vector operations, with the element specifier `e` choosing
+ * how VT is broadcast before it is handed to the operation.
+ */
+PROFILE_MODE void VU_execute(
+    p_vector_func op, unsigned int vd, unsigned int vs, unsigned int vt,
+    unsigned int e)
 {
-    const unsigned int op = (inst >> 21) % (1 << 5); /* inst.R.rs */
-    const unsigned int vt = (inst >> 16) % (1 << 5); /* inst.R.rt */
-    const unsigned int vs = IW_RD(inst);
-    const unsigned int vd = (inst >>  6) % (1 << 5); /* inst.R.sa */
-    const unsigned int func = inst % (1 << 6);
-#ifndef ARCH_MIN_SSE2
-    const unsigned int e  = op & 0xF; /* With Intel, LEA offsets beat ANDing. */
-#endif
-
-    switch (op) {
-        static ALIGNED i16 shuffle_temporary[N];
+    static ALIGNED i16 shuffle_temporary[N];
 #ifdef ARCH_MIN_SSE2
-        v16 target;
+    v16 target;
 #else
-        register unsigned int i;
+    register unsigned int i;
 #endif
 
-    case 000:
-        MFC2(vt, vs, vd >> 1);
-        break;
-    case 002:
-        CFC2(vt, vs);
-        break;
-    case 004:
-        MTC2(vt, vs, vd >> 1);
-        break;
-    case 006:
-        CTC2(vt, vs);
-        break;
-    case 020:
-    case 021:
+    switch (e) {
+    case 0x0:
+    case 0x1:
 #ifdef ARCH_MIN_SSE2
-        *(v16 *)(VR[vd]) = COP2_C2[func](*(v16 *)VR[vs], *(v16 *)VR[vt]);
+        *(v16 *)(VR[vd]) = op(*(v16 *)VR[vs], *(v16 *)VR[vt]);
 #else
-        COP2_C2[func](&VR[vs][0], &VR[vt][0]);
+        op(&VR[vs][0], &VR[vt][0]);
         vector_copy(&VR[vd][0], &V_result[0]);
 #endif
         break;
-    case 022:
-    case 023:
+    case 0x2:
+    case 0x3:
 #ifdef ARCH_MIN_SSE2
 #ifdef __ARM_NEON__
-        target = (v16)vld1q_u16(&VR[vt][0 + op - 0x12]);
+        target = (v16)vld1q_u16(&VR[vt][0 + e - 0x2]);
         target = (v16)vshlq_n_u32((uint32x4_t)target, 16);
         target = (v16)vorrq_u16((uint16x8_t)target,
                                 (uint16x8_t)vshrq_n_u32((uint32x4_t)target, 16));
 #else
-        shuffle_temporary[0] = VR[vt][0 + op - 0x12];
-        shuffle_temporary[2] = VR[vt][2 + op - 0x12];
-        shuffle_temporary[4] = VR[vt][4 + op - 0x12];
-        shuffle_temporary[6] = VR[vt][6 + op - 0x12];
+        shuffle_temporary[0] = VR[vt][0 + e - 0x2];
+        shuffle_temporary[2] = VR[vt][2 + e - 0x2];
+        shuffle_temporary[4] = VR[vt][4 + e - 0x2];
+        shuffle_temporary[6] = VR[vt][6 + e - 0x2];
         target = *(v16 *)(&shuffle_temporary[0]);
         target = _mm_shufflehi_epi16(target, _MM_SHUFFLE(2, 2, 0, 0));
         target = _mm_shufflelo_epi16(target, _MM_SHUFFLE(2, 2, 0, 0));
 #endif
-        *(v16 *)(VR[vd]) = COP2_C2[func](*(v16 *)VR[vs], target);
+        *(v16 *)(VR[vd]) = op(*(v16 *)VR[vs], target);
 #else
         for (i = 0; i < N; i++)
             shuffle_temporary[i] = VR[vt][(i & 0xE) + (e & 0x1)];
-        COP2_C2[func](&VR[vs][0], &shuffle_temporary[0]);
+        op(&VR[vs][0], &shuffle_temporary[0]);
         vector_copy(&VR[vd][0], &V_result[0]);
 #endif
         break;
-    case 024:
-    case 025:
-    case 026:
-    case 027:
+    case 0x4:
+    case 0x5:
+    case 0x6:
+    case 0x7:
 #ifdef ARCH_MIN_SSE2
 #ifdef __ARM_NEON__
-        target = (v16)vcombine_s16(vdup_n_s16(VR[vt][0 + op - 0x14]),
-                                   vdup_n_s16(VR[vt][4 + op - 0x14]));
+        target = (v16)vcombine_s16(vdup_n_s16(VR[vt][0 + e - 0x4]),
+                                   vdup_n_s16(VR[vt][4 + e - 0x4]));
 #else
         target = _mm_setzero_si128();
-        target = _mm_insert_epi16(target, VR[vt][0 + op - 0x14], 0);
-        target = _mm_insert_epi16(target, VR[vt][4 + op - 0x14], 4);
+        target = _mm_insert_epi16(target, VR[vt][0 + e - 0x4], 0);
+        target = _mm_insert_epi16(target, VR[vt][4 + e - 0x4], 4);
         target = _mm_shufflehi_epi16(target, _MM_SHUFFLE(0, 0, 0, 0));
         target = _mm_shufflelo_epi16(target, _MM_SHUFFLE(0, 0, 0, 0));
 #endif
-        *(v16 *)(VR[vd]) = COP2_C2[func](*(v16 *)VR[vs], target);
+        *(v16 *)(VR[vd]) = op(*(v16 *)VR[vs], target);
 #else
         for (i = 0; i < N; i++)
             shuffle_temporary[i] = VR[vt][(i & 0xC) + (e & 0x3)];
-        COP2_C2[func](&VR[vs][0], &shuffle_temporary[0]);
+        op(&VR[vs][0], &shuffle_temporary[0]);
         vector_copy(&VR[vd][0], &V_result[0]);
 #endif
         break;
-    case 030:
-    case 031:
-    case 032:
-    case 033:
-    case 034:
-    case 035:
-    case 036:
-    case 037:
+    default:
 #ifdef ARCH_MIN_SSE2
-        *(v16 *)(VR[vd]) = COP2_C2[func](
+        *(v16 *)(VR[vd]) = op(
             *(v16 *)VR[vs],
-            _mm_set1_epi16(VR[vt][op - 0x18])
+            _mm_set1_epi16(VR[vt][e - 0x8])
         );
 #else
         for (i = 0; i < N; i++)
             shuffle_temporary[i] = VR[vt][e % N];
-        COP2_C2[func](&VR[vs][0], &shuffle_temporary[0]);
+        op(&VR[vs][0], &shuffle_temporary[0]);
         vector_copy(&VR[vd][0], &V_result[0]);
 #endif
         break;
+    }
+}
+
+PROFILE_MODE void COP2(u32 inst)
+{
+    const unsigned int op = (inst >> 21) % (1 << 5); /* inst.R.rs */
+    const unsigned int vt = (inst >> 16) % (1 << 5); /* inst.R.rt */
+    const unsigned int vs = IW_RD(inst);
+    const unsigned int vd = (inst >>  6) % (1 << 5); /* inst.R.sa */
+    const unsigned int func = inst % (1 << 6);
+
+    switch (op) {
+    case 000:
+        MFC2(vt, vs, vd >> 1);
+        break;
+    case 002:
+        CFC2(vt, vs);
+        break;
+    case 004:
+        MTC2(vt, vs, vd >> 1);
+        break;
+    case 006:
+        CTC2(vt, vs);
+        break;
+    case 020:
+    case 021:
+    case 022:
+    case 023:
+    case 024:
+    case 025:
+    case 026:
+    case 027:
+    case 030:
+    case 031:
+    case 032:
+    case 033:
+    case 034:
+    case 035:
+    case 036:
+    case 037:
+        VU_execute(COP2_C2[func], vd, vs, vt, op & 0xF);
+        break;
     default:
         res_S();
     }
 }
 
+/*
+ * predecoded IMEM
+ *
+ * Vector computations and LWC2/SWC2 transfers are most of the instructions
+ * in LLE micro-code, and each of them goes through a second level of
+ * decoding after the primary op-code.  Their operands and handlers are
+ * cached per IMEM word, tagged with the instruction word they were decoded
+ * from.  Comparing the tag replaces explicit invalidation, so IMEM written
+ * by SP DMA as well as directly by the CPU is always picked up.
+ */
+typedef struct {
+    u32 inst; /* instruction word this entry was decoded from */
+    p_vector_func vector;
+    mwc2_func transfer;
+    s16 offset;
+    u8 vd, vs, vt, e;
+    u8 base;
+} predecoded_inst;
+
+static predecoded_inst predecoded_IMEM[0x1000 / 4];
+
+static NOINLINE void predecode(predecoded_inst* decoded, u32 inst)
+{
+    decoded->inst = inst;
+    decoded->vector = NULL;
+    decoded->transfer = NULL;
+
+    switch (inst >> 26) {
+    case 022: /* COP2 */
+        if (!(inst & 0x02000000))
+            break; /* moves to and from the vector unit */
+        decoded->vector = COP2_C2[inst % (1 << 6)];
+        decoded->vd = (inst >>  6) % (1 << 5);
+        decoded->vs = IW_RD(inst);
+        decoded->vt = (inst >> 16) % (1 << 5);
+        decoded->e  = (inst >> 21) % (1 << 4);
+        break;
+    case 062: /* LWC2 */
+    case 072: /* SWC2 */
+        decoded->transfer = ((inst >> 26) == 062 ? LWC2 : SWC2)[IW_RD(inst)];
+        decoded->base = (inst >> 21) % (1 << 5);
+        decoded->vt = (inst >> 16) % (1 << 5);
+        decoded->e  = (inst >>  7) % (1 << 4);
+        decoded->offset = (inst & 64) ? -(s16)(~inst%64 + 1) : (s16)(inst % 64);
+        break;
+    }
+}
+
+#ifdef SP_TASK_BENCHMARK
+u64 SP_instructions_run;
+#endif
+
 NOINLINE void run_task(void)
 {
+    predecoded_inst* decoded;
     register u32 PC;
+    u32 inst_PC;
 
     PC = FIT_IMEM(GET_RCP_REG(SP_PC_REG));
     for (;;) {
+        inst_PC = PC;
         inst_word = *(pi32)(IMEM + FIT_IMEM(PC));
 #ifdef EMULATE_STATIC_PC
         PC = (PC + 0x004);
 EX:
 #endif
+#ifdef SP_TASK_BENCHMARK
+        ++SP_instructions_run;
+#endif
 #ifdef SP_EXECUTE_LOG
         step_SP_commands(inst_word);
 #endif
@@ -2037,7 +2082,14 @@ EX:
                 goto RSP_halted_CPU_exit_point;
             break;
         case 022:
-            COP2(inst_word);
+            decoded = &predecoded_IMEM[FIT_IMEM(inst_PC) >> 2];
+            if (decoded->inst != inst_word)
+                predecode(decoded, inst_word);
+            if (decoded->vector == NULL)
+                COP2(inst_word);
+            else
+                VU_execute(decoded->vector,
+                    decoded->vd, decoded->vs, decoded->vt, decoded->e);
             break;
         case 040:
             LB(inst_word);
@@ -2064,10 +2116,12 @@ EX:
             SW(inst_word);
             break;
         case 062: /* LWC2 */
-            MWC2_load(inst_word);
-            break;
         case 072: /* SWC2 */
-            MWC2_store(inst_word);
+            decoded = &predecoded_IMEM[FIT_IMEM(inst_PC) >> 2];
+            if (decoded->inst != inst_word)
+                predecode(decoded, inst_word);
+            decoded->transfer(
+                decoded->vt, decoded->e, decoded->offset, decoded->base);
             break;
         default:
             res_S();
@@ -2086,6 +2140,7 @@ EX:
 #else
         continue;
 set_branch_delay:
+        inst_PC = PC;
         inst_word = *(pi32)(IMEM + FIT_IMEM(PC));
         PC = FIT_IMEM(temp_PC);
         goto EX;
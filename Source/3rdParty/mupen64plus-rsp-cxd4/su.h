@@ -27,6 +27,7 @@
 
 #if (0)
 #define SP_EXECUTE_LOG
+#define SP_TASK_BENCHMARK
 #define VU_EMULATE_SCALAR_ACCUMULATOR_READ
 #endif
 
@@ -390,4 +391,12 @@ extern void STV(unsigned vt, unsigned element, signed offset, unsigned base);
 
 NOINLINE extern void run_task(void);
 
+#ifdef SP_TASK_BENCHMARK
+/*
+ * count of instructions interpreted by run_task, so that DoRspCycles can
+ * measure the throughput of the interpreter for each type of task
+ */
+extern u64 SP_instructions_run;
+#endif
+
 #endif
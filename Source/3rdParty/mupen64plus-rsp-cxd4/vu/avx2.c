@@ -0,0 +1,290 @@
+/******************************************************************************\
+* Project:  MSP Simulation Layer for AVX2 Vector Unit Computational Operations *
+* License:  CC0 Public Domain Dedication                                       *
+*                                                                              *
+* To the extent possible under law, the author(s) have dedicated all copyright *
+* and related and neighboring rights to this software to the public domain     *
+* worldwide. This software is distributed without any warranty.                *
+*                                                                              *
+* You should have received a copy of the CC0 Public Domain Dedication along    *
+* with this software.                                                          *
+* If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.             *
+\******************************************************************************/
+
+#include "avx2.h"
+
+#if defined(ARCH_MIN_SSE2) && !defined(SSE2NEON) && ( \
+    defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86))
+#define VU_AVX2
+#endif
+
+#ifdef VU_AVX2
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET     __attribute__((target("avx2")))
+#endif
+
+/*
+ * These are register-only rewrites of the add and select operations, whose
+ * portable versions in add.c and select.c are written as loops over arrays
+ * for the compiler to vectorize and pay for storing every operand to memory.
+ * Building them for AVX2 gets us the VEX encoding as well as PSIGNW and
+ * PBLENDVB, which the SSE2 baseline does not have.  VADD, VSUB, VEQ and VNE
+ * already vectorize well enough from the portable code and are left alone.
+ *
+ * Every result must be identical to that of the baseline operation, so the
+ * tests are transcribed literally from the portable code.  All of the flags
+ * in `cf_*` only ever hold 0 or 1, which lets us turn them into masks by
+ * negation and back again with a logical shift right by 15.
+ *
+ * The multiply operations are not here:  they were already written for SSE2
+ * and 32-bit intermediates in YMM registers did not make them any faster.
+ */
+#define flag_mask(flag)         _mm_sub_epi16(_mm_setzero_si128(), flag)
+#define mask_flag(mask)         _mm_srli_epi16(mask, 15)
+#define load_flags(flags)       _mm_load_si128((v16 *)(flags))
+#define store_flags(flags, x)   _mm_store_si128((v16 *)(flags), x)
+#define wipe_flags(flags)       store_flags(flags, _mm_setzero_si128())
+
+static INLINE AVX2_TARGET v16 select_mask(v16 mask, v16 pass, v16 fail)
+{
+    return _mm_blendv_epi8(fail, pass, mask);
+}
+
+static AVX2_TARGET v16 VABS_AVX2(v16 vs, v16 vt)
+{
+    v16 res, cch;
+
+/*
+ * PSIGNW is exactly VT * sign(VS) with wrapping, so -(-32768) is -32768,
+ * which the corner case hack then adjusts by -1 the same way do_abs does.
+ */
+    res = _mm_sign_epi16(vt, vs);
+    cch = _mm_cmpeq_epi16(vt, _mm_set1_epi16(-32768));
+    res = _mm_add_epi16(res, cch);
+    *(v16 *)VACC_L = res;
+    return (res);
+}
+
+static AVX2_TARGET v16 VADDC_AVX2(v16 vs, v16 vt)
+{
+    v16 sum, vco;
+
+    sum = _mm_add_epi16(vs, vt);
+    vco = _mm_cmpeq_epi16(_mm_adds_epu16(vs, vt), sum); /* no carry out */
+    *(v16 *)VACC_L = sum;
+
+    wipe_flags(cf_ne);
+    store_flags(cf_co, _mm_add_epi16(vco, _mm_set1_epi16(1)));
+    return (sum);
+}
+
+static AVX2_TARGET v16 VSUBC_AVX2(v16 vs, v16 vt)
+{
+    v16 dif, vne, vco;
+    const v16 one = _mm_set1_epi16(1);
+
+    dif = _mm_sub_epi16(vs, vt);
+    vne = _mm_cmpeq_epi16(vs, vt);
+    vco = _mm_cmpeq_epi16(_mm_subs_epu16(vt, vs), _mm_setzero_si128());
+    *(v16 *)VACC_L = dif;
+
+    store_flags(cf_ne, _mm_add_epi16(vne, one));
+    store_flags(cf_co, _mm_add_epi16(vco, one)); /* borrow out */
+    return (dif);
+}
+
+static AVX2_TARGET v16 VLT_AVX2(v16 vs, v16 vt)
+{
+    v16 eq, cn, comp;
+
+    cn = _mm_and_si128(load_flags(cf_ne), load_flags(cf_co));
+    eq = _mm_and_si128(_mm_cmpeq_epi16(vs, vt), flag_mask(cn));
+    comp = _mm_or_si128(_mm_cmplt_epi16(vs, vt), eq);
+    vs = select_mask(comp, vs, vt);
+    *(v16 *)VACC_L = vs;
+
+    store_flags(cf_comp, mask_flag(comp));
+    wipe_flags(cf_ne);
+    wipe_flags(cf_co);
+    wipe_flags(cf_clip);
+    return (vs);
+}
+
+static AVX2_TARGET v16 VGE_AVX2(v16 vs, v16 vt)
+{
+    v16 eq, cn, comp;
+
+    cn = _mm_and_si128(load_flags(cf_ne), load_flags(cf_co));
+    eq = _mm_andnot_si128(flag_mask(cn), _mm_cmpeq_epi16(vs, vt));
+    comp = _mm_or_si128(_mm_cmpgt_epi16(vs, vt), eq);
+    vs = select_mask(comp, vs, vt);
+    *(v16 *)VACC_L = vs;
+
+    store_flags(cf_comp, mask_flag(comp));
+    wipe_flags(cf_ne);
+    wipe_flags(cf_co);
+    wipe_flags(cf_clip);
+    return (vs);
+}
+
+static AVX2_TARGET v16 VCL_AVX2(v16 vs, v16 vt)
+{
+    v16 vc, eq, sn, ge, le, gen, len, lz, uz, vce, cmp;
+    const v16 one = _mm_set1_epi16(1);
+
+    eq = _mm_xor_si128(load_flags(cf_ne), one);
+    sn = load_flags(cf_co);
+    vce = load_flags(cf_vce);
+
+    vc = _mm_xor_si128(vt, flag_mask(sn));
+    vc = _mm_add_epi16(vc, sn); /* conditional negation, if sn */
+    lz = _mm_cmpeq_epi16(_mm_sub_epi16(vs, vc), _mm_setzero_si128());
+    lz = mask_flag(lz);
+    uz = _mm_cmpeq_epi16(_mm_adds_epu16(vs, vt), _mm_add_epi16(vs, vt));
+
+    gen = _mm_or_si128(lz, uz);
+    len = _mm_and_si128(lz, uz);
+    gen = _mm_and_si128(gen, vce);
+    len = _mm_andnot_si128(vce, len);
+    len = _mm_or_si128(len, gen);
+    gen = _mm_cmpeq_epi16(_mm_max_epu16(vs, vc), vs); /* VB >= VC */
+    gen = mask_flag(gen);
+
+    cmp = _mm_and_si128(eq, sn);
+    le = select_mask(flag_mask(cmp), len, load_flags(cf_comp));
+    cmp = _mm_andnot_si128(sn, eq);
+    ge = select_mask(flag_mask(cmp), gen, load_flags(cf_clip));
+
+    cmp = select_mask(flag_mask(sn), le, ge);
+    vs = select_mask(flag_mask(cmp), vc, vs);
+    *(v16 *)VACC_L = vs;
+
+    wipe_flags(cf_ne);
+    wipe_flags(cf_co);
+    store_flags(cf_clip, ge);
+    store_flags(cf_comp, le);
+    wipe_flags(cf_vce);
+    return (vs);
+}
+
+static AVX2_TARGET v16 VCH_AVX2(v16 vs, v16 vt)
+{
+    v16 vc, sn, eq, ge, le, vce, cch, diff;
+    const v16 ones = _mm_cmpeq_epi16(vs, vs);
+
+    cch = _mm_cmpeq_epi16(vt, _mm_set1_epi16(-32768));
+    sn = _mm_srai_epi16(_mm_xor_si128(vs, vt), 15);
+    vc = _mm_xor_si128(vt, sn);
+    vce = _mm_and_si128(_mm_cmpeq_epi16(vs, vc), sn);
+    vc = _mm_sub_epi16(vc, _mm_andnot_si128(cch, sn));
+
+    eq = _mm_andnot_si128(cch, _mm_cmpeq_epi16(vs, vc));
+    eq = _mm_or_si128(eq, vce);
+
+    diff = _mm_or_si128(sn, vs);
+    ge = _mm_xor_si128(_mm_cmpgt_epi16(vt, diff), ones);
+    diff = _mm_sub_epi16(vc, vs);
+    diff = _mm_xor_si128(_mm_srai_epi16(diff, 15), ones);
+    le = _mm_srai_epi16(vt, 15);
+    le = select_mask(sn, diff, le);
+
+    vs = select_mask(select_mask(sn, le, ge), vc, vs);
+    *(v16 *)VACC_L = vs;
+
+    store_flags(cf_clip, mask_flag(ge));
+    store_flags(cf_comp, mask_flag(le));
+    store_flags(cf_ne, mask_flag(_mm_xor_si128(eq, ones)));
+    store_flags(cf_co, mask_flag(sn));
+    store_flags(cf_vce, mask_flag(vce));
+    return (vs);
+}
+
+static AVX2_TARGET v16 VCR_AVX2(v16 vs, v16 vt)
+{
+    v16 vc, sn, ge, le, cmp;
+    const v16 one = _mm_set1_epi16(1);
+
+    sn = _mm_srai_epi16(_mm_xor_si128(vs, vt), 15);
+    cmp = _mm_andnot_si128(_mm_and_si128(vs, sn), _mm_cmpeq_epi16(vs, vs));
+    le = _mm_andnot_si128(_mm_cmpgt_epi16(vt, cmp), one);
+    cmp = _mm_or_si128(vs, sn);
+    ge = _mm_andnot_si128(_mm_cmpgt_epi16(vt, cmp), one);
+    vc = _mm_xor_si128(vt, sn);
+
+/*
+ * do_cr merges with `sn` still being ~0 rather than 1, so both of these are
+ * the multiplying `merge` formula from select.c and not plain selections.
+ */
+    cmp = _mm_sub_epi16(ge, _mm_and_si128(sn, _mm_sub_epi16(le, ge)));
+    vc = _mm_mullo_epi16(cmp, _mm_sub_epi16(vc, vs));
+    vs = _mm_add_epi16(vs, vc);
+    *(v16 *)VACC_L = vs;
+
+    wipe_flags(cf_ne);
+    wipe_flags(cf_co);
+    store_flags(cf_clip, ge);
+    store_flags(cf_comp, le);
+    wipe_flags(cf_vce);
+    return (vs);
+}
+
+static AVX2_TARGET v16 VMRG_AVX2(v16 vs, v16 vt)
+{
+    vs = select_mask(flag_mask(load_flags(cf_comp)), vs, vt);
+    *(v16 *)VACC_L = vs;
+    return (vs);
+}
+
+static int cpu_has_AVX2(void)
+{
+#ifdef _MSC_VER
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return 0; /* no OSXSAVE or no AVX */
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return 0; /* The OS does not save the YMM registers. */
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+int VU_select_AVX2(void)
+{
+    if (!cpu_has_AVX2())
+        return 0;
+
+    COP2_C2[023] = VABS_AVX2;
+    COP2_C2[024] = VADDC_AVX2;
+    COP2_C2[025] = VSUBC_AVX2;
+
+    COP2_C2[040] = VLT_AVX2;
+    COP2_C2[043] = VGE_AVX2;
+    COP2_C2[044] = VCL_AVX2;
+    COP2_C2[045] = VCH_AVX2;
+    COP2_C2[046] = VCR_AVX2;
+    COP2_C2[047] = VMRG_AVX2;
+    return 1;
+}
+
+#else
+
+int VU_select_AVX2(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,29 @@
+/******************************************************************************\
+* Project:  Run-Time Selection of AVX2 Vector Unit Computational Operations    *
+* License:  CC0 Public Domain Dedication                                       *
+*                                                                              *
+* To the extent possible under law, the author(s) have dedicated all copyright *
+* and related and neighboring rights to this software to the public domain     *
+* worldwide. This software is distributed without any warranty.                *
+*                                                                              *
+* You should have received a copy of the CC0 Public Domain Dedication along    *
+* with this software.                                                          *
+* If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.             *
+\******************************************************************************/
+
+#ifndef _AVX2_H_
+#define _AVX2_H_
+
+#include "vu.h"
+
+/*
+ * The SSE2 build of the vector unit is the baseline, but on x86 CPUs which
+ * support AVX2 (and operating systems saving the YMM state) we can replace
+ * some of the entries in `COP2_C2` with versions built for the newer ISA.
+ *
+ * Call this once before the first task is run.  Returns non-zero if the
+ * AVX2 operations were installed, and zero if the baseline is kept.
+ */
+extern int VU_select_AVX2(void);
+
+#endif
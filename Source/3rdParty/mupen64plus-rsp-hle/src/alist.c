@@ -69,6 +69,55 @@ static void sample_mix(int16_t* dst, int16_t src, int16_t gain)
     *dst = clamp_s16(*dst + ((src * gain) >> 15));
 }
 
+static void sample_mix8(int16_t* dst, const int16_t* src, const int16_t* gains)
+{
+#if defined(HLE_SSE2)
+    const __m128i d = _mm_loadu_si128((const __m128i*)dst);
+    const __m128i x = _mm_loadu_si128((const __m128i*)src);
+    const __m128i g = _mm_loadu_si128((const __m128i*)gains);
+    const __m128i lo = _mm_mullo_epi16(x, g);
+    const __m128i hi = _mm_mulhi_epi16(x, g);
+    __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+    __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+
+    p0 = _mm_add_epi32(p0, _mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16));
+    p1 = _mm_add_epi32(p1, _mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16));
+
+    _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(p0, p1));
+#elif defined(HLE_NEON)
+    const int16x8_t d = vld1q_s16(dst);
+    const int16x8_t x = vld1q_s16(src);
+    const int16x8_t g = vld1q_s16(gains);
+    const int32x4_t p0 = vaddw_s16(vshrq_n_s32(vmull_s16(vget_low_s16(x), vget_low_s16(g)), 15), vget_low_s16(d));
+    const int32x4_t p1 = vaddw_s16(vshrq_n_s32(vmull_s16(vget_high_s16(x), vget_high_s16(g)), 15), vget_high_s16(d));
+
+    vst1q_s16(dst, vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1)));
+#else
+    size_t i;
+
+    for(i = 0; i < 8; ++i)
+        sample_mix(&dst[i], src[i], gains[i]);
+#endif
+}
+
+#if defined(HLE_SSE2)
+/* high 16 bits of signed x times unsigned y */
+static inline __m128i mulhi_su16(__m128i x, __m128i y)
+{
+    return _mm_sub_epi16(_mm_mulhi_epu16(x, y), _mm_and_si128(_mm_srai_epi16(x, 15), y));
+}
+#elif defined(HLE_NEON)
+/* high 16 bits of signed x times unsigned y */
+static inline int16x8_t mulhi_su16(int16x8_t x, uint16_t y)
+{
+    const int32x4_t y32 = vdupq_n_s32(y);
+    const int32x4_t lo = vmulq_s32(vmovl_s16(vget_low_s16(x)), y32);
+    const int32x4_t hi = vmulq_s32(vmovl_s16(vget_high_s16(x)), y32);
+
+    return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+}
+#endif
+
 static void alist_envmix_mix(size_t n, int16_t** dst, const int16_t* gains, int16_t src)
 {
     size_t i;
@@ -96,6 +145,31 @@ static int16_t ramp_step(struct ramp_t* ramp)
     return (int16_t)(ramp->value >> 16);
 }
 
+/* ramps and mixes a block of 8 samples, dst and in point to the start of the block */
+static void alist_envmix_mix_block(size_t n, int16_t** dst, const int16_t* in,
+        struct ramp_t* ramps, int16_t dry, int16_t wet)
+{
+    int16_t gains[4][8];
+    int16_t src[8];
+    size_t i;
+
+    for(i = 0; i < 8; ++i) {
+        int16_t l_vol = ramp_step(&ramps[0]);
+        int16_t r_vol = ramp_step(&ramps[1]);
+
+        gains[0][i^S] = clamp_s16((l_vol * dry + 0x4000) >> 15);
+        gains[1][i^S] = clamp_s16((r_vol * dry + 0x4000) >> 15);
+        gains[2][i^S] = clamp_s16((l_vol * wet + 0x4000) >> 15);
+        gains[3][i^S] = clamp_s16((r_vol * wet + 0x4000) >> 15);
+    }
+
+    /* the input may be one of the outputs */
+    memcpy(src, in, sizeof(src));
+
+    for(i = 0; i < n; ++i)
+        sample_mix8(dst[i], src, gains[i]);
+}
+
 /* global functions */
 void alist_process(struct hle_t* hle, const acmd_callback_t abi[], unsigned int abi_size)
 {
@@ -279,7 +353,7 @@ void alist_envmix_exp(
     int32_t exp_rates[2];
 
     uint32_t ptr = 0;
-    int x, y;
+    int y;
     short save_buffer[40];
 
     memcpy((uint8_t *)save_buffer, (hle->dram + address), sizeof(save_buffer));
@@ -323,25 +397,15 @@ void alist_envmix_exp(
             ramps[1].step = (exp_seq[1] - ramps[1].value) >> 3;
         }
 
-        for (x = 0; x < 8; ++x) {
-            int16_t  gains[4];
-            int16_t* buffers[4];
-            int16_t l_vol = ramp_step(&ramps[0]);
-            int16_t r_vol = ramp_step(&ramps[1]);
-
-            buffers[0] = dl + (ptr^S);
-            buffers[1] = dr + (ptr^S);
-            buffers[2] = wl + (ptr^S);
-            buffers[3] = wr + (ptr^S);
+        int16_t* buffers[4];
 
-            gains[0] = clamp_s16((l_vol * dry + 0x4000) >> 15);
-            gains[1] = clamp_s16((r_vol * dry + 0x4000) >> 15);
-            gains[2] = clamp_s16((l_vol * wet + 0x4000) >> 15);
-            gains[3] = clamp_s16((r_vol * wet + 0x4000) >> 15);
+        buffers[0] = dl + ptr;
+        buffers[1] = dr + ptr;
+        buffers[2] = wl + ptr;
+        buffers[3] = wr + ptr;
 
-            alist_envmix_mix(n, buffers, gains, in[ptr^S]);
-            ++ptr;
-        }
+        alist_envmix_mix_block(n, buffers, in + ptr, ramps, dry, wet);
+        ptr += 8;
     }
 
     *(int16_t *)(save_buffer +  0) = wet;               /* 0-1 */
@@ -404,7 +468,18 @@ void alist_envmix_ge(
     }
 
     count >>= 1;
-    for (k = 0; k < count; ++k) {
+    for (k = 0; k + 8 <= count; k += 8) {
+        int16_t* buffers[4];
+
+        buffers[0] = dl + k;
+        buffers[1] = dr + k;
+        buffers[2] = wl + k;
+        buffers[3] = wr + k;
+
+        alist_envmix_mix_block(n, buffers, in + k, ramps, dry, wet);
+    }
+
+    for (; k < count; ++k) {
         int16_t  gains[4];
         int16_t* buffers[4];
         int16_t l_vol = ramp_step(&ramps[0]);
@@ -479,7 +554,18 @@ void alist_envmix_lin(
     }
 
     count >>= 1;
-    for(k = 0; k < count; ++k) {
+    for (k = 0; k + 8 <= count; k += 8) {
+        int16_t* buffers[4];
+
+        buffers[0] = dl + k;
+        buffers[1] = dr + k;
+        buffers[2] = wl + k;
+        buffers[3] = wr + k;
+
+        alist_envmix_mix_block(4, buffers, in + k, ramps, dry, wet);
+    }
+
+    for (; k < count; ++k) {
         int16_t  gains[4];
         int16_t* buffers[4];
         int16_t l_vol = ramp_step(&ramps[0]);
@@ -535,6 +621,29 @@ void alist_envmix_nead(
         swap(&wl, &wr);
 
     while (count != 0) {
+#if defined(HLE_SSE2)
+        const __m128i x = _mm_loadu_si128((const __m128i*)in);
+        const __m128i l  = _mm_xor_si128(mulhi_su16(x, _mm_set1_epi16((int16_t)env_values[0])), _mm_set1_epi16(xors[0]));
+        const __m128i r  = _mm_xor_si128(mulhi_su16(x, _mm_set1_epi16((int16_t)env_values[1])), _mm_set1_epi16(xors[1]));
+        const __m128i l2 = _mm_xor_si128(mulhi_su16(l, _mm_set1_epi16((int16_t)env_values[2])), _mm_set1_epi16(xors[2]));
+        const __m128i r2 = _mm_xor_si128(mulhi_su16(r, _mm_set1_epi16((int16_t)env_values[2])), _mm_set1_epi16(xors[3]));
+
+        _mm_storeu_si128((__m128i*)dl, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)dl), l));
+        _mm_storeu_si128((__m128i*)dr, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)dr), r));
+        _mm_storeu_si128((__m128i*)wl, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)wl), l2));
+        _mm_storeu_si128((__m128i*)wr, _mm_adds_epi16(_mm_loadu_si128((const __m128i*)wr), r2));
+#elif defined(HLE_NEON)
+        const int16x8_t x = vld1q_s16(in);
+        const int16x8_t l  = veorq_s16(mulhi_su16(x, env_values[0]), vdupq_n_s16(xors[0]));
+        const int16x8_t r  = veorq_s16(mulhi_su16(x, env_values[1]), vdupq_n_s16(xors[1]));
+        const int16x8_t l2 = veorq_s16(mulhi_su16(l, env_values[2]), vdupq_n_s16(xors[2]));
+        const int16x8_t r2 = veorq_s16(mulhi_su16(r, env_values[2]), vdupq_n_s16(xors[3]));
+
+        vst1q_s16(dl, vqaddq_s16(vld1q_s16(dl), l));
+        vst1q_s16(dr, vqaddq_s16(vld1q_s16(dr), r));
+        vst1q_s16(wl, vqaddq_s16(vld1q_s16(wl), l2));
+        vst1q_s16(wr, vqaddq_s16(vld1q_s16(wr), r2));
+#else
         size_t i;
         for(i = 0; i < 8; ++i) {
             int16_t l  = (((int32_t)in[i^S] * (uint32_t)env_values[0]) >> 16) ^ xors[0];
@@ -547,6 +656,7 @@ void alist_envmix_nead(
             wl[i^S] = clamp_s16(wl[i^S] + l2);
             wr[i^S] = clamp_s16(wr[i^S] + r2);
         }
+#endif
 
         env_values[0] += env_steps[0];
         env_values[1] += env_steps[1];
@@ -569,6 +679,22 @@ void alist_mix(struct hle_t* hle, uint16_t dmemo, uint16_t dmemi, uint16_t count
 
     count >>= 1;
 
+    if (count >= 8) {
+        int16_t gains[8];
+        size_t i;
+
+        for(i = 0; i < 8; ++i)
+            gains[i] = gain;
+
+        while(count >= 8) {
+            sample_mix8(dst, src, gains);
+
+            dst += 8;
+            src += 8;
+            count -= 8;
+        }
+    }
+
     while(count != 0) {
         sample_mix(dst, *src, gain);
 
@@ -584,6 +710,34 @@ void alist_multQ44(struct hle_t* hle, uint16_t dmem, uint16_t count, int8_t gain
 
     count >>= 1;
 
+#if defined(HLE_SSE2)
+    const __m128i g = _mm_set1_epi16(gain);
+
+    while(count >= 8) {
+        const __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        const __m128i lo = _mm_mullo_epi16(d, g);
+        const __m128i hi = _mm_mulhi_epi16(d, g);
+
+        _mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(
+                    _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 4),
+                    _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 4)));
+
+        dst += 8;
+        count -= 8;
+    }
+#elif defined(HLE_NEON)
+    while(count >= 8) {
+        const int16x8_t d = vld1q_s16(dst);
+
+        vst1q_s16(dst, vcombine_s16(
+                    vqshrn_n_s32(vmull_n_s16(vget_low_s16(d), gain), 4),
+                    vqshrn_n_s32(vmull_n_s16(vget_high_s16(d), gain), 4)));
+
+        dst += 8;
+        count -= 8;
+    }
+#endif
+
     while(count != 0) {
         *dst = clamp_s16(*dst * gain >> 4);
 
@@ -599,6 +753,26 @@ void alist_add(struct hle_t* hle, uint16_t dmemo, uint16_t dmemi, uint16_t count
 
     count >>= 1;
 
+#if defined(HLE_SSE2)
+    while(count >= 8) {
+        _mm_storeu_si128((__m128i*)dst, _mm_adds_epi16(
+                    _mm_loadu_si128((const __m128i*)dst),
+                    _mm_loadu_si128((const __m128i*)src)));
+
+        dst += 8;
+        src += 8;
+        count -= 8;
+    }
+#elif defined(HLE_NEON)
+    while(count >= 8) {
+        vst1q_s16(dst, vqaddq_s16(vld1q_s16(dst), vld1q_s16(src)));
+
+        dst += 8;
+        src += 8;
+        count -= 8;
+    }
+#endif
+
     while(count != 0) {
         *dst = clamp_s16(*dst + *src);
 
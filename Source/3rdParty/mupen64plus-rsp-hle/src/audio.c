@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "arithmetics.h"
 
@@ -115,14 +116,82 @@ void adpcm_compute_residuals(int16_t* dst, const int16_t* src,
     const int16_t l1 = last_samples[0];
     const int16_t l2 = last_samples[1];
 
-    size_t i;
-
     assert(count <= 8);
 
+#if defined(HLE_SSE2) || defined(HLE_NEON)
+    /* all 8 residuals are computed at once, rdot(i, book2, src) becomes a sum
+     * of src[j] times book2 shifted up by j + 1 lanes */
+    int16_t in[8] = { 0 };
+    int16_t out[8];
+
+    memcpy(in, src, count * sizeof(in[0]));
+#endif
+
+#if defined(HLE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i b1 = _mm_loadu_si128((const __m128i*)book1);
+    const __m128i b2 = _mm_loadu_si128((const __m128i*)book2);
+    const __m128i x = _mm_loadu_si128((const __m128i*)in);
+    const __m128i l = _mm_set1_epi32((uint16_t)l1 | ((uint32_t)(uint16_t)l2 << 16));
+    const __m128i s11 = _mm_set1_epi32(1 << 11);
+
+    __m128i acc_lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(b1, b2), l),
+                                   _mm_madd_epi16(_mm_unpacklo_epi16(x, zero), s11));
+    __m128i acc_hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(b1, b2), l),
+                                   _mm_madd_epi16(_mm_unpackhi_epi16(x, zero), s11));
+
+#define RDOT_PAIR(j) \
+    { \
+        const __m128i c0 = _mm_slli_si128(b2, 2 * ((j) + 1)); \
+        const __m128i c1 = _mm_slli_si128(b2, 2 * ((j) + 2)); \
+        const __m128i sj = _mm_set1_epi32((uint16_t)in[j] | ((uint32_t)(uint16_t)in[(j) + 1] << 16)); \
+        acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(_mm_unpacklo_epi16(c0, c1), sj)); \
+        acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(_mm_unpackhi_epi16(c0, c1), sj)); \
+    }
+    RDOT_PAIR(0)
+    RDOT_PAIR(2)
+    RDOT_PAIR(4)
+    RDOT_PAIR(6)
+#undef RDOT_PAIR
+
+    _mm_storeu_si128((__m128i*)out, _mm_packs_epi32(_mm_srai_epi32(acc_lo, 11), _mm_srai_epi32(acc_hi, 11)));
+    memcpy(dst, out, count * sizeof(out[0]));
+#elif defined(HLE_NEON)
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t b1 = vld1q_s16(book1);
+    const int16x8_t b2 = vld1q_s16(book2);
+    const int16x8_t x = vld1q_s16(in);
+
+    int32x4_t acc_lo = vmull_n_s16(vget_low_s16(x), 1 << 11);
+    int32x4_t acc_hi = vmull_n_s16(vget_high_s16(x), 1 << 11);
+    acc_lo = vmlal_n_s16(vmlal_n_s16(acc_lo, vget_low_s16(b1), l1), vget_low_s16(b2), l2);
+    acc_hi = vmlal_n_s16(vmlal_n_s16(acc_hi, vget_high_s16(b1), l1), vget_high_s16(b2), l2);
+
+#define RDOT_TERM(j) \
+    { \
+        const int16x8_t c = vextq_s16(zero, b2, 7 - (j)); \
+        acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(c), in[j]); \
+        acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(c), in[j]); \
+    }
+    RDOT_TERM(0)
+    RDOT_TERM(1)
+    RDOT_TERM(2)
+    RDOT_TERM(3)
+    RDOT_TERM(4)
+    RDOT_TERM(5)
+    RDOT_TERM(6)
+#undef RDOT_TERM
+
+    vst1q_s16(out, vcombine_s16(vqshrn_n_s32(acc_lo, 11), vqshrn_n_s32(acc_hi, 11)));
+    memcpy(dst, out, count * sizeof(out[0]));
+#else
+    size_t i;
+
     for(i = 0; i < count; ++i) {
         int32_t accu = (int32_t)src[i] << 11;
         accu += book1[i]*l1 + book2[i]*l2 + rdot(i, book2, src);
         dst[i] = clamp_s16(accu >> 11);
    }
+#endif
 }
 
@@ -199,9 +199,15 @@ static struct RGBA YCbCr_to_RGBA(int16_t Y, int16_t Cb, int16_t Cr, uint8_t alph
     struct RGBA color;
 
     //Format S10.6
-    int r = (int)(((double)Y + 0.5) + (1.765625 * (double)(Cr - 128)));
-    int g = (int)(((double)Y + 0.5) - (0.34375 * (double)(Cr - 128)) - (0.71875 * (double)(Cb - 128)));
-    int b = (int)(((double)Y + 0.5) + (1.40625 * (double)(Cb - 128)));
+    //All coefficients are multiples of 1/64 (1.765625 = 113/64, 0.34375 = 22/64,
+    //0.71875 = 46/64, 1.40625 = 90/64), so the conversion is done in fixed point.
+    //Division truncates toward zero like the (int) cast of the original formula.
+    const int y = Y * 64 + 32;
+    const int cb = Cb - 128;
+    const int cr = Cr - 128;
+    int r = (y + 113 * cr) / 64;
+    int g = (y - 22 * cr - 46 * cb) / 64;
+    int b = (y + 90 * cb) / 64;
 
     color.r = SATURATE8(r);
     color.g = SATURATE8(g);
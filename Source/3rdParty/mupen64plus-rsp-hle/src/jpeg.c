@@ -44,7 +44,9 @@ static void jpeg_decode_std(struct hle_t* hle,
 
 /* helper functions */
 static uint8_t clamp_u8(int16_t x);
+#if !defined(HLE_SSE2) && !defined(HLE_NEON)
 static int16_t clamp_s12(int16_t x);
+#endif
 static uint16_t clamp_RGBA_component(int16_t x);
 
 /* pixel conversion & formatting */
@@ -72,7 +74,9 @@ static void ReorderSubBlock(int16_t *dst, const int16_t *src, const unsigned int
 static void MultSubBlocks(int16_t *dst, const int16_t *src1, const int16_t *src2, unsigned int shift);
 static void ScaleSubBlock(int16_t *dst, const int16_t *src, int16_t scale);
 static void RShiftSubBlock(int16_t *dst, const int16_t *src, unsigned int shift);
+#if !defined(HLE_SSE2) && !defined(HLE_NEON)
 static void InverseDCT1D(const float *const x, float *dst, unsigned int stride);
+#endif
 static void InverseDCTSubBlock(int16_t *dst, const int16_t *src);
 static void RescaleYSubBlock(int16_t *dst, const int16_t *src);
 static void RescaleUVSubBlock(int16_t *dst, const int16_t *src);
@@ -273,6 +277,7 @@ static uint8_t clamp_u8(int16_t x)
     return (x & (0xff00)) ? ((-x) >> 15) & 0xff : x;
 }
 
+#if !defined(HLE_SSE2) && !defined(HLE_NEON)
 static int16_t clamp_s12(int16_t x)
 {
     if (x < -0x800)
@@ -281,6 +286,7 @@ static int16_t clamp_s12(int16_t x)
         x = 0x7f0;
     return x;
 }
+#endif
 
 static uint16_t clamp_RGBA_component(int16_t x)
 {
@@ -485,10 +491,35 @@ static void MultSubBlocks(int16_t *dst, const int16_t *src1, const int16_t *src2
 {
     unsigned int i;
 
+#if defined(HLE_SSE2)
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)&src1[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i*)&src2[i]);
+        const __m128i lo = _mm_mullo_epi16(a, b);
+        const __m128i hi = _mm_mulhi_epi16(a, b);
+        const __m128i v = _mm_packs_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi));
+
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_sll_epi16(v, count));
+    }
+#elif defined(HLE_NEON)
+    const int16x8_t count = vdupq_n_s16(shift);
+
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        const int16x8_t a = vld1q_s16(&src1[i]);
+        const int16x8_t b = vld1q_s16(&src2[i]);
+        const int16x8_t v = vcombine_s16(vqmovn_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b))),
+                                         vqmovn_s32(vmull_s16(vget_high_s16(a), vget_high_s16(b))));
+
+        vst1q_s16(&dst[i], vshlq_s16(v, count));
+    }
+#else
     for (i = 0; i < SUBBLOCK_SIZE; ++i) {
         int32_t v = src1[i] * src2[i];
         dst[i] = clamp_s16(v) << shift;
     }
+#endif
 }
 
 static void ScaleSubBlock(int16_t *dst, const int16_t *src, int16_t scale)
@@ -515,6 +546,134 @@ static void RShiftSubBlock(int16_t *dst, const int16_t *src, unsigned int shift)
  * Implementation based on Wikipedia :
  * http://fr.wikipedia.org/wiki/Transform%C3%A9e_en_cosinus_discr%C3%A8te
  **************************************************************************/
+#if defined(HLE_SSE2) || defined(HLE_NEON)
+#if defined(HLE_SSE2)
+typedef __m128 f32x4_t;
+#define f32x4_load(p)       _mm_loadu_ps(p)
+#define f32x4_store(p, a)   _mm_storeu_ps((p), (a))
+#define f32x4_add(a, b)     _mm_add_ps((a), (b))
+#define f32x4_sub(a, b)     _mm_sub_ps((a), (b))
+#define f32x4_mulk(k, a)    _mm_mul_ps(_mm_set1_ps(k), (a))
+#elif defined(HLE_NEON)
+typedef float32x4_t f32x4_t;
+#define f32x4_load(p)       vld1q_f32(p)
+#define f32x4_store(p, a)   vst1q_f32((p), (a))
+#define f32x4_add(a, b)     vaddq_f32((a), (b))
+#define f32x4_sub(a, b)     vsubq_f32((a), (b))
+#define f32x4_mulk(k, a)    vmulq_n_f32((a), (k))
+#endif
+
+/* Same as InverseDCT1D, but transforms 4 vectors at once. Element j of the
+ * vectors is read from x[j * 8], element j of the results is written to
+ * dst[j * 8]. Operations are performed in the same order as the scalar
+ * version so that results are identical. */
+static void InverseDCT1D_x4(const float *x, float *dst)
+{
+    f32x4_t v[8];
+    f32x4_t e[4];
+    f32x4_t f[4];
+    f32x4_t x26, x1357, x15, x37, x17, x35;
+    unsigned int j;
+
+    for (j = 0; j < 8; ++j)
+        v[j] = f32x4_load(&x[j * 8]);
+
+    x15   = f32x4_mulk(IDCT_K[2], f32x4_add(v[1], v[5]));
+    x37   = f32x4_mulk(IDCT_K[3], f32x4_add(v[3], v[7]));
+    x17   = f32x4_mulk(IDCT_K[8], f32x4_add(v[1], v[7]));
+    x35   = f32x4_mulk(IDCT_K[9], f32x4_add(v[3], v[5]));
+    x1357 = f32x4_mulk(IDCT_C3,   f32x4_add(f32x4_add(f32x4_add(v[1], v[3]), v[5]), v[7]));
+    x26   = f32x4_mulk(IDCT_C6,   f32x4_add(v[2], v[6]));
+
+    f[0] = f32x4_add(v[0], v[4]);
+    f[1] = f32x4_sub(v[0], v[4]);
+    f[2] = f32x4_add(x26, f32x4_mulk(IDCT_K[0], v[2]));
+    f[3] = f32x4_add(x26, f32x4_mulk(IDCT_K[1], v[6]));
+
+    e[0] = f32x4_add(f32x4_add(f32x4_add(x1357, x15), f32x4_mulk(IDCT_K[4], v[1])), x17);
+    e[1] = f32x4_add(f32x4_add(f32x4_add(x1357, x37), f32x4_mulk(IDCT_K[6], v[3])), x35);
+    e[2] = f32x4_add(f32x4_add(f32x4_add(x1357, x15), f32x4_mulk(IDCT_K[5], v[5])), x35);
+    e[3] = f32x4_add(f32x4_add(f32x4_add(x1357, x37), f32x4_mulk(IDCT_K[7], v[7])), x17);
+
+    f32x4_store(&dst[0 * 8], f32x4_add(f32x4_add(f[0], f[2]), e[0]));
+    f32x4_store(&dst[1 * 8], f32x4_add(f32x4_add(f[1], f[3]), e[1]));
+    f32x4_store(&dst[2 * 8], f32x4_add(f32x4_sub(f[1], f[3]), e[2]));
+    f32x4_store(&dst[3 * 8], f32x4_add(f32x4_sub(f[0], f[2]), e[3]));
+    f32x4_store(&dst[4 * 8], f32x4_sub(f32x4_sub(f[0], f[2]), e[3]));
+    f32x4_store(&dst[5 * 8], f32x4_sub(f32x4_sub(f[1], f[3]), e[2]));
+    f32x4_store(&dst[6 * 8], f32x4_sub(f32x4_add(f[1], f[3]), e[1]));
+    f32x4_store(&dst[7 * 8], f32x4_sub(f32x4_add(f[0], f[2]), e[0]));
+}
+
+static void TransposeSubBlockF(float *dst, const float *src)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < 8; i += 4) {
+        for (j = 0; j < 8; j += 4) {
+#if defined(HLE_SSE2)
+            __m128 r0 = _mm_loadu_ps(&src[(i + 0) * 8 + j]);
+            __m128 r1 = _mm_loadu_ps(&src[(i + 1) * 8 + j]);
+            __m128 r2 = _mm_loadu_ps(&src[(i + 2) * 8 + j]);
+            __m128 r3 = _mm_loadu_ps(&src[(i + 3) * 8 + j]);
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(&dst[(j + 0) * 8 + i], r0);
+            _mm_storeu_ps(&dst[(j + 1) * 8 + i], r1);
+            _mm_storeu_ps(&dst[(j + 2) * 8 + i], r2);
+            _mm_storeu_ps(&dst[(j + 3) * 8 + i], r3);
+#elif defined(HLE_NEON)
+            const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(&src[(i + 0) * 8 + j]), vld1q_f32(&src[(i + 1) * 8 + j]));
+            const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(&src[(i + 2) * 8 + j]), vld1q_f32(&src[(i + 3) * 8 + j]));
+
+            vst1q_f32(&dst[(j + 0) * 8 + i], vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+            vst1q_f32(&dst[(j + 1) * 8 + i], vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+            vst1q_f32(&dst[(j + 2) * 8 + i], vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+            vst1q_f32(&dst[(j + 3) * 8 + i], vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#endif
+        }
+    }
+}
+
+static void InverseDCTSubBlock(int16_t *dst, const int16_t *src)
+{
+    float block[SUBBLOCK_SIZE];
+    float tmp[SUBBLOCK_SIZE];
+    unsigned int i;
+
+    for (i = 0; i < SUBBLOCK_SIZE; ++i)
+        block[i] = (float)src[i];
+
+    /* idct 1d on rows (+transposition), 4 rows at a time */
+    TransposeSubBlockF(tmp, block);
+    InverseDCT1D_x4(&tmp[0], &block[0]);
+    InverseDCT1D_x4(&tmp[4], &block[4]);
+
+    /* idct 1d on columns (thanks to previous transposition) */
+    TransposeSubBlockF(tmp, block);
+    InverseDCT1D_x4(&tmp[0], &block[0]);
+    InverseDCT1D_x4(&tmp[4], &block[4]);
+
+    /* C4 = 1 normalization implies a division by 8 */
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+#if defined(HLE_SSE2)
+        const __m128i lo = _mm_cvttps_epi32(_mm_loadu_ps(&block[i + 0]));
+        const __m128i hi = _mm_cvttps_epi32(_mm_loadu_ps(&block[i + 4]));
+
+        /* truncate to 16 bits before the shift */
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_packs_epi32(
+                    _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16 + 3),
+                    _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16 + 3)));
+#elif defined(HLE_NEON)
+        const int16x4_t lo = vmovn_s32(vcvtq_s32_f32(vld1q_f32(&block[i + 0])));
+        const int16x4_t hi = vmovn_s32(vcvtq_s32_f32(vld1q_f32(&block[i + 4])));
+
+        vst1q_s16(&dst[i], vshrq_n_s16(vcombine_s16(lo, hi), 3));
+#endif
+    }
+}
+#else
 static void InverseDCT1D(const float *const x, float *dst, unsigned int stride)
 {
     float e[4];
@@ -578,20 +737,61 @@ static void InverseDCTSubBlock(int16_t *dst, const int16_t *src)
             dst[i + j * 8] = (int16_t)x[j] >> 3;
     }
 }
+#endif
 
 static void RescaleYSubBlock(int16_t *dst, const int16_t *src)
 {
     unsigned int i;
 
+#if defined(HLE_SSE2)
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+
+        x = _mm_min_epi16(_mm_max_epi16(x, _mm_set1_epi16(-0x800)), _mm_set1_epi16(0x7f0));
+        x = _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(0x800)), _mm_set1_epi16(0xdb0));
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_add_epi16(x, _mm_set1_epi16(0x10)));
+    }
+#elif defined(HLE_NEON)
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        int16x8_t x = vld1q_s16(&src[i]);
+        uint16x8_t u;
+
+        x = vminq_s16(vmaxq_s16(x, vdupq_n_s16(-0x800)), vdupq_n_s16(0x7f0));
+        u = vreinterpretq_u16_s16(vaddq_s16(x, vdupq_n_s16(0x800)));
+        u = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(u), 0xdb0), 16),
+                         vshrn_n_u32(vmull_n_u16(vget_high_u16(u), 0xdb0), 16));
+        vst1q_s16(&dst[i], vaddq_s16(vreinterpretq_s16_u16(u), vdupq_n_s16(0x10)));
+    }
+#else
     for (i = 0; i < SUBBLOCK_SIZE; ++i)
         dst[i] = (((uint32_t)(clamp_s12(src[i]) + 0x800) * 0xdb0) >> 16) + 0x10;
+#endif
 }
 
 static void RescaleUVSubBlock(int16_t *dst, const int16_t *src)
 {
     unsigned int i;
 
+#if defined(HLE_SSE2)
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+
+        x = _mm_min_epi16(_mm_max_epi16(x, _mm_set1_epi16(-0x800)), _mm_set1_epi16(0x7f0));
+        x = _mm_mulhi_epi16(x, _mm_set1_epi16(0xe00));
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_add_epi16(x, _mm_set1_epi16(0x80)));
+    }
+#elif defined(HLE_NEON)
+    for (i = 0; i < SUBBLOCK_SIZE; i += 8) {
+        int16x8_t x = vld1q_s16(&src[i]);
+
+        x = vminq_s16(vmaxq_s16(x, vdupq_n_s16(-0x800)), vdupq_n_s16(0x7f0));
+        x = vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(x), 0xe00), 16),
+                         vshrn_n_s32(vmull_n_s16(vget_high_s16(x), 0xe00), 16));
+        vst1q_s16(&dst[i], vaddq_s16(x, vdupq_n_s16(0x80)));
+    }
+#else
     for (i = 0; i < SUBBLOCK_SIZE; ++i)
         dst[i] = (((int)clamp_s12(src[i]) * 0xe00) >> 16) + 0x80;
+#endif
 }
 
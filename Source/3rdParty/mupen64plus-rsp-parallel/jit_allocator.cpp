@@ -71,6 +71,24 @@ bool Allocator::commit_code(void *code, size_t size)
 void *Allocator::allocate_code(size_t size)
 {
 	size = align_page(size);
+
+	for (auto itr = free_ranges.begin(); itr != free_ranges.end(); ++itr)
+	{
+		if (itr->size < size)
+			continue;
+
+		void *ret = itr->code;
+		itr->code += size;
+		itr->size -= size;
+		if (!itr->size)
+			free_ranges.erase(itr);
+
+		if (!commit_read_write(ret, size))
+			return nullptr;
+		code_size += size;
+		return ret;
+	}
+
 	if (blocks.empty())
 		blocks.push_back(reserve_block(std::max(size, block_size)));
 
@@ -98,9 +116,38 @@ void *Allocator::allocate_code(size_t size)
 
 	if (!commit_read_write(ret, size))
 		return nullptr;
+	code_size += size;
 	return ret;
 }
 
+void Allocator::free_code(void *code, size_t size)
+{
+	Range range = { static_cast<uint8_t *>(code), align_page(size) };
+	code_size -= range.size;
+
+	auto itr = std::lower_bound(free_ranges.begin(), free_ranges.end(), range,
+	                            [](const Range &a, const Range &b) { return a.code < b.code; });
+	itr = free_ranges.insert(itr, range);
+
+	// Merge with the following and preceding ranges to keep large allocations possible.
+	auto next = itr + 1;
+	if (next != free_ranges.end() && itr->code + itr->size == next->code)
+	{
+		itr->size += next->size;
+		itr = free_ranges.erase(next) - 1;
+	}
+
+	if (itr != free_ranges.begin())
+	{
+		auto prev = itr - 1;
+		if (prev->code + prev->size == itr->code)
+		{
+			prev->size += itr->size;
+			free_ranges.erase(itr);
+		}
+	}
+}
+
 Allocator::Block Allocator::reserve_block(size_t size)
 {
 	Block block;
@@ -18,6 +18,15 @@ public:
 	void *allocate_code(size_t size);
 	static bool commit_code(void *code, size_t size);
 
+	// Returns code to the allocator, size must match what was passed to allocate_code().
+	void free_code(void *code, size_t size);
+
+	// Number of bytes currently handed out for code.
+	size_t get_code_size() const
+	{
+		return code_size;
+	}
+
 private:
 	struct Block
 	{
@@ -27,6 +36,15 @@ private:
 	};
 	std::vector<Block> blocks;
 
+	// Freed page ranges, sorted by address, which are reused before the blocks grow.
+	struct Range
+	{
+		uint8_t *code;
+		size_t size;
+	};
+	std::vector<Range> free_ranges;
+	size_t code_size = 0;
+
 	static Block reserve_block(size_t size);
 };
 }
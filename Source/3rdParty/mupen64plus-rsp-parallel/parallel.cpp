@@ -22,6 +22,9 @@ RSP::JIT::CPU cpu;
 #endif
 short MFC0_count[32];
 int SP_STATUS_TIMEOUT;
+
+static void (*debug_callback)(void *, int, const char *);
+static void *debug_context;
 } // namespace RSP
 
 extern "C"
@@ -123,6 +126,24 @@ extern "C"
 	EXPORT void CALL RomClosed(void)
 	{
 		*RSP::rsp.SP_PC_REG = 0x00000000;
+
+#ifndef DEBUG_JIT
+		if (RSP::debug_callback)
+		{
+			auto &stats = RSP::cpu.get_stats();
+			uint64_t lookups = stats.ucode_hits + stats.ucode_misses;
+			char msg[256];
+
+			snprintf(msg, sizeof(msg),
+			         "JIT: %.1f%% microcode cache hits (%llu switches, %llu evicted), "
+			         "%llu regions compiled in %.1f ms, %llu shared, %.1f MiB of code",
+			         lookups ? 100.0 * stats.ucode_hits / lookups : 0.0, (unsigned long long)lookups,
+			         (unsigned long long)stats.ucode_evictions, (unsigned long long)stats.regions_compiled,
+			         stats.compile_time * 1000.0, (unsigned long long)stats.regions_shared,
+			         RSP::cpu.get_code_size() / (1024.0 * 1024.0));
+			RSP::debug_callback(RSP::debug_context, M64MSG_INFO, msg);
+		}
+#endif
 	}
 
 	EXPORT void CALL InitiateRSP(RSP_INFO Rsp_Info, unsigned int *CycleCount)
@@ -168,6 +189,8 @@ extern "C"
 	EXPORT m64p_error CALL PluginStartup(m64p_dynlib_handle CoreLibHandle, void *Context,
 									 void (*DebugCallback)(void *, int, const char *))
 	{
+		RSP::debug_callback = DebugCallback;
+		RSP::debug_context = Context;
 		return M64ERR_SUCCESS;
 	}
 
@@ -1,5 +1,6 @@
 #include "rsp_jit.hpp"
 #include "rsp_disasm.hpp"
+#include <chrono>
 #include <utility>
 #include <assert.h>
 
@@ -19,6 +20,12 @@ using namespace std;
 
 #define JIT_FRAME_SIZE 256
 
+// Once compiled code grows past this, least recently used microcodes are evicted.
+#define JIT_CODE_BUDGET (64 * 1024 * 1024)
+// Compiled code can be shared between microcodes, so their count is capped as well,
+// every one of them keeps a copy of IMEM and its block table.
+#define JIT_MICROCODE_LIMIT 256
+
 #if __WORDSIZE == 32
 #undef jit_ldxr_ui
 #define jit_ldxr_ui jit_ldxr_i
@@ -50,19 +57,72 @@ void CPU::invalidate_imem()
 
 void CPU::invalidate_code()
 {
-	if (!state.dirty_blocks)
+	if (!state.dirty_blocks && current_ucode)
 		return;
 
-	for (unsigned i = 0; i < CODE_BLOCKS; i++)
+	memcpy(cached_imem, state.imem, IMEM_SIZE);
+	state.dirty_blocks = 0;
+	select_microcode();
+}
+
+// IMEM changed, either by SP DMA or by the CPU, so fingerprint all of it and swap in
+// the block table of the microcode which is now loaded.
+void CPU::select_microcode()
+{
+	uint64_t fingerprint = hash_imem(0, IMEM_WORDS);
+	auto &ucode = microcodes[fingerprint];
+
+	if (ucode && memcmp(ucode->imem, state.imem, IMEM_SIZE) == 0)
+		stats.ucode_hits++;
+	else
+	{
+		stats.ucode_misses++;
+		ucode.reset(new Microcode);
+		memcpy(ucode->imem, state.imem, IMEM_SIZE);
+	}
+
+	ucode->last_use = ++ucode_timestamp;
+	current_ucode = ucode.get();
+	blocks = current_ucode->blocks;
+
+	evict_microcodes();
+}
+
+// We are never inside JIT code here, so code of evicted microcodes can be freed right away.
+void CPU::evict_microcodes()
+{
+	bool evicted = false;
+
+	while ((allocator.get_code_size() > JIT_CODE_BUDGET || microcodes.size() > JIT_MICROCODE_LIMIT) &&
+	       microcodes.size() > 1)
 	{
-		if (state.dirty_blocks & (1 << i))
+		auto oldest = microcodes.end();
+		for (auto itr = microcodes.begin(); itr != microcodes.end(); ++itr)
 		{
-			memset(blocks + i * CODE_BLOCK_WORDS, 0, CODE_BLOCK_WORDS * sizeof(blocks[0]));
-			memcpy(cached_imem + i * CODE_BLOCK_WORDS, state.imem + i * CODE_BLOCK_WORDS, CODE_BLOCK_SIZE);
+			if (itr->second.get() == current_ucode)
+				continue;
+			if (oldest == microcodes.end() || itr->second->last_use < oldest->second->last_use)
+				oldest = itr;
 		}
+
+		microcodes.erase(oldest);
+		stats.ucode_evictions++;
+		evicted = true;
 	}
 
-	state.dirty_blocks = 0;
+	if (!evicted)
+		return;
+
+	for (auto &regions : cached_regions)
+	{
+		for (auto itr = regions.begin(); itr != regions.end();)
+		{
+			if (itr->second.expired())
+				itr = regions.erase(itr);
+			else
+				++itr;
+		}
+	}
 }
 
 // Need super-fast hash here.
@@ -459,11 +519,21 @@ Func CPU::get_jit_block(uint32_t pc)
 		end = analyze_static_end(word_pc, end);
 
 		uint64_t hash = hash_imem(word_pc, end - word_pc);
-		auto &ptr = cached_blocks[word_pc][hash];
-		if (ptr)
-			block = ptr;
+		auto &cached = cached_regions[word_pc][hash];
+		auto region = cached.lock();
+		if (region)
+			stats.regions_shared++;
 		else
-			block = ptr = jit_region(hash, word_pc, end - word_pc);
+		{
+			auto start = chrono::steady_clock::now();
+			region = jit_region(hash, word_pc, end - word_pc);
+			stats.compile_time += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			stats.regions_compiled++;
+			cached = region;
+		}
+
+		current_ucode->regions.push_back(region);
+		block = region->func;
 	}
 	return block;
 }
@@ -1792,7 +1862,7 @@ void CPU::jit_handle_latent_delay_slot(jit_state_t *_jit, const InstructionInfo
 	}
 }
 
-Func CPU::jit_region(uint64_t hash, unsigned pc_word, unsigned instruction_count)
+shared_ptr<CPU::CodeRegion> CPU::jit_region(uint64_t hash, unsigned pc_word, unsigned instruction_count)
 {
 	regs.reset();
 
@@ -1901,7 +1971,8 @@ Func CPU::jit_region(uint64_t hash, unsigned pc_word, unsigned instruction_count
 		abort();
 	jit_set_code(block_code, code_size);
 
-	auto ret = reinterpret_cast<Func>(jit_emit());
+	auto ret = make_shared<CodeRegion>(allocator, block_code, code_size);
+	ret->func = reinterpret_cast<Func>(jit_emit());
 
 #ifdef TRACE_DISASM
 	printf(" === DISASM ===\n");
@@ -120,9 +120,29 @@ public:
 
 	Func get_jit_block(uint32_t pc);
 
+	struct Stats
+	{
+		uint64_t ucode_hits = 0;
+		uint64_t ucode_misses = 0;
+		uint64_t ucode_evictions = 0;
+		uint64_t regions_compiled = 0;
+		uint64_t regions_shared = 0;
+		double compile_time = 0.0;
+	};
+
+	const Stats &get_stats() const
+	{
+		return stats;
+	}
+
+	size_t get_code_size() const
+	{
+		return allocator.get_code_size();
+	}
+
 private:
 	CPUState state;
-	Func blocks[IMEM_WORDS] = {};
+	Func *blocks = nullptr;
 
 	void invalidate_code();
 
@@ -130,9 +150,40 @@ private:
 
 	alignas(64) uint32_t cached_imem[IMEM_WORDS] = {};
 
-	std::unordered_map<uint64_t, Func> cached_blocks[IMEM_WORDS];
+	// Compiled code for a region of IMEM. Regions are shared by every microcode which
+	// has the same instructions there, and are freed with the last microcode using them.
+	struct CodeRegion
+	{
+		CodeRegion(Allocator &allocator_, void *code_, size_t size_)
+		    : allocator(allocator_), code(code_), size(size_)
+		{
+		}
+
+		~CodeRegion()
+		{
+			allocator.free_code(code, size);
+		}
+
+		Allocator &allocator;
+		void *code;
+		size_t size;
+		Func func = nullptr;
+	};
+
+	// Everything compiled for one IMEM image. Switching between microcodes only swaps
+	// in a different block table, rather than hashing every region again.
+	struct Microcode
+	{
+		uint32_t imem[IMEM_WORDS];
+		Func blocks[IMEM_WORDS] = {};
+		std::vector<std::shared_ptr<CodeRegion>> regions;
+		uint64_t last_use = 0;
+	};
 
-	Func jit_region(uint64_t hash, unsigned pc_word, unsigned instruction_count);
+	void select_microcode();
+	void evict_microcodes();
+
+	std::shared_ptr<CodeRegion> jit_region(uint64_t hash, unsigned pc_word, unsigned instruction_count);
 
 	int enter(uint32_t pc);
 
@@ -198,6 +249,13 @@ private:
 
 	RegisterCache regs;
 	Allocator allocator;
+
+	// Must be destroyed before the allocator they return code to.
+	std::unordered_map<uint64_t, std::unique_ptr<Microcode>> microcodes;
+	std::unordered_map<uint64_t, std::weak_ptr<CodeRegion>> cached_regions[IMEM_WORDS];
+	Microcode *current_ucode = nullptr;
+	uint64_t ucode_timestamp = 0;
+	Stats stats;
 };
 } // namespace JIT
 } // namespace RSP
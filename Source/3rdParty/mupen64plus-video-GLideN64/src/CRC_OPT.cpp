@@ -1,3 +1,4 @@
+#include <memory.h>
 #include "CRC.h"
 #define XXH_INLINE_ALL
 #include "xxHash/xxhash.h"
@@ -53,10 +54,18 @@ u64 CRC_Calculate( u64 crc, const void * buffer, u32 count )
 
 u64 CRC_CalculatePalette( u64 crc, const void * buffer, u32 count )
 {
-	u8 *p = (u8*) buffer;
-	while (count--) {
-		crc = XXH3_64bits_withSeed(p, 2, crc);
-		p += 8;
+	// Palette entries are the first 2 bytes of every TMEM qword.
+	// Gather them and hash them at once instead of one XXH3 call per entry.
+	u16 entries[256];
+	const u8 *p = (const u8*) buffer;
+	while (count != 0) {
+		const u32 num = count < 256 ? count : 256;
+		for (u32 i = 0; i < num; ++i) {
+			memcpy(&entries[i], p, 2);
+			p += 8;
+		}
+		crc = XXH3_64bits_withSeed(entries, num * 2, crc);
+		count -= num;
 	}
 	return crc;
 }
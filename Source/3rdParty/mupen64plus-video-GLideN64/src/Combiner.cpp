@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <cstring>
@@ -8,6 +9,7 @@
 #include "DebugDump.h"
 #include "gDP.h"
 #include "Config.h"
+#include "Log.h"
 #include "PluginAPI.h"
 #include "RSP.h"
 #include "Graphics/Context.h"
@@ -129,6 +131,14 @@ void CombinerInfo::destroy()
 	if (config.generalEmulation.enableShadersStorage != 0)
 		_saveShadersStorage();
 	m_shadersLoaded = 0;
+	if (m_compileStats.queued != 0)
+		_logCompileStats();
+	m_warmupPending = false;
+	m_compileQueue.clear();
+	m_compileStats = AsyncCompileStats();
+	for (auto cur = m_uberCombiners.begin(); cur != m_uberCombiners.end(); ++cur)
+		delete cur->second;
+	m_uberCombiners.clear();
 	for (auto cur = m_combiners.begin(); cur != m_combiners.end(); ++cur)
 		delete cur->second;
 	m_combiners.clear();
@@ -194,24 +204,13 @@ void SimplifyCycle( CombineCycle *cc, CombinerStage *stage )
 	}
 }
 
-graphics::CombinerProgram * Combiner_Compile(CombinerKey key)
+void Combiner_Expand(u64 _mux, u32 _cycleType, CombineCycle _cc[2], CombineCycle _ac[2])
 {
 	gDPCombine combine;
 
-	combine.mux = key.getMux();
-
-	Combiner color, alpha;
-
-	const u32 cycleType = key.getCycleType();
-	const u32 numCycles = cycleType + 1;
-	color.numStages = numCycles;
-	alpha.numStages = numCycles;
-
-	CombineCycle cc[2];
-	CombineCycle ac[2];
+	combine.mux = _mux;
 
-	// Simplify each RDP combiner cycle into a combiner stage
-	if (cycleType == G_CYC_1CYCLE) {
+	if (_cycleType == G_CYC_1CYCLE) {
 		// 1 cycle mode uses combiner equations from 2nd cycle
 		u32 colorMux[4] = { saRGBExpanded[combine.saRGB1], sbRGBExpanded[combine.sbRGB1],
 							mRGBExpanded[combine.mRGB1], aRGBExpanded[combine.aRGB1] };
@@ -220,11 +219,10 @@ graphics::CombinerProgram * Combiner_Compile(CombinerKey key)
 			if (colorMux[i] == G_GCI_COMBINED || colorMux[i] == G_GCI_COMBINED_ALPHA)
 				colorMux[i] = G_GCI_ZERO;
 		}
-		cc[1].sa = colorMux[0];
-		cc[1].sb = colorMux[1];
-		cc[1].m = colorMux[2];
-		cc[1].a = colorMux[3];
-		SimplifyCycle(&cc[1], &color.stage[0]);
+		_cc[1].sa = colorMux[0];
+		_cc[1].sb = colorMux[1];
+		_cc[1].m = colorMux[2];
+		_cc[1].a = colorMux[3];
 
 		u32 alphaMux[4] = { saAExpanded[combine.saA1], sbAExpanded[combine.sbA1],
 			mAExpanded[combine.mA1], aAExpanded[combine.aA1] };
@@ -233,31 +231,51 @@ graphics::CombinerProgram * Combiner_Compile(CombinerKey key)
 			if (alphaMux[i] == G_GCI_COMBINED)
 				alphaMux[i] = G_GCI_ZERO;
 		}
-		ac[1].sa = alphaMux[0];
-		ac[1].sb = alphaMux[1];
-		ac[1].m = alphaMux[2];
-		ac[1].a = alphaMux[3];
+		_ac[1].sa = alphaMux[0];
+		_ac[1].sb = alphaMux[1];
+		_ac[1].m = alphaMux[2];
+		_ac[1].a = alphaMux[3];
+		return;
+	}
+
+	// Decode and expand the combine mode into a more general form
+	_cc[1].sa = saRGBExpanded[combine.saRGB1];
+	_cc[1].sb = sbRGBExpanded[combine.sbRGB1];
+	_cc[1].m = mRGBExpanded[combine.mRGB1];
+	_cc[1].a = aRGBExpanded[combine.aRGB1];
+	_ac[1].sa = saAExpanded[combine.saA1];
+	_ac[1].sb = sbAExpanded[combine.sbA1];
+	_ac[1].m = mAExpanded[combine.mA1];
+	_ac[1].a = aAExpanded[combine.aA1];
+
+	_cc[0].sa = saRGBExpanded[combine.saRGB0];
+	_cc[0].sb = sbRGBExpanded[combine.sbRGB0];
+	_cc[0].m = mRGBExpanded[combine.mRGB0];
+	_cc[0].a = aRGBExpanded[combine.aRGB0];
+	_ac[0].sa = saAExpanded[combine.saA0];
+	_ac[0].sb = sbAExpanded[combine.sbA0];
+	_ac[0].m = mAExpanded[combine.mA0];
+	_ac[0].a = aAExpanded[combine.aA0];
+}
+
+graphics::CombinerProgram * Combiner_Compile(CombinerKey key)
+{
+	Combiner color, alpha;
+
+	const u32 cycleType = key.getCycleType();
+	const u32 numCycles = cycleType + 1;
+	color.numStages = numCycles;
+	alpha.numStages = numCycles;
+
+	CombineCycle cc[2];
+	CombineCycle ac[2];
+	Combiner_Expand(key.getMux(), cycleType, cc, ac);
+
+	// Simplify each RDP combiner cycle into a combiner stage
+	if (cycleType == G_CYC_1CYCLE) {
+		SimplifyCycle(&cc[1], &color.stage[0]);
 		SimplifyCycle(&ac[1], &alpha.stage[0]);
 	} else {
-		// Decode and expand the combine mode into a more general form
-		cc[1].sa = saRGBExpanded[combine.saRGB1];
-		cc[1].sb = sbRGBExpanded[combine.sbRGB1];
-		cc[1].m = mRGBExpanded[combine.mRGB1];
-		cc[1].a = aRGBExpanded[combine.aRGB1];
-		ac[1].sa = saAExpanded[combine.saA1];
-		ac[1].sb = sbAExpanded[combine.sbA1];
-		ac[1].m = mAExpanded[combine.mA1];
-		ac[1].a = aAExpanded[combine.aA1];
-
-		cc[0].sa = saRGBExpanded[combine.saRGB0];
-		cc[0].sb = sbRGBExpanded[combine.sbRGB0];
-		cc[0].m = mRGBExpanded[combine.mRGB0];
-		cc[0].a = aRGBExpanded[combine.aRGB0];
-		ac[0].sa = saAExpanded[combine.saA0];
-		ac[0].sb = sbAExpanded[combine.sbA0];
-		ac[0].m = mAExpanded[combine.mA0];
-		ac[0].a = aAExpanded[combine.aA0];
-
 		SimplifyCycle(&cc[0], &color.stage[0]);
 		SimplifyCycle(&ac[0], &alpha.stage[0]);
 
@@ -295,17 +313,83 @@ void CombinerInfo::setCombine(u64 _mux )
 		m_bChanged = false;
 		return;
 	}
+	if (!m_compileQueue.empty())
+		_updateCompileQueue();
 	auto iter = m_combiners.find(key);
 	if (iter != m_combiners.end()) {
 		m_pCurrent = iter->second;
 	} else {
 		m_pCurrent = Combiner_Compile(key);
-		m_pCurrent->update(true);
 		m_combiners[m_pCurrent->getKey()] = m_pCurrent;
+		if (m_pCurrent->isReady(false)) {
+			m_pCurrent->update(true);
+		} else {
+			m_compileQueue.push_back(m_pCurrent);
+			++m_compileStats.queued;
+			m_compileStats.queuePeak = std::max(m_compileStats.queuePeak, static_cast<u32>(m_compileQueue.size()));
+		}
+	}
+	if (!m_pCurrent->isReady(false)) {
+		// Draw with the ubershader until the driver has linked the program.
+		graphics::CombinerProgram * uberCombiner = _getUberCombiner(key);
+		if (uberCombiner != nullptr) {
+			m_pCurrent = uberCombiner;
+			++m_compileStats.fallbacks;
+		} else {
+			// No ubershader for copy and fill modes, update() waits for the link.
+			++m_compileStats.stalls;
+		}
 	}
 	m_bChanged = true;
 }
 
+graphics::CombinerProgram * CombinerInfo::_getUberCombiner(const CombinerKey & _key)
+{
+	const u32 cycleType = _key.getCycleType();
+	if (cycleType != G_CYC_1CYCLE && cycleType != G_CYC_2CYCLE)
+		return nullptr;
+
+	const CombinerKey uberKey = _key.getUberKey();
+	auto iter = m_uberCombiners.find(uberKey);
+	if (iter != m_uberCombiners.end())
+		return iter->second;
+
+	// Ubershaders are built synchronously, but there is only one per combiner mode.
+	graphics::CombinerProgram * uberCombiner = Combiner_Compile(uberKey);
+	uberCombiner->update(true);
+	m_uberCombiners[uberKey] = uberCombiner;
+	++m_compileStats.stalls;
+	return uberCombiner;
+}
+
+void CombinerInfo::_updateCompileQueue()
+{
+	auto ready = std::remove_if(m_compileQueue.begin(), m_compileQueue.end(),
+		[](graphics::CombinerProgram * _program) { return _program->isReady(false); });
+	m_compileQueue.erase(ready, m_compileQueue.end());
+	if (!m_compileQueue.empty())
+		return;
+
+	if (m_warmupPending) {
+		m_warmupPending = false;
+		const auto elapsed = std::chrono::steady_clock::now() - m_warmupStart;
+		LOG_INFO("Shader warmup: %u combiners ready after %u ms",
+			static_cast<u32>(m_combiners.size()),
+			static_cast<u32>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+	}
+	_logCompileStats();
+}
+
+void CombinerInfo::_logCompileStats() const
+{
+	LOG_INFO("Async shaders: %u compiled in background, %u pending, peak queue depth %u, %u ubershader fallbacks, %u render thread stalls",
+		m_compileStats.queued - static_cast<u32>(m_compileQueue.size()),
+		static_cast<u32>(m_compileQueue.size()),
+		m_compileStats.queuePeak,
+		m_compileStats.fallbacks,
+		m_compileStats.stalls);
+}
+
 void CombinerInfo::updateParameters()
 {
 	m_pCurrent->update(false);
@@ -367,10 +451,31 @@ void CombinerInfo::_saveShadersStorage() const
 
 bool CombinerInfo::_loadShadersStorage()
 {
-	if (gfxContext.loadShadersStorage(m_combiners)) {
-		m_shadersLoaded = static_cast<u32>(m_combiners.size());
+	const auto start = std::chrono::steady_clock::now();
+	if (!gfxContext.loadShadersStorage(m_combiners))
+		return false;
+
+	m_shadersLoaded = static_cast<u32>(m_combiners.size());
+	for (auto cur = m_combiners.begin(); cur != m_combiners.end(); ++cur) {
+		if (!cur->second->isReady(false))
+			m_compileQueue.push_back(cur->second);
+	}
+
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	const u32 elapsedMs = static_cast<u32>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+	if (m_compileQueue.empty()) {
+		LOG_INFO("Shader warmup: %u combiners ready after %u ms", m_shadersLoaded, elapsedMs);
 		return true;
 	}
 
-	return false;
+	// Programs are still linking on driver threads. Binaries can be written only after that, so save on destroy.
+	const u32 pending = static_cast<u32>(m_compileQueue.size());
+	LOG_INFO("Shader warmup: %u of %u combiners compiling in background, load took %u ms",
+		pending, m_shadersLoaded, elapsedMs);
+	m_shadersLoaded = 0;
+	m_warmupPending = true;
+	m_warmupStart = start;
+	m_compileStats.queued += pending;
+	m_compileStats.queuePeak = std::max(m_compileStats.queuePeak, pending);
+	return true;
 }
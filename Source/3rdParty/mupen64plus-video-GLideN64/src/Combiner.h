@@ -1,8 +1,10 @@
 #ifndef COMBINER_H
 #define COMBINER_H
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "GLideN64.h"
 #include "GraphicsDrawer.h"
@@ -147,6 +149,7 @@ private:
 	CombinerInfo()
 		: m_bChanged(false)
 		, m_rectMode(true)
+		, m_warmupPending(false)
 		, m_shadersLoaded(0)
 		, m_configOptionsBitSet(0)
 		, m_pCurrent(nullptr) {}
@@ -154,14 +157,29 @@ private:
 
 	void _saveShadersStorage() const;
 	bool _loadShadersStorage();
+	graphics::CombinerProgram * _getUberCombiner(const CombinerKey & _key);
+	void _updateCompileQueue();
+	void _logCompileStats() const;
+
+	struct AsyncCompileStats {
+		u32 queued = 0;
+		u32 queuePeak = 0;
+		u32 fallbacks = 0;
+		u32 stalls = 0;
+	};
 
 	bool m_bChanged;
 	bool m_rectMode;
+	bool m_warmupPending;
 	u32 m_shadersLoaded;
 	u32 m_configOptionsBitSet;
 
 	graphics::CombinerProgram * m_pCurrent;
 	graphics::Combiners m_combiners;
+	graphics::Combiners m_uberCombiners;
+	std::vector<graphics::CombinerProgram *> m_compileQueue;
+	AsyncCompileStats m_compileStats;
+	std::chrono::steady_clock::time_point m_warmupStart;
 
 	std::unique_ptr<graphics::ShaderProgram> m_shadowmapProgram;
 	std::unique_ptr<graphics::ShaderProgram> m_texrectUpscaleCopyProgram;
@@ -178,6 +196,7 @@ graphics::CombinerProgram * currentCombiner() {
 void Combiner_Init();
 void Combiner_Destroy();
 graphics::CombinerProgram * Combiner_Compile(CombinerKey key);
+void Combiner_Expand(u64 _mux, u32 _cycleType, CombineCycle _cc[2], CombineCycle _ac[2]);
 
 #endif
 
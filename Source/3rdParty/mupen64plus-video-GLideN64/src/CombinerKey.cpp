@@ -16,6 +16,7 @@ CombinerKey::CombinerKey(u64 _mux, bool _setModeBits)
 	// [3 - 3] bi_lerp1
 	// [4 - 4] bi_lerp0
 	// [5 - 5] is HWL supported
+	// [6 - 6] ubershader, set by getUberKey() only
 	u32 flags = CombinerInfo::get().isRectMode() ? 1U : 0U;
 	const u32 cycleType = gDP.otherMode.cycleType;
 	const u32 bilerp = (gDP.otherMode.h >> 10) & 3;
@@ -72,6 +73,19 @@ bool CombinerKey::isHWLSupported() const
 	return ((m_key.muxs0 >> 29) & 1) != 0;
 }
 
+bool CombinerKey::isUberKey() const
+{
+	return ((m_key.muxs0 >> 30) & 1) != 0;
+}
+
+CombinerKey CombinerKey::getUberKey() const
+{
+	// Keep the mode bits, drop the combine mode: one ubershader serves all combiners of that mode.
+	CombinerKey key;
+	key.m_key.muxs0 = (m_key.muxs0 & 0x3F000000) | (1U << 30);
+	return key;
+}
+
 void CombinerKey::read(std::istream & _is)
 {
 	_is.read(reinterpret_cast<char*>(&m_key.mux), sizeof(m_key.mux));
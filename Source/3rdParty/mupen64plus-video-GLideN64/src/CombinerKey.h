@@ -20,6 +20,10 @@ public:
 
 	bool isHWLSupported() const;
 
+	bool isUberKey() const;
+
+	CombinerKey getUberKey() const;
+
 	u32 getCycleType() const;
 
 	u32 getBilerp() const;
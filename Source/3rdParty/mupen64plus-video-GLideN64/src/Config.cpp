@@ -51,6 +51,7 @@ void Config::resetToDefaults()
 	generalEmulation.enableClipping = 1;
 	generalEmulation.enableCustomSettings = 1;
 	generalEmulation.enableShadersStorage = 1;
+	generalEmulation.enableAsyncShaders = 0;
 	generalEmulation.enableLegacyBlending = 0;
 	generalEmulation.enableHybridFilter = 1;
 	generalEmulation.enableInaccurateTextureCoordinates = 0;
@@ -112,6 +113,7 @@ void Config::resetToDefaults()
 	textureFilter.txEnhancedTextureFileStorage = 0;
 	textureFilter.txHiresTextureFileStorage = 0;
 	textureFilter.txNoTextureFileStorage = 0;
+	textureFilter.txHiresAsyncLoad = 0;
 
 	textureFilter.txHiresVramLimit = 0u;
 
@@ -65,6 +65,7 @@ struct Config
 		u32 enableClipping;
 		u32 enableCustomSettings;
 		u32 enableShadersStorage;
+		u32 enableAsyncShaders;
 		u32 enableLegacyBlending;
 		u32 enableHybridFilter;
 		u32 enableInaccurateTextureCoordinates;
@@ -182,6 +183,7 @@ struct Config
 		u32 txEnhancedTextureFileStorage;	// Use file storage instead of memory cache for enhanced textures.
 		u32 txHiresTextureFileStorage;		// Use file storage instead of memory cache for hires textures.
 		u32 txNoTextureFileStorage;			// Use no file storage or cache for hires textures.
+		u32 txHiresAsyncLoad;				// Load hires textures in background. Used with txNoTextureFileStorage.
 
 		u32 txHiresVramLimit; // Limit of uploading hi-res textures to VRAM (in MB)
 
@@ -26,7 +26,6 @@
 #endif
 
 #include <functional>
-#include <thread>
 #include <stdlib.h>
 #include <assert.h>
 
@@ -35,20 +34,29 @@
 #include "TextureFilters.h"
 #include "TxDbg.h"
 
+/* textures smaller than this are filtered on the calling thread */
+#define MIN_THREADED_TEXELS (64 * 64)
+
 void TxFilter::clear()
 {
 	/* clear hires texture loader */
 	delete _txHiResLoader;
+	_txHiResLoader = nullptr;
 
 	/* clear texture cache */
 	delete _txTexCache;
+	_txTexCache = nullptr;
 
 	/* free memory */
 	TxMemBuf::getInstance()->shutdown();
 
 	/* clear other stuff */
+	delete _threadPool;
+	_threadPool = nullptr;
 	delete _txImage;
+	_txImage = nullptr;
 	delete _txQuantize;
+	_txQuantize = nullptr;
 }
 
 TxFilter::~TxFilter()
@@ -72,6 +80,7 @@ TxFilter::TxFilter(int maxwidth,
 	, _txTexCache(nullptr)
 	, _txHiResLoader(nullptr)
 	, _txImage(nullptr)
+	, _threadPool(nullptr)
 {
 	/* HACKALERT: the emulator misbehaves and sometimes forgets to shutdown */
 	if ((ident && wcscmp(ident, wst("DEFAULT")) != 0 && _ident.compare(ident) == 0) &&
@@ -102,6 +111,7 @@ TxFilter::TxFilter(int maxwidth,
 
 	/* get number of CPU cores. */
 	_numcore = TxUtil::getNumberofProcessors();
+	_threadPool = new TxThreadPool(_numcore);
 
 	_initialized = 0;
 
@@ -150,7 +160,7 @@ TxFilter::TxFilter(int maxwidth,
 		wcscpy(fullTexPackPath, texPackPath);
 		wcscat(fullTexPackPath, OSAL_DIR_SEPARATOR_STR);
 		wcscat(fullTexPackPath, _ident.c_str());
-		_txHiResLoader = new TxHiResNoCache(_maxwidth, _maxheight, _maxbpp, _options, texCachePath, texPackPath, fullTexPackPath, _ident.c_str(), callback);
+		_txHiResLoader = new TxHiResNoCache(_maxwidth, _maxheight, _maxbpp, _options, _cacheSize, texCachePath, texPackPath, fullTexPackPath, _ident.c_str(), callback);
 	} else {
 		_txHiResLoader = new TxHiResCache(_maxwidth, _maxheight, _maxbpp, _options, texCachePath, texPackPath, _ident.c_str(), callback);
 	}
@@ -315,34 +325,22 @@ TxFilter::filter(uint8 *src, int srcwidth, int srcheight, ColorFormat srcformat,
 					blkrow = (srcheight >> 2) / numcore;
 					numcore--;
 				}
-				if (blkrow > 0 && numcore > 1) {
-					std::thread *thrd[MAX_NUMCORE];
-					unsigned int i;
-					int blkheight = blkrow << 2;
-					unsigned int srcStride = (srcwidth * blkheight) << 2;
-					unsigned int destStride = srcStride * scale * scale;
-					for (i = 0; i < numcore - 1; i++) {
-						thrd[i] = new std::thread(std::bind(filter_8888,
-																(uint32*)_texture,
-																srcwidth,
-																blkheight,
-																(uint32*)_tmptex,
-																filter,
-																i));
-						_texture += srcStride;
-						_tmptex  += destStride;
-					}
-					thrd[i] = new std::thread(std::bind(filter_8888,
-															(uint32*)_texture,
-															srcwidth,
-															srcheight - blkheight * i,
-															(uint32*)_tmptex,
-															filter,
-															i));
-					for (i = 0; i < numcore; i++) {
-						thrd[i]->join();
-						delete thrd[i];
-					}
+				if (blkrow > 0 && numcore > 1 && srcwidth * srcheight >= MIN_THREADED_TEXELS) {
+					const int blkheight = blkrow << 2;
+					const unsigned int srcStride = (srcwidth * blkheight) << 2;
+					const unsigned int destStride = srcStride * scale * scale;
+					const int width = srcwidth;
+					const int height = srcheight;
+					const uint32 bandFilter = filter;
+					/* the last band takes the remaining rows */
+					_threadPool->run(numcore, [=](uint32 band) {
+						filter_8888((uint32*)(_texture + srcStride * band),
+									width,
+									band + 1 < numcore ? blkheight : height - blkheight * band,
+									(uint32*)(_tmptex + destStride * band),
+									bandFilter,
+									band);
+					});
 				} else {
 					filter_8888((uint32*)_texture, srcwidth, srcheight, (uint32*)_tmptex, filter, 0);
 				}
@@ -571,6 +569,21 @@ TxFilter::hirestex(uint64 g64crc, Checksum r_crc64, uint16 *palette, N64FormatSi
 	return 0;
 }
 
+boolean
+TxFilter::hirestexPending(Checksum r_crc64, N64FormatSize n64FmtSz)
+{
+#if HIRES_TEXTURE
+	/* same lookups as in hirestex */
+	if ((_options & HIRESTEXTURES_MASK) && r_crc64) {
+		return _txHiResLoader->pending(r_crc64, n64FmtSz) ||
+			_txHiResLoader->pending(r_crc64._palette, n64FmtSz) ||
+			_txHiResLoader->pending(r_crc64._texture, n64FmtSz);
+	}
+#endif
+
+	return 0;
+}
+
 uint64
 TxFilter::checksum64(uint8 *src, int width, int height, int size, int rowStride, uint8 *palette)
 {
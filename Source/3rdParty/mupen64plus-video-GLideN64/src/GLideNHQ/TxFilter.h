@@ -32,6 +32,7 @@
 #include "TxTexCache.h"
 #include "TxUtil.h"
 #include "TxImage.h"
+#include "TxThreadPool.h"
 
 class TxFilter
 {
@@ -51,6 +52,7 @@ private:
   TxTexCache *_txTexCache;
   TxHiResLoader *_txHiResLoader;
   TxImage *_txImage;
+  TxThreadPool *_threadPool;
   boolean _initialized;
   void clear();
 public:
@@ -77,6 +79,7 @@ public:
 				   uint16 *palette,
 				   N64FormatSize n64FmtSz,
 				   GHQTexInfo *info);
+  boolean hirestexPending(Checksum r_crc64, N64FormatSize n64FmtSz);
   uint64 checksum64(uint8 *src, int width, int height, int size, int rowStride, uint8 *palette);
   uint64 checksum64strong(uint8 *src, int width, int height, int size, int rowStride, uint8 *palette);
   boolean dmptx(uint8 *src, int width, int height, int rowStridePixel,
@@ -0,0 +1,240 @@
+/*
+ * GLideNHQ texture filter benchmark
+ *
+ * Runs the TextureFilters_* kernels over a corpus of dumped textures and
+ * reports their throughput, both inline and split into row bands on the
+ * TxThreadPool like TxFilter::filter() does.
+ *
+ * usage: GLideNHQBenchmark [texture.png ...]
+ *
+ * Without textures a synthetic corpus of typical N64 texture sizes is used.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <png.h>
+#include <GL/glcorearb.h>
+#include <Graphics/Parameters.h>
+
+#include "TextureFilters.h"
+#include "TxFilterExport.h"
+#include "TxThreadPool.h"
+#include "TxUtil.h"
+
+/* TxMemBuf lives in TxUtil, which refers to the texture formats
+ * the OpenGL backend defines, provide them without the backend */
+namespace graphics {
+	namespace colorFormat {
+		ColorFormatParam RED_GREEN_BLUE(GL_RGB);
+		ColorFormatParam RGBA(GL_RGBA);
+	}
+
+	namespace internalcolorFormat {
+		InternalColorFormatParam NOCOLOR(0U);
+		InternalColorFormatParam RGB8(GL_RGB8);
+		InternalColorFormatParam RGBA8(GL_RGBA8);
+		InternalColorFormatParam RGBA4(GL_RGBA4);
+		InternalColorFormatParam RGB5_A1(GL_RGB5_A1);
+		InternalColorFormatParam COLOR_INDEX8(0x80E5);
+	}
+
+	namespace datatype {
+		DatatypeParam UNSIGNED_BYTE(GL_UNSIGNED_BYTE);
+		DatatypeParam UNSIGNED_SHORT_5_6_5(GL_UNSIGNED_SHORT_5_6_5);
+		DatatypeParam UNSIGNED_SHORT_5_5_5_1(GL_UNSIGNED_SHORT_5_5_5_1);
+		DatatypeParam UNSIGNED_SHORT_4_4_4_4(GL_UNSIGNED_SHORT_4_4_4_4);
+	}
+}
+
+/* time every filter runs over the corpus */
+#define BENCHMARK_SECONDS 0.5
+
+struct Texture
+{
+	uint32 width;
+	uint32 height;
+	std::vector<uint32> texels;
+};
+
+struct Filter
+{
+	const char *name;
+	uint32 filter;
+	uint32 scale;
+};
+
+static const Filter filters[] = {
+	{ "2x",       X2_ENHANCEMENT,    2 },
+	{ "2xSaI",    X2SAI_ENHANCEMENT, 2 },
+	{ "hq2x",     HQ2X_ENHANCEMENT,  2 },
+	{ "hq2xS",    HQ2XS_ENHANCEMENT, 2 },
+	{ "lq2x",     LQ2X_ENHANCEMENT,  2 },
+	{ "lq2xS",    LQ2XS_ENHANCEMENT, 2 },
+	{ "hq4x",     HQ4X_ENHANCEMENT,  4 },
+	{ "xbrz2x",   BRZ2X_ENHANCEMENT, 2 },
+	{ "xbrz3x",   BRZ3X_ENHANCEMENT, 3 },
+	{ "xbrz4x",   BRZ4X_ENHANCEMENT, 4 },
+	{ "xbrz5x",   BRZ5X_ENHANCEMENT, 5 },
+	{ "xbrz6x",   BRZ6X_ENHANCEMENT, 6 },
+	{ "smooth1",  SMOOTH_FILTER_1,   1 },
+	{ "smooth2",  SMOOTH_FILTER_2,   1 },
+	{ "smooth3",  SMOOTH_FILTER_3,   1 },
+	{ "smooth4",  SMOOTH_FILTER_4,   1 },
+	{ "sharp1",   SHARP_FILTER_1,    1 },
+	{ "sharp2",   SHARP_FILTER_2,    1 },
+};
+
+static bool loadTexture(const char *file, Texture &texture)
+{
+	/* read straight into the ARGB8888 layout the filters expect */
+	png_image image;
+	memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+
+	if (!png_image_begin_read_from_file(&image, file))
+		return false;
+
+	image.format = PNG_FORMAT_BGRA;
+	texture.width = image.width;
+	texture.height = image.height;
+	texture.texels.resize(image.width * image.height);
+
+	if (!png_image_finish_read(&image, nullptr, texture.texels.data(), 0, nullptr)) {
+		png_image_free(&image);
+		return false;
+	}
+
+	return true;
+}
+
+static void generateCorpus(std::vector<Texture> &corpus)
+{
+	/* sizes commonly found in N64 games, with smooth
+	 * gradients, hard edges and noise to exercise the
+	 * different paths of the edge detecting filters */
+	static const uint32 sizes[][2] = {
+		{ 16, 16 }, { 32, 32 }, { 32, 64 }, { 64, 32 },
+		{ 64, 64 }, { 128, 32 }, { 128, 64 }, { 256, 256 },
+	};
+
+	uint32 seed = 0x12345678;
+	for (const auto &size : sizes) {
+		Texture texture;
+		texture.width = size[0];
+		texture.height = size[1];
+		texture.texels.resize(size[0] * size[1]);
+		for (uint32 y = 0; y < size[1]; ++y) {
+			for (uint32 x = 0; x < size[0]; ++x) {
+				seed = seed * 1103515245 + 12345;
+				uint32 gradient = (x * 255 / size[0]) | ((y * 255 / size[1]) << 8);
+				uint32 edge = ((x / 8 + y / 8) & 1) ? 0x00ff0000 : 0;
+				uint32 noise = (seed >> 16) & 0x0f0f0f;
+				texture.texels[y * size[0] + x] = 0xff000000 | ((gradient | edge) ^ noise);
+			}
+		}
+		corpus.push_back(std::move(texture));
+	}
+}
+
+static void filterTexture(TxThreadPool *pool, uint32 numcore, const Texture &texture, uint32 *dest, const Filter &filter)
+{
+	uint32 *src = const_cast<uint32*>(texture.texels.data());
+	const uint32 width = texture.width;
+	const uint32 height = texture.height;
+
+	/* same row bands as TxFilter::filter() */
+	unsigned int blkrow = 0;
+	while (numcore > 1 && blkrow == 0) {
+		blkrow = (height >> 2) / numcore;
+		numcore--;
+	}
+	if (pool == nullptr || blkrow == 0 || numcore <= 1 || width * height < 64 * 64) {
+		filter_8888(src, width, height, dest, filter.filter, 0);
+		return;
+	}
+
+	const uint32 blkheight = blkrow << 2;
+	const uint32 srcStride = width * blkheight;
+	const uint32 destStride = srcStride * filter.scale * filter.scale;
+	pool->run(numcore, [=](uint32 band) {
+		filter_8888(src + srcStride * band,
+					width,
+					band + 1 < numcore ? blkheight : height - blkheight * band,
+					dest + destStride * band,
+					filter.filter,
+					band);
+	});
+}
+
+static void benchmark(TxThreadPool *pool, uint32 numcore, const std::vector<Texture> &corpus, std::vector<uint32> &dest, const Filter &filter)
+{
+	using clock = std::chrono::steady_clock;
+
+	uint64_t textures = 0;
+	uint64_t texels = 0;
+	double elapsed = 0.0;
+	const auto start = clock::now();
+
+	do {
+		for (const Texture &texture : corpus) {
+			filterTexture(pool, numcore, texture, dest.data(), filter);
+			++textures;
+			texels += texture.width * texture.height;
+		}
+		elapsed = std::chrono::duration<double>(clock::now() - start).count();
+	} while (elapsed < BENCHMARK_SECONDS);
+
+	printf("%-8s %-8s %10.1f textures/s %10.2f Mtexels/s\n",
+		filter.name,
+		pool == nullptr ? "inline" : "pool",
+		textures / elapsed,
+		texels / elapsed / 1000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<Texture> corpus;
+	for (int i = 1; i < argc; ++i) {
+		Texture texture;
+		if (loadTexture(argv[i], texture))
+			corpus.push_back(std::move(texture));
+		else
+			fprintf(stderr, "skipping %s, not a PNG\n", argv[i]);
+	}
+
+	if (corpus.empty())
+		generateCorpus(corpus);
+
+	uint32 maxTexels = 0;
+	uint64_t corpusTexels = 0;
+	for (const Texture &texture : corpus) {
+		if (texture.width * texture.height > maxTexels)
+			maxTexels = texture.width * texture.height;
+		corpusTexels += texture.width * texture.height;
+	}
+
+	/* largest scale is 6x */
+	std::vector<uint32> dest(maxTexels * 36);
+
+	const uint32 numcore = TxUtil::getNumberofProcessors();
+	TxThreadPool pool(numcore);
+
+	printf("%u textures, %llu texels, %u threads\n",
+		(uint32)corpus.size(), (unsigned long long)corpusTexels, numcore);
+
+	for (const Filter &filter : filters) {
+		benchmark(nullptr, numcore, corpus, dest, filter);
+		benchmark(&pool, numcore, corpus, dest, filter);
+	}
+
+	return 0;
+}
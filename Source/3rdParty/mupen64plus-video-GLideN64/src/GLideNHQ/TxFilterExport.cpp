@@ -75,6 +75,15 @@ txfilter_hirestex(uint64 g64crc, Checksum r_crc64, uint16 *palette, N64FormatSiz
   return 0;
 }
 
+TAPI boolean TAPIENTRY
+txfilter_hirestex_pending(Checksum r_crc64, N64FormatSize n64FmtSz)
+{
+  if (txFilter)
+	return txFilter->hirestexPending(r_crc64, n64FmtSz);
+
+  return 0;
+}
+
 TAPI uint64 TAPIENTRY
 txfilter_checksum(uint8 *src, int width, int height, int size, int rowStride, uint8 *palette)
 {
@@ -77,6 +77,7 @@ typedef unsigned char boolean;
 #define BRZ6X_ENHANCEMENT   0x00000c00
 
 #define DEPOSTERIZE         0x00001000
+#define ASYNC_HIRESTEX      0x00002000 /* decode hires textures in background, FILE_NOTEXCACHE only */
 
 #define HIRESTEXTURES_MASK  0x000f0000
 #define NO_HIRESTEXTURES    0x00000000
@@ -222,6 +223,9 @@ txfilter_filter(uint8 *src, int srcwidth, int srcheight, uint16 srcformat,
 TAPI boolean TAPIENTRY
 txfilter_hirestex(uint64 g64crc, Checksum r_crc64, uint16 *palette, N64FormatSize n64FmtSz, GHQTexInfo *info);
 
+TAPI boolean TAPIENTRY
+txfilter_hirestex_pending(Checksum r_crc64, N64FormatSize n64FmtSz);
+
 TAPI uint64 TAPIENTRY
 txfilter_checksum(uint8 *src, int width, int height, int size, int rowStride, uint8 *palette);
 
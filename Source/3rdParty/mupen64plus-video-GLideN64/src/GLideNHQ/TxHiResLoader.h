@@ -50,6 +50,8 @@ public:
 	virtual bool empty() const = 0;
 	virtual bool add(Checksum checksum, GHQTexInfo *info, int dataSize = 0) = 0;
 	virtual bool get(Checksum checksum, N64FormatSize n64FmtSz, GHQTexInfo *info) = 0;
+	/* true while the texture is being decoded in background */
+	virtual bool pending(Checksum checksum, N64FormatSize n64FmtSz) { return false; }
 	virtual bool reload() = 0;
 	virtual void dump() = 0;
 };
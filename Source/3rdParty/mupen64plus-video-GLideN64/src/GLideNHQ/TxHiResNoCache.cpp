@@ -8,6 +8,7 @@ TxHiResNoCache::TxHiResNoCache(int maxwidth,
 			   int maxheight,
 			   int maxbpp,
 			   int options,
+			   int cachesize,
 			   const wchar_t *cachePath,
 			   const wchar_t *texPackPath,
 			   const wchar_t *fullTexPath,
@@ -17,6 +18,10 @@ TxHiResNoCache::TxHiResNoCache(int maxwidth,
 	, _fullTexPath(fullTexPath)
 	, _ident(ident)
 	, _callback(callback)
+	, _loadedSize(0)
+	, _cacheLimit(cachesize)
+	, _busy(0)
+	, _stop(false)
 {
 	/* store this for _createFileIndexInDir */
 	wcstombs(_identc, _ident.c_str(), MAX_PATH);
@@ -25,22 +30,43 @@ TxHiResNoCache::TxHiResNoCache(int maxwidth,
 	CORRECTFILENAME(_identc);
 
 	_createFileIndex(false);
+
+	if (_options & ASYNC_HIRESTEX) {
+		/* leave some cores for the emulation itself */
+		uint32 numWorkers = TxUtil::getNumberofProcessors() / 2;
+		if (numWorkers == 0)
+			numWorkers = 1;
+		for (uint32 i = 0; i < numWorkers; i++)
+			_workers.emplace_back(&TxHiResNoCache::_worker, this);
+	}
 }
 
 TxHiResNoCache::~TxHiResNoCache()
 {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_queueCond.notify_all();
+	for (auto &thrd : _workers)
+		thrd.join();
+
 	_clear();
 }
 
 void TxHiResNoCache::_clear()
 {
+	_cancelLoads();
+
 	/* free loaded textures */
-	for (auto texMap : _loadedTex) {
-		free(texMap.second.data);
+	for (auto &loaded : _loadedList) {
+		free(loaded.info.data);
 	}
 
 	/* clear all lists */
+	_loadedList.clear();
 	_loadedTex.clear();
+	_loadedSize = 0;
 	_filesIndex.clear();
 }
 
@@ -59,6 +85,113 @@ TxHiResNoCache::FileIndexMap::const_iterator TxHiResNoCache::findFile(Checksum c
 	return _filesIndex.end();
 }
 
+bool TxHiResNoCache::_loadTex(const FileIndexEntry & indexEntry, Checksum checksum, N64FormatSize n64FmtSz, LoadedTex & loaded) const
+{
+	uint32 chksum = checksum._texture;
+	uint32 palchksum = checksum._palette;
+
+	DBG_INFO(80, wst("TxNoCache::get: loading chksum:%08X %08X\n"), chksum, palchksum);
+
+	/* load texture */
+	FileIndexEntry entry = indexEntry;
+	int width = 0, height = 0;
+	ColorFormat format;
+	uint8_t* tex = TxHiResLoader::loadFileInfoTex(entry.fullfname, entry.fname, entry.siz, &width, &height, entry.fmt, &format);
+
+	if (tex == nullptr) {
+		/* failed to load texture, so return false */
+		DBG_INFO(80, wst("TxNoCache::get: failed to load chksum:%08X %08X\n"), chksum, palchksum);
+		return false;
+	}
+
+	DBG_INFO(80, wst("TxNoCache::get: loaded chksum:%08X %08X\n"), chksum, palchksum);
+
+	loaded.checksum = checksum;
+	loaded.info.data = tex;
+	loaded.info.width = width;
+	loaded.info.height = height;
+	loaded.info.is_hires_tex = 1;
+	loaded.info.n64_format_size = n64FmtSz;
+	setTextureFormat(format, &loaded.info);
+	loaded.size = TxUtil::sizeofTx(width, height, format);
+	return true;
+}
+
+void TxHiResNoCache::_addLoadedTex(const LoadedTex & loaded)
+{
+	_loadedList.push_front(loaded);
+	_loadedTex.insert(std::make_pair(loaded.checksum, _loadedList.begin()));
+	_loadedSize += loaded.size;
+
+	/* drop least recently used textures, they are loaded again when needed */
+	while (_cacheLimit != 0 && _loadedSize > _cacheLimit && _loadedList.size() > 1) {
+		LoadedTex & oldest = _loadedList.back();
+		auto range = _loadedTex.equal_range(oldest.checksum);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (&(*it->second) == &oldest) {
+				_loadedTex.erase(it);
+				break;
+			}
+		}
+		DBG_INFO(80, wst("TxNoCache::get: evicted chksum:%08X %08X\n"), (uint32)(oldest.checksum & 0xffffffff), (uint32)(oldest.checksum >> 32));
+		_loadedSize -= oldest.size;
+		free(oldest.info.data);
+		_loadedList.pop_back();
+	}
+}
+
+void TxHiResNoCache::_worker()
+{
+	while (true) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_queueCond.wait(lock, [this]{ return _stop || !_queue.empty(); });
+		if (_stop)
+			return;
+		LoadRequest request = _queue.front();
+		_queue.pop_front();
+		_busy++;
+		lock.unlock();
+
+		LoadedTex loaded;
+		const bool res = _loadTex(request.entry->second, request.checksum, request.n64FmtSz, loaded);
+
+		lock.lock();
+		if (res)
+			_decoded.push_back(loaded);
+		else
+			_pending.erase(PendingKey(request.checksum, request.n64FmtSz.formatsize()));
+		_busy--;
+		_idleCond.notify_all();
+	}
+}
+
+void TxHiResNoCache::_collectDecoded()
+{
+	std::vector<LoadedTex> decoded;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_decoded.empty())
+			return;
+		decoded.swap(_decoded);
+		for (const auto &loaded : decoded)
+			_pending.erase(PendingKey(loaded.checksum, loaded.info.n64_format_size.formatsize()));
+	}
+
+	for (const auto &loaded : decoded)
+		_addLoadedTex(loaded);
+}
+
+void TxHiResNoCache::_cancelLoads()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_queue.clear();
+	_idleCond.wait(lock, [this]{ return _busy == 0; });
+	for (auto &loaded : _decoded)
+		free(loaded.info.data);
+	_decoded.clear();
+	_pending.clear();
+}
+
 bool TxHiResNoCache::get(Checksum checksum, N64FormatSize n64FmtSz, GHQTexInfo *info)
 {
 	if (!checksum)
@@ -74,54 +207,50 @@ bool TxHiResNoCache::get(Checksum checksum, N64FormatSize n64FmtSz, GHQTexInfo *
 		return false;
 	}
 
-	auto entry = indexEntry->second;
+	if (!_workers.empty())
+		_collectDecoded();
 
 	/* make sure to not load the same texture twice */
-	auto findTex = [n64FmtSz, this](Checksum checksum)
 	{
 		auto range = _loadedTex.equal_range(checksum);
 		for (auto it = range.first; it != range.second; ++it) {
-			if (it->second.n64_format_size == n64FmtSz)
-				return it;
-		}
-		return _loadedTex.end();
-	};
-	{
-		auto loadedTexMap = findTex(checksum);
-		if (loadedTexMap != _loadedTex.end()) {
-			DBG_INFO(80, wst("TxNoCache::get: cached chksum:%08X %08X found\n"), chksum, palchksum);
-			*info = loadedTexMap->second;
-			return true;
+			if (it->second->info.n64_format_size == n64FmtSz) {
+				DBG_INFO(80, wst("TxNoCache::get: cached chksum:%08X %08X found\n"), chksum, palchksum);
+				_loadedList.splice(_loadedList.begin(), _loadedList, it->second);
+				*info = it->second->info;
+				return true;
+			}
 		}
 	}
 
-	DBG_INFO(80, wst("TxNoCache::get: loading chksum:%08X %08X\n"), chksum, palchksum);
-
-	/* load texture */
-	int width = 0, height = 0;
-	ColorFormat format;
-	uint8_t* tex = TxHiResLoader::loadFileInfoTex(entry.fullfname, entry.fname, entry.siz, &width, &height, entry.fmt, &format);
-
-	if (tex == nullptr) {
-		/* failed to load texture, so return false */
-		DBG_INFO(80, wst("TxNoCache::get: failed to load chksum:%08X %08X\n"), chksum, palchksum);
+	if (!_workers.empty()) {
+		/* the caller keeps its own texture until the decoded one is ready */
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_pending.insert(PendingKey(checksum, n64FmtSz.formatsize())).second) {
+			_queue.push_back(LoadRequest{ checksum, n64FmtSz, indexEntry });
+			_queueCond.notify_one();
+		}
 		return false;
 	}
 
-	DBG_INFO(80, wst("TxNoCache::get: loaded chksum:%08X %08X\n"), chksum, palchksum);
-
-	info->data = tex;
-	info->width = width;
-	info->height = height;
-	info->is_hires_tex = 1;
-	info->n64_format_size = n64FmtSz;
-	setTextureFormat(format, info);
+	LoadedTex loaded;
+	if (!_loadTex(indexEntry->second, checksum, n64FmtSz, loaded))
+		return false;
 
-	/* add to loaded textures */
-	_loadedTex.insert(std::map<uint64, GHQTexInfo>::value_type(checksum, *info));
+	_addLoadedTex(loaded);
+	*info = loaded.info;
 	return true;
 }
 
+bool TxHiResNoCache::pending(Checksum checksum, N64FormatSize n64FmtSz)
+{
+	if (_workers.empty() || !checksum)
+		return false;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _pending.count(PendingKey(checksum, n64FmtSz.formatsize())) != 0;
+}
+
 bool TxHiResNoCache::reload()
 {
 	_clear();
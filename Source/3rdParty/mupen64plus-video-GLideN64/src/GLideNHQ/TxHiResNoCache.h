@@ -1,6 +1,12 @@
 #ifndef TXHIRESNOCACHE_H
 #define TXHIRESNOCACHE_H
 
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
 #include "TxHiResLoader.h"
 
 class TxHiResNoCache : public TxHiResLoader
@@ -24,14 +30,50 @@ class TxHiResNoCache : public TxHiResLoader
 		using FileIndexMap = std::multimap<uint64, FileIndexEntry>;
 		FileIndexMap _filesIndex;
 		FileIndexMap::const_iterator findFile(Checksum checksum, N64FormatSize n64FmtSz) const;
-		std::multimap<uint64, GHQTexInfo> _loadedTex;
 		dispInfoFuncExt _callback;
+
+		/* loaded textures, most recently used first */
+		struct LoadedTex
+		{
+			uint64 checksum;
+			GHQTexInfo info;
+			uint32 size;
+		};
+		using LoadedTexList = std::list<LoadedTex>;
+		LoadedTexList _loadedList;
+		std::multimap<uint64, LoadedTexList::iterator> _loadedTex;
+		uint64 _loadedSize;
+		uint64 _cacheLimit;
+		bool _loadTex(const FileIndexEntry & entry, Checksum checksum, N64FormatSize n64FmtSz, LoadedTex & loaded) const;
+		void _addLoadedTex(const LoadedTex & loaded);
+
+		/* background decoding, enabled with ASYNC_HIRESTEX */
+		struct LoadRequest
+		{
+			Checksum checksum;
+			N64FormatSize n64FmtSz;
+			FileIndexMap::const_iterator entry;
+		};
+		using PendingKey = std::pair<uint64, uint16>;
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _queueCond;
+		std::condition_variable _idleCond;
+		std::deque<LoadRequest> _queue;
+		std::vector<LoadedTex> _decoded;
+		std::set<PendingKey> _pending;
+		uint32 _busy;
+		bool _stop;
+		void _worker();
+		void _collectDecoded();
+		void _cancelLoads();
 	public:
 		~TxHiResNoCache();
   		TxHiResNoCache(int maxwidth,
 			   int maxheight,
 			   int maxbpp,
 			   int options,
+			   int cachesize,
 			   const wchar_t *cachePath,
 			   const wchar_t *texPackPath,
 			   const wchar_t *fullTexPath,
@@ -40,6 +82,7 @@ class TxHiResNoCache : public TxHiResLoader
   		bool empty() const override;
   		bool add(Checksum checksum, GHQTexInfo *info, int dataSize = 0) override { return false; }
 		bool get(Checksum checksum, N64FormatSize n64FmtSz, GHQTexInfo *info) override;
+		bool pending(Checksum checksum, N64FormatSize n64FmtSz) override;
   		bool reload() override;
   		void dump() override { };
 };
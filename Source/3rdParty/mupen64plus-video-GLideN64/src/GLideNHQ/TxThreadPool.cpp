@@ -0,0 +1,95 @@
+/*
+ * Texture Filtering
+ * Version:  1.0
+ *
+ * this is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * this is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Make; see the file COPYING.  If not, write to
+ * the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "TxThreadPool.h"
+
+TxThreadPool::TxThreadPool(uint32 numThreads)
+	: _job(nullptr)
+	, _numJobs(0)
+	, _nextJob(0)
+	, _busy(0)
+	, _generation(0)
+	, _stop(false)
+{
+	/* the calling thread takes part in run(), so one thread less is needed */
+	for (uint32 i = 1; i < numThreads; i++)
+		_workers.emplace_back(&TxThreadPool::worker, this);
+}
+
+TxThreadPool::~TxThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_start.notify_all();
+	for (auto &thrd : _workers)
+		thrd.join();
+}
+
+void TxThreadPool::runJobs()
+{
+	for (uint32 i = _nextJob++; i < _numJobs; i = _nextJob++)
+		(*_job)(i);
+}
+
+void TxThreadPool::worker()
+{
+	uint32 generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_start.wait(lock, [&]{ return _stop || _generation != generation; });
+			if (_stop)
+				return;
+			generation = _generation;
+		}
+
+		runJobs();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_busy == 0)
+			_done.notify_one();
+	}
+}
+
+void TxThreadPool::run(uint32 numJobs, const std::function<void(uint32)> &job)
+{
+	if (_workers.empty() || numJobs < 2) {
+		for (uint32 i = 0; i < numJobs; i++)
+			job(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_job = &job;
+		_numJobs = numJobs;
+		_nextJob = 0;
+		_busy = static_cast<uint32>(_workers.size());
+		_generation++;
+	}
+	_start.notify_all();
+
+	runJobs();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [&]{ return _busy == 0; });
+	_job = nullptr;
+}
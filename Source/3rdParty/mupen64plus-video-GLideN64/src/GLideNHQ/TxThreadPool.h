@@ -0,0 +1,56 @@
+/*
+ * Texture Filtering
+ * Version:  1.0
+ *
+ * this is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * this is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Make; see the file COPYING.  If not, write to
+ * the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef __TXTHREADPOOL_H__
+#define __TXTHREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TxInternal.h"
+
+/* Worker threads kept alive for the lifetime of the owner.
+ * run() hands out job indices to the workers and the calling thread,
+ * each thread claims the next free index until all jobs are done. */
+class TxThreadPool
+{
+private:
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  const std::function<void(uint32)> *_job;
+  uint32 _numJobs;
+  std::atomic<uint32> _nextJob;
+  uint32 _busy;
+  uint32 _generation;
+  bool _stop;
+  void worker();
+  void runJobs();
+public:
+  TxThreadPool(uint32 numThreads);
+  ~TxThreadPool();
+  void run(uint32 numJobs, const std::function<void(uint32)> &job);
+};
+
+#endif /* __TXTHREADPOOL_H__ */
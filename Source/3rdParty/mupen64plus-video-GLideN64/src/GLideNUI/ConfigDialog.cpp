@@ -263,6 +263,7 @@ void ConfigDialog::_init(bool reInit, bool blockCustomSettings)
 	ui->enableHWLightingCheckBox->setChecked(config.generalEmulation.enableHWLighting != 0);
 	ui->enableCoverageCheckBox->setChecked(config.generalEmulation.enableCoverage != 0);
 	ui->enableShadersStorageCheckBox->setChecked(config.generalEmulation.enableShadersStorage != 0);
+	ui->enableAsyncShadersCheckBox->setChecked(config.generalEmulation.enableAsyncShaders != 0);
 	if (!blockCustomSettings)
 		ui->customSettingsCheckBox->setChecked(config.generalEmulation.enableCustomSettings != 0);
 
@@ -382,6 +383,8 @@ void ConfigDialog::_init(bool reInit, bool blockCustomSettings)
 	ui->enhancedTexFileStorageCheckBox->setChecked(config.textureFilter.txEnhancedTextureFileStorage != 0);
 	ui->hiresTexFileStorageCheckBox->setChecked(config.textureFilter.txHiresTextureFileStorage != 0);
 	ui->noTexFileStorageCheckBox->setChecked(config.textureFilter.txNoTextureFileStorage != 0);
+	ui->hiresAsyncLoadCheckBox->setChecked(config.textureFilter.txHiresAsyncLoad != 0);
+	ui->hiresAsyncLoadCheckBox->setEnabled(config.textureFilter.txNoTextureFileStorage != 0);
 
 	ui->texPackPathLineEdit->setText(QDir::toNativeSeparators(QString::fromWCharArray(config.textureFilter.txPath)));
 	ui->texCachePathLineEdit->setText(QDir::toNativeSeparators(QString::fromWCharArray(config.textureFilter.txCachePath)));
@@ -616,6 +619,7 @@ void ConfigDialog::accept(bool justSave) {
 	config.generalEmulation.enableHWLighting = ui->enableHWLightingCheckBox->isChecked() ? 1 : 0;
 	config.generalEmulation.enableCoverage = ui->enableCoverageCheckBox->isChecked() ? 1 : 0;
 	config.generalEmulation.enableShadersStorage = ui->enableShadersStorageCheckBox->isChecked() ? 1 : 0;
+	config.generalEmulation.enableAsyncShaders = ui->enableAsyncShadersCheckBox->isChecked() ? 1 : 0;
 	config.generalEmulation.enableCustomSettings = ui->customSettingsCheckBox->isChecked() ? 1 : 0;
 
 	config.gammaCorrection.force = ui->gammaCorrectionCheckBox->isChecked() ? 1 : 0;
@@ -700,6 +704,7 @@ void ConfigDialog::accept(bool justSave) {
 	config.textureFilter.txEnhancedTextureFileStorage = ui->enhancedTexFileStorageCheckBox->isChecked() ? 1 : 0;
 	config.textureFilter.txHiresTextureFileStorage = ui->hiresTexFileStorageCheckBox->isChecked() ? 1 : 0;
 	config.textureFilter.txNoTextureFileStorage = ui->noTexFileStorageCheckBox->isChecked() ? 1 : 0;
+	config.textureFilter.txHiresAsyncLoad = ui->hiresAsyncLoadCheckBox->isChecked() ? 1 : 0;
 
 	QDir txPath(ui->texPackPathLineEdit->text());
 	if (!txPath.exists() &&
@@ -914,6 +919,7 @@ void ConfigDialog::on_texDumpPathButton_clicked()
 void ConfigDialog::on_noTexFileStorageCheckBox_toggled(bool checked)
 {
 	ui->hiresTexFileStorageCheckBox->setEnabled(!checked);
+	ui->hiresAsyncLoadCheckBox->setEnabled(checked);
 }
 
 void ConfigDialog::on_windowedResolutionComboBox_currentIndexChanged(int index)
@@ -55,6 +55,7 @@ void _loadSettings(QSettings & settings)
 	config.generalEmulation.enableHWLighting = settings.value("enableHWLighting", config.generalEmulation.enableHWLighting).toInt();
 	config.generalEmulation.enableCoverage = settings.value("enableCoverage", config.generalEmulation.enableCoverage).toInt();
 	config.generalEmulation.enableShadersStorage = settings.value("enableShadersStorage", config.generalEmulation.enableShadersStorage).toInt();
+	config.generalEmulation.enableAsyncShaders = settings.value("enableAsyncShaders", config.generalEmulation.enableAsyncShaders).toInt();
 	config.generalEmulation.enableLegacyBlending = settings.value("enableLegacyBlending", config.generalEmulation.enableLegacyBlending).toInt();			 //ini only
 	config.generalEmulation.enableHybridFilter = settings.value("enableHybridFilter", config.generalEmulation.enableHybridFilter).toInt();					 //ini only
 	config.generalEmulation.enableFragmentDepthWrite = settings.value("enableFragmentDepthWrite", config.generalEmulation.enableFragmentDepthWrite).toInt(); //ini only
@@ -110,6 +111,7 @@ void _loadSettings(QSettings & settings)
 	config.textureFilter.txEnhancedTextureFileStorage = settings.value("txEnhancedTextureFileStorage", config.textureFilter.txEnhancedTextureFileStorage).toInt();
 	config.textureFilter.txHiresTextureFileStorage = settings.value("txHiresTextureFileStorage", config.textureFilter.txHiresTextureFileStorage).toInt();
 	config.textureFilter.txNoTextureFileStorage = settings.value("txNoTextureFileStorage", config.textureFilter.txNoTextureFileStorage).toInt();
+	config.textureFilter.txHiresAsyncLoad = settings.value("txHiresAsyncLoad", config.textureFilter.txHiresAsyncLoad).toInt();
 	config.textureFilter.txHiresVramLimit = settings.value("txHiresVramLimit", config.textureFilter.txHiresVramLimit).toInt();
 	QString txPath = QString::fromWCharArray(config.textureFilter.txPath);
 	config.textureFilter.txPath[settings.value("txPath", txPath).toString().toWCharArray(config.textureFilter.txPath)] = L'\0';
@@ -205,6 +207,7 @@ void _writeSettingsToFile(const QString & filename)
 	settings.setValue("enableHWLighting", config.generalEmulation.enableHWLighting);
 	settings.setValue("enableCoverage", config.generalEmulation.enableCoverage);
 	settings.setValue("enableShadersStorage", config.generalEmulation.enableShadersStorage);
+	settings.setValue("enableAsyncShaders", config.generalEmulation.enableAsyncShaders);
 	settings.setValue("enableLegacyBlending", config.generalEmulation.enableLegacyBlending);		 //ini only
 	settings.setValue("enableHybridFilter", config.generalEmulation.enableHybridFilter);			 //ini only
 	settings.setValue("enableFragmentDepthWrite", config.generalEmulation.enableFragmentDepthWrite); //ini only
@@ -260,6 +263,7 @@ void _writeSettingsToFile(const QString & filename)
 	settings.setValue("txEnhancedTextureFileStorage", config.textureFilter.txEnhancedTextureFileStorage);
 	settings.setValue("txHiresTextureFileStorage", config.textureFilter.txHiresTextureFileStorage);
 	settings.setValue("txNoTextureFileStorage", config.textureFilter.txNoTextureFileStorage);
+	settings.setValue("txHiresAsyncLoad", config.textureFilter.txHiresAsyncLoad);
 	settings.setValue("txHiresVramLimit", config.textureFilter.txHiresVramLimit);
 	settings.setValue("txPath", QString::fromWCharArray(config.textureFilter.txPath));
 	settings.setValue("txCachePath", QString::fromWCharArray(config.textureFilter.txCachePath));
@@ -504,6 +508,7 @@ void saveCustomRomSettings(const QString & _strIniFolder, const QString & _strSh
 	WriteCustomSetting(generalEmulation, enableHWLighting);
 	WriteCustomSetting(generalEmulation, enableCoverage);
 	WriteCustomSetting(generalEmulation, enableShadersStorage);
+	WriteCustomSetting(generalEmulation, enableAsyncShaders);
 	settings.endGroup();
 
 	settings.beginGroup("graphics2D");
@@ -548,6 +553,7 @@ void saveCustomRomSettings(const QString & _strIniFolder, const QString & _strSh
 	WriteCustomSetting(textureFilter, txEnhancedTextureFileStorage);
 	WriteCustomSetting(textureFilter, txHiresTextureFileStorage);
 	WriteCustomSetting(textureFilter, txNoTextureFileStorage);
+	WriteCustomSetting(textureFilter, txHiresAsyncLoad);
 	WriteCustomSetting(textureFilter, txHiresVramLimit);
 	WriteCustomSetting(textureFilter, txHiresEnable);
 	WriteCustomSetting(textureFilter, txHiresFullAlphaChannel);
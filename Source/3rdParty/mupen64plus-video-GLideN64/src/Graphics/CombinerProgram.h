@@ -14,6 +14,10 @@ namespace graphics {
 
 		virtual const CombinerKey & getKey() const = 0;
 
+		// False while the driver still links the program in the background.
+		// With _wait set, blocks until the program can be used.
+		virtual bool isReady(bool _wait) { return true; }
+
 		virtual bool usesTexture() const = 0;
 		virtual bool usesTile(u32 _t) const = 0;
 		virtual bool usesShade() const = 0;
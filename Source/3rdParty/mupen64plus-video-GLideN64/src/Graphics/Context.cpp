@@ -18,6 +18,7 @@ bool Context::TextureBarrier = false;
 bool Context::EglImage = false;
 bool Context::EglImageFramebuffer = false;
 bool Context::DualSourceBlending = false;
+bool Context::ParallelShaderCompile = false;
 
 Context::Context() {}
 
@@ -44,6 +45,7 @@ void Context::init()
 	EglImage = m_impl->isSupported(SpecialFeatures::EglImage);
 	EglImageFramebuffer = m_impl->isSupported(SpecialFeatures::EglImageFramebuffer);
 	DualSourceBlending = m_impl->isSupported(SpecialFeatures::DualSourceBlending);
+	ParallelShaderCompile = m_impl->isSupported(SpecialFeatures::ParallelShaderCompile);
 }
 
 void Context::destroy()
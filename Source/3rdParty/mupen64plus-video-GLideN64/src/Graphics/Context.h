@@ -28,7 +28,8 @@ namespace graphics {
 		TextureBarrier,
 		EglImage,
 		EglImageFramebuffer,
-		DualSourceBlending
+		DualSourceBlending,
+		ParallelShaderCompile
 	};
 
 	enum class ClampMode {
@@ -305,6 +306,7 @@ namespace graphics {
 		static bool EglImage;
 		static bool EglImageFramebuffer;
 		static bool DualSourceBlending;
+		static bool ParallelShaderCompile;
 
 	private:
 		std::unique_ptr<ContextImpl> m_impl;
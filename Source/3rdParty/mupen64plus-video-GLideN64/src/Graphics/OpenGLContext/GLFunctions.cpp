@@ -179,6 +179,7 @@ PFNGLBUFFERSUBDATAPROC ptrBufferSubData;
 PFNGLGETPROGRAMBINARYPROC ptrGetProgramBinary;
 PFNGLPROGRAMBINARYPROC ptrProgramBinary;
 PFNGLPROGRAMPARAMETERIPROC ptrProgramParameteri;
+PFNGLMAXSHADERCOMPILERTHREADSARBPROC ptrMaxShaderCompilerThreadsARB;
 
 PFNGLTEXSTORAGE2DPROC ptrTexStorage2D;
 PFNGLTEXTURESTORAGE2DPROC ptrTextureStorage2D;
@@ -367,6 +368,7 @@ void initGLFunctions()
 	GL_GET_PROC_ADR(PFNGLGETPROGRAMBINARYPROC, GetProgramBinary);
 	GL_GET_PROC_ADR(PFNGLPROGRAMBINARYPROC, ProgramBinary);
 	GL_GET_PROC_ADR(PFNGLPROGRAMPARAMETERIPROC, ProgramParameteri);
+	GL_GET_PROC_ADR(PFNGLMAXSHADERCOMPILERTHREADSARBPROC, MaxShaderCompilerThreadsARB);
 
 	GL_GET_PROC_ADR(PFNGLTEXSTORAGE2DPROC, TexStorage2D);
 	GL_GET_PROC_ADR(PFNGLTEXTURESTORAGE2DPROC, TextureStorage2D);
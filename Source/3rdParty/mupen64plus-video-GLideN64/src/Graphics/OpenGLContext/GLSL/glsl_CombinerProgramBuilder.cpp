@@ -7,6 +7,7 @@
 #include "glsl_CombinerProgramImpl.h"
 #include "glsl_CombinerProgramBuilderAccurate.h"
 #include "glsl_CombinerProgramUniformFactoryAccurate.h"
+#include "glsl_CombinerProgramUniformFactoryCommon.h"
 #include "GraphicsDrawer.h"
 
 namespace glsl {
@@ -135,6 +136,77 @@ void _correctSecondStageParams(CombinerStage & _stage) {
 	}
 }
 
+/*---------------UberCombiner-------------*/
+
+static
+void _correctUberCycle(CombineCycle & _cycle, u32 (*_correct)(u32))
+{
+	_cycle.sa = _correct(_cycle.sa);
+	_cycle.sb = _correct(_cycle.sb);
+	_cycle.m = _correct(_cycle.m);
+	_cycle.a = _correct(_cycle.a);
+}
+
+// Feeds the current combine mode to the ubershader as (A - B) * C + D input indices.
+class UCombinerMux : public UniformGroup
+{
+public:
+	UCombinerMux(GLuint _program, u32 _cycleType) : m_cycleType(_cycleType) {
+		LocateUniform(uUberColor0);
+		LocateUniform(uUberAlpha0);
+		LocateUniform(uUberColor1);
+		LocateUniform(uUberAlpha1);
+	}
+
+	void update(bool _force) override
+	{
+		if (!_force && m_mux == gDP.combine.mux)
+			return;
+		m_mux = gDP.combine.mux;
+
+		CombineCycle cc[2];
+		CombineCycle ac[2];
+		Combiner_Expand(m_mux, m_cycleType, cc, ac);
+
+		if (m_cycleType != G_CYC_2CYCLE) {
+			_correctUberCycle(cc[1], correctFirstStageParam);
+			_correctUberCycle(ac[1], correctFirstStageParam);
+			_set(uUberColor0, cc[1], _force);
+			_set(uUberAlpha0, ac[1], _force);
+			return;
+		}
+
+		const bool equalStages = (memcmp(cc, cc + 1, sizeof(CombineCycle)) | memcmp(ac, ac + 1, sizeof(CombineCycle))) == 0;
+		if (equalStages) {
+			// Second cycle passes the first one through: (0 - 0) * 0 + combined
+			cc[1] = { G_GCI_ZERO, G_GCI_ZERO, G_GCI_ZERO, G_GCI_COMBINED };
+			ac[1] = { G_GCI_ZERO, G_GCI_ZERO, G_GCI_ZERO, G_GCI_COMBINED };
+		} else {
+			_correctUberCycle(cc[1], correctSecondStageParam);
+			_correctUberCycle(ac[1], correctSecondStageParam);
+		}
+		_correctUberCycle(cc[0], correctFirstStageParam2Cyc);
+		_correctUberCycle(ac[0], correctFirstStageParam2Cyc);
+		_set(uUberColor0, cc[0], _force);
+		_set(uUberAlpha0, ac[0], _force);
+		_set(uUberColor1, cc[1], _force);
+		_set(uUberAlpha1, ac[1], _force);
+	}
+
+private:
+	static void _set(i4Uniform & _uniform, const CombineCycle & _cycle, bool _force)
+	{
+		_uniform.set(_cycle.sa, _cycle.sb, _cycle.m, _cycle.a, _force);
+	}
+
+	u32 m_cycleType;
+	u64 m_mux = 0;
+	i4Uniform uUberColor0;
+	i4Uniform uUberAlpha0;
+	i4Uniform uUberColor1;
+	i4Uniform uUberAlpha1;
+};
+
 static
 CombinerInputs _compileCombiner(const CombinerStage & _stage, const char** _Input, std::stringstream & _strShader) {
 	bool bBracketOpen = false;
@@ -243,13 +315,11 @@ bool combinedAlphaABD(const gDPCombine & _combine) {
 	return false;
 }
 
-CombinerInputs CombinerProgramBuilder::compileCombiner(const CombinerKey & _key, Combiner & _color, Combiner & _alpha, std::string & _strShader)
+CombinerInputs CombinerProgramBuilder::compileCombinerStages(const CombinerKey & _key, Combiner & _color, Combiner & _alpha, std::stringstream & ssShader)
 {
 	gDPCombine combine;
 	combine.mux = _key.getMux();
 
-	std::stringstream ssShader;
-
 	if (CombinerProgramBuilder::s_cycleType != G_CYC_2CYCLE) {
 		_correctFirstStageParams(_alpha.stage[0]);
 		_correctFirstStageParams(_color.stage[0]);
@@ -305,6 +375,59 @@ CombinerInputs CombinerProgramBuilder::compileCombiner(const CombinerKey & _key,
 		ssShader << "  lowp vec4 cmbRes = vec4(color1, alpha1);" << std::endl;
 	}
 
+	return inputs;
+}
+
+CombinerInputs CombinerProgramBuilder::compileUberCombiner(std::stringstream & ssShader)
+{
+	// All inputs are fetched and the (A - B) * C + D selectors come from uniforms,
+	// so a single program can draw any combine mode of its cycle type.
+	CombinerInputs inputs;
+	ssShader << "  lowp vec4 uberIn[" << G_GCI_HW_LIGHT << "];" << std::endl;
+	for (u32 i = 0; i < G_GCI_HW_LIGHT; ++i) {
+		switch (i) {
+		case G_GCI_COMBINED:
+		case G_GCI_COMBINED_ALPHA:
+			// Written after the first cycle.
+		case G_GCI_LOD_FRACTION:
+			// Mipmapping is not emulated by the ubershader.
+			ssShader << "  uberIn[" << i << "] = vec4(0.0);" << std::endl;
+			break;
+		default:
+			ssShader << "  uberIn[" << i << "] = vec4(" << ColorInput[i] << ", " << AlphaInput[i] << ");" << std::endl;
+			inputs.addInput(i);
+			break;
+		}
+	}
+
+	ssShader << "  alpha1 = (uberIn[uUberAlpha0.x].a - uberIn[uUberAlpha0.y].a) * uberIn[uUberAlpha0.z].a + uberIn[uUberAlpha0.w].a;" << std::endl;
+	_writeAlphaTest(ssShader);
+	ssShader << "  color1 = (uberIn[uUberColor0.x].rgb - uberIn[uUberColor0.y].rgb) * uberIn[uUberColor0.z].rgb + uberIn[uUberColor0.w].rgb;" << std::endl;
+
+	if (CombinerProgramBuilder::s_cycleType == G_CYC_2CYCLE) {
+		ssShader << "  combined_color = vec4(color1, alpha1);" << std::endl;
+		ssShader << "  uberIn[" << G_GCI_COMBINED << "] = combined_color;" << std::endl;
+		ssShader << "  uberIn[" << G_GCI_COMBINED_ALPHA << "] = vec4(combined_color.a);" << std::endl;
+		ssShader << "  alpha2 = (uberIn[uUberAlpha1.x].a - uberIn[uUberAlpha1.y].a) * uberIn[uUberAlpha1.z].a + uberIn[uUberAlpha1.w].a;" << std::endl;
+		ssShader << "  if (uCvgXAlpha != 0 && alpha2 < 0.125) discard;" << std::endl;
+		ssShader << "  color2 = (uberIn[uUberColor1.x].rgb - uberIn[uUberColor1.y].rgb) * uberIn[uUberColor1.z].rgb + uberIn[uUberColor1.w].rgb;" << std::endl;
+		ssShader << "  lowp vec4 cmbRes = vec4(color2, alpha2);" << std::endl;
+	} else {
+		ssShader << "  if (uCvgXAlpha != 0 && alpha1 < 0.125) discard;" << std::endl;
+		ssShader << "  lowp vec4 cmbRes = vec4(color1, alpha1);" << std::endl;
+	}
+
+	return inputs;
+}
+
+CombinerInputs CombinerProgramBuilder::compileCombiner(const CombinerKey & _key, Combiner & _color, Combiner & _alpha, std::string & _strShader)
+{
+	std::stringstream ssShader;
+
+	CombinerInputs inputs(_key.isUberKey() ?
+		compileUberCombiner(ssShader) :
+		compileCombinerStages(_key, _color, _alpha, ssShader));
+
 	// Simulate N64 color clamp.
 	if (needClampColor())
 		_writeClamp(ssShader);
@@ -367,6 +490,12 @@ graphics::CombinerProgram * CombinerProgramBuilder::buildCombinerProgram(Combine
 	/* Write headers */
 	_writeFragmentHeader(ssShader);
 
+	if (_key.isUberKey()) {
+		ssShader << "uniform lowp ivec4 uUberColor0;" << std::endl << "uniform lowp ivec4 uUberAlpha0;" << std::endl;
+		if (CombinerProgramBuilder::s_cycleType == G_CYC_2CYCLE)
+			ssShader << "uniform lowp ivec4 uUberColor1;" << std::endl << "uniform lowp ivec4 uUberAlpha1;" << std::endl;
+	}
+
 	if (bUseTextures) {
 		_writeFragmentGlobalVariablesTex(ssShader);
 
@@ -511,11 +640,20 @@ graphics::CombinerProgram * CombinerProgramBuilder::buildCombinerProgram(Combine
 			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	}
 	glLinkProgram(program);
-	assert(Utils::checkProgramLinkStatus(program));
 	glDeleteShader(fragmentShader);
 
+	if (m_parallelCompile && !_key.isUberKey()) {
+		// Do not query the program here, that would wait for the driver's compiler threads.
+		// Uniforms are located once CombinerProgramImpl sees the link completed.
+		return new CombinerProgramImpl(_key, program, m_useProgram, combinerInputs, m_uniformFactory.get());
+	}
+
+	assert(Utils::checkProgramLinkStatus(program));
+
 	UniformGroups uniforms;
 	m_uniformFactory->buildUniforms(program, combinerInputs, _key, uniforms);
+	if (_key.isUberKey())
+		uniforms.emplace_back(new UCombinerMux(program, CombinerProgramBuilder::s_cycleType));
 
 	return new CombinerProgramImpl(_key, program, m_useProgram, combinerInputs, std::move(uniforms));
 }
@@ -525,6 +663,7 @@ CombinerProgramBuilder::CombinerProgramBuilder(const opengl::GLInfo & _glinfo, o
 : m_uniformFactory(std::move(_uniformFactory))
 , m_useProgram(_useProgram)
 , m_useCoverage(_glinfo.coverage && config.generalEmulation.enableCoverage != 0)
+, m_parallelCompile(_glinfo.parallelShaderCompile)
 {
 }
 
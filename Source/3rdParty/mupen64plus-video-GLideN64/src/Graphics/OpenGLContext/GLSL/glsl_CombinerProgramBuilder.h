@@ -73,6 +73,8 @@ protected:
 
 private:
 	CombinerInputs compileCombiner(const CombinerKey & _key, Combiner & _color, Combiner & _alpha, std::string & _strShader);
+	CombinerInputs compileCombinerStages(const CombinerKey & _key, Combiner & _color, Combiner & _alpha, std::stringstream & ssShader);
+	CombinerInputs compileUberCombiner(std::stringstream & ssShader);
 
 	virtual void _writeSignExtendAlphaC(std::stringstream& ssShader) const = 0;
 	virtual void _writeSignExtendAlphaABD(std::stringstream& ssShader) const = 0;
@@ -131,6 +133,7 @@ private:
 	std::unique_ptr<CombinerProgramUniformFactory> m_uniformFactory;
 	opengl::CachedUseProgram * m_useProgram;
 	bool m_useCoverage = false;
+	bool m_parallelCompile = false;
 };
 
 }
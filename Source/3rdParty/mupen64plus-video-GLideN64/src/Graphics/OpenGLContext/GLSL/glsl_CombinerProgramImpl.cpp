@@ -6,6 +6,7 @@
 #include <Graphics/OpenGLContext/opengl_Utils.h>
 #include "glsl_Utils.h"
 #include "glsl_CombinerProgramImpl.h"
+#include "glsl_CombinerProgramUniformFactory.h"
 
 using namespace glsl;
 
@@ -20,6 +21,21 @@ CombinerProgramImpl::CombinerProgramImpl(const CombinerKey & _key,
 , m_useProgram(_useProgram)
 , m_inputs(_inputs)
 , m_uniforms(std::move(_uniforms))
+, m_pendingUniformFactory(nullptr)
+{
+}
+
+CombinerProgramImpl::CombinerProgramImpl(const CombinerKey & _key,
+	GLuint _program,
+	opengl::CachedUseProgram * _useProgram,
+	const CombinerInputs & _inputs,
+	CombinerProgramUniformFactory * _uniformFactory)
+: m_bNeedUpdate(true)
+, m_key(_key)
+, m_program(_program)
+, m_useProgram(_useProgram)
+, m_inputs(_inputs)
+, m_pendingUniformFactory(_uniformFactory)
 {
 }
 
@@ -32,11 +48,13 @@ CombinerProgramImpl::~CombinerProgramImpl()
 
 void CombinerProgramImpl::activate()
 {
+	isReady(true);
 	m_useProgram->useProgram(m_program);
 }
 
 void CombinerProgramImpl::update(bool _force)
 {
+	isReady(true);
 	_force |= m_bNeedUpdate;
 	m_bNeedUpdate = false;
 	m_useProgram->useProgram(m_program);
@@ -49,6 +67,24 @@ const CombinerKey & CombinerProgramImpl::getKey() const
 	return m_key;
 }
 
+bool CombinerProgramImpl::isReady(bool _wait)
+{
+	if (m_pendingUniformFactory == nullptr)
+		return true;
+
+	if (!_wait) {
+		GLint completed = GL_FALSE;
+		glGetProgramiv(GLuint(m_program), GL_COMPLETION_STATUS_ARB, &completed);
+		if (completed == GL_FALSE)
+			return false;
+	}
+
+	Utils::checkProgramLinkStatus(GLuint(m_program), true);
+	m_pendingUniformFactory->buildUniforms(GLuint(m_program), m_inputs, m_key, m_uniforms);
+	m_pendingUniformFactory = nullptr;
+	return true;
+}
+
 bool CombinerProgramImpl::usesTexture() const
 {
 	return m_inputs.usesTexture();
@@ -76,6 +112,8 @@ bool CombinerProgramImpl::usesHwLighting() const
 
 bool CombinerProgramImpl::getBinaryForm(std::vector<char> & _buffer)
 {
+	isReady(true);
+
 	GLint  binaryLength;
 	glGetProgramiv(GLuint(m_program), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
 
@@ -12,6 +12,8 @@ namespace opengl {
 
 namespace glsl {
 
+	class CombinerProgramUniformFactory;
+
 	class UniformGroup {
 	public:
 		virtual ~UniformGroup() {}
@@ -28,11 +30,17 @@ namespace glsl {
 			opengl::CachedUseProgram * _useProgram,
 			const CombinerInputs & _inputs,
 			UniformGroups && _uniforms);
+		CombinerProgramImpl(const CombinerKey & _key,
+			GLuint _program,
+			opengl::CachedUseProgram * _useProgram,
+			const CombinerInputs & _inputs,
+			CombinerProgramUniformFactory * _uniformFactory);
 		~CombinerProgramImpl();
 
 		void activate() override;
 		void update(bool _force) override;
 		const CombinerKey & getKey() const override;
+		bool isReady(bool _wait) override;
 
 		bool usesTexture() const override;
 		bool usesTile(u32 _t) const override;
@@ -49,6 +57,7 @@ namespace glsl {
 		opengl::CachedUseProgram * m_useProgram;
 		CombinerInputs m_inputs;
 		UniformGroups m_uniforms;
+		CombinerProgramUniformFactory * m_pendingUniformFactory;
 	};
 
 }
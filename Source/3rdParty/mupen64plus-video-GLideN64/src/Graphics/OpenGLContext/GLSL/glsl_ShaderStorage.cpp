@@ -9,6 +9,7 @@
 #include <Graphics/OpenGLContext/opengl_Utils.h>
 #include <Types.h>
 #include <Log.h>
+#include <N64.h>
 #include <RSP.h>
 #include <PluginAPI.h>
 #include <Combiner.h>
@@ -21,9 +22,14 @@
 #include "glsl_CombinerProgramUniformFactoryAccurate.h"
 #include "glsl_CombinerProgramUniformFactoryFast.h"
 
+#ifdef MUPENPLUSAPI
+#include "mupenplus/GLideN64_mupenplus.h"
+#endif
+
 using namespace glsl;
 
 #define SHADER_STORAGE_FOLDER_NAME "shaders"
+#define SHADER_SHARED_KEYS_FOLDER_NAME "Shaders"
 
 static
 std::string getStorageFileName(const opengl::GLInfo & _glinfo, const char * _fileExtension)
@@ -73,6 +79,27 @@ std::string getStorageFileName(const opengl::GLInfo & _glinfo, const char * _fil
 	return path.str();
 }
 
+/*
+Combiner keys shipped with the frontend, one file per game:
+<shared data>/Shaders/GLideN64.<CRC1>-<CRC2>.keys
+Same format as the keys storage below.
+*/
+static
+std::string getSharedKeysFileName()
+{
+#ifdef MUPENPLUSAPI
+	// Header words are stored in host byte order.
+	const u32 * header = reinterpret_cast<const u32 *>(HEADER);
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), SHADER_SHARED_KEYS_FOLDER_NAME "/GLideN64.%08X-%08X.keys", header[4], header[5]);
+
+	const char * path = ConfigGetSharedDataFilepath(fileName);
+	if (path != nullptr)
+		return path;
+#endif
+	return std::string();
+}
+
 /*
 Storage has text format:
 line_1 Version in hex form
@@ -233,13 +260,16 @@ CombinerProgramImpl * _readCombinerProgramFromStream(std::istream & _is,
 	return new CombinerProgramImpl(_cmbKey, program, _useProgram, cmbInputs, std::move(uniforms));
 }
 
-bool ShaderStorage::_loadFromCombinerKeys(graphics::Combiners & _combiners)
+static
+bool _readCombinerKeys(const std::string & _fileName, std::vector<u64> & _keys)
 {
-	std::string keysFileName = getStorageFileName(m_glinfo, "keys");
+	if (_fileName.empty())
+		return false;
+
 #if defined(OS_WINDOWS) && !defined(MINGW)
-	std::ifstream fin(keysFileName);
+	std::ifstream fin(_fileName);
 #else
-	std::ifstream fin(keysFileName.c_str());
+	std::ifstream fin(_fileName.c_str());
 #endif
 	if (!fin)
 		return false;
@@ -249,44 +279,73 @@ bool ShaderStorage::_loadFromCombinerKeys(graphics::Combiners & _combiners)
 	if (version < 4)
 		return false;
 
-	const bool useGlobalHWLSuport = version == 4;
-
-	if (useGlobalHWLSuport) {
-		u32 hwlSupport = 0;
+	// Version 4 stored one hardware lighting flag for all keys.
+	u64 hwlSupport = 0;
+	if (version == 4) {
 		fin >> std::hex >> hwlSupport;
-		GBI.setHWLSupported(hwlSupport != 0);
+		hwlSupport = hwlSupport != 0 ? (1ULL << 61) : 0;
 	}
 
-	displayLoadProgress(L"LOAD COMBINER SHADERS %.1f%%", 0.0f);
-
 	u32 szCombiners;
 	fin >> std::hex >> szCombiners;
+	u64 mux;
+	for (u32 i = 0; i < szCombiners && fin >> std::hex >> mux; ++i)
+		_keys.push_back(mux | hwlSupport);
+	fin.close();
+	return true;
+}
+
+u32 ShaderStorage::_compileCombinerKeys(const std::vector<u64> & _keys, graphics::Combiners & _combiners)
+{
+	if (_keys.empty())
+		return 0;
+
+	displayLoadProgress(L"LOAD COMBINER SHADERS %.1f%%", 0.0f);
+
+	const u32 szCombiners = static_cast<u32>(_keys.size());
 	const f32 percent = szCombiners / 100.0f;
 	const f32 step = 100.0f / szCombiners;
 	f32 progress = 0.0f;
 	f32 percents = percent;
-	u64 mux;
+	u32 compiled = 0;
 	for (u32 i = 0; i < szCombiners; ++i) {
-		fin >> std::hex >> mux;
-		CombinerKey key(mux, false);
-		if (!useGlobalHWLSuport)
-			GBI.setHWLSupported(key.isHWLSupported());
+		CombinerKey key(_keys[i], false);
+		if (_combiners.find(key) != _combiners.end())
+			continue;
+		GBI.setHWLSupported(key.isHWLSupported());
 		graphics::CombinerProgram * pCombiner = Combiner_Compile(key);
-		pCombiner->update(true);
+		// With parallel shader compilation the program is still linking; it gets updated on first use.
+		if (pCombiner->isReady(false))
+			pCombiner->update(true);
 		_combiners[pCombiner->getKey()] = pCombiner;
+		++compiled;
 		progress += step;
 		if (progress > percents) {
 			displayLoadProgress(L"LOAD COMBINER SHADERS %.1f%%", f32(i + 1) * 100.f / f32(szCombiners));
 			percents += percent;
 		}
 	}
-	fin.close();
+	return compiled;
+}
+
+bool ShaderStorage::_loadFromCombinerKeys(graphics::Combiners & _combiners)
+{
+	std::vector<u64> keys;
+	const bool userKeys = _readCombinerKeys(getStorageFileName(m_glinfo, "keys"), keys);
+	const bool sharedKeys = _readCombinerKeys(getSharedKeysFileName(), keys);
+	if (!userKeys && !sharedKeys)
+		return false;
+
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	_compileCombinerKeys(keys, _combiners);
 
 	if (opengl::Utils::isGLError())
 		return false;
 
-	if (graphics::Context::ShaderProgramBinary)
+	if (graphics::Context::ShaderProgramBinary && !graphics::Context::ParallelShaderCompile)
 		// Restore shaders storage
+		// With parallel compilation CombinerInfo writes it once the programs are linked.
 		return saveShadersStorage(_combiners);
 
 	displayLoadProgress(L"");
@@ -379,6 +438,14 @@ bool ShaderStorage::loadShadersStorage(graphics::Combiners & _combiners)
 	}
 
 	fin.close();
+
+	// Shared keys may list combiners which are not in the user's storage yet.
+	std::vector<u64> sharedKeys;
+	if (_readCombinerKeys(getSharedKeysFileName(), sharedKeys) &&
+		_compileCombinerKeys(sharedKeys, _combiners) != 0 &&
+		!graphics::Context::ParallelShaderCompile)
+		return saveShadersStorage(_combiners);
+
 	displayLoadProgress(L"");
 	return !opengl::Utils::isGLError();
 }
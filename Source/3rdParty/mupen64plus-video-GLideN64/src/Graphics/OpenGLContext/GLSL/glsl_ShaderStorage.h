@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include <Graphics/OpenGLContext/opengl_GLInfo.h>
 
 namespace opengl {
@@ -19,6 +20,7 @@ namespace glsl {
 	private:
 		bool _saveCombinerKeys(const graphics::Combiners & _combiners) const;
 		bool _loadFromCombinerKeys(graphics::Combiners & _combiners);
+		u32 _compileCombinerKeys(const std::vector<u64> & _keys, graphics::Combiners & _combiners);
 
 		const u32 m_formatVersion = 0x3BU;
 		const u32 m_keysFormatVersion = 0x05;
@@ -4271,6 +4271,36 @@ private:
 	GLint m_value;
 };
 
+class GlMaxShaderCompilerThreadsARBCommand : public OpenGlCommand
+{
+public:
+	GlMaxShaderCompilerThreadsARBCommand() :
+		OpenGlCommand(false, false, "glMaxShaderCompilerThreadsARB")
+	{
+	}
+
+	static std::shared_ptr<OpenGlCommand> get(GLuint count)
+	{
+		static int poolId = OpenGlCommandPool::get().getNextAvailablePool();
+		auto ptr = getFromPool<GlMaxShaderCompilerThreadsARBCommand>(poolId);
+		ptr->set(count);
+		return ptr;
+	}
+
+	void commandToExecute() override
+	{
+		ptrMaxShaderCompilerThreadsARB(m_count);
+	}
+
+private:
+	void set(GLuint count)
+	{
+		m_count = count;
+	}
+
+	GLuint m_count;
+};
+
 class GlTexStorage2DCommand : public OpenGlCommand
 {
 public:
@@ -1255,6 +1255,14 @@ namespace opengl {
 			ptrProgramParameteri(program, pname, value);
 	}
 
+	void FunctionWrapper::wrMaxShaderCompilerThreadsARB(GLuint count)
+	{
+		if (m_threaded_wrapper)
+			executeCommand(GlMaxShaderCompilerThreadsARBCommand::get(count));
+		else
+			ptrMaxShaderCompilerThreadsARB(count);
+	}
+
 	void FunctionWrapper::wrTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
 	{
 		if (m_threaded_wrapper)
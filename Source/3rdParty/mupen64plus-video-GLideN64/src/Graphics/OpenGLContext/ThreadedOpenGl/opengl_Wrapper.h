@@ -177,6 +177,7 @@ namespace opengl {
 		static void wrGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void *binary);
 		static void wrProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
 		static void wrProgramParameteri(GLuint program, GLenum pname, GLint value);
+		static void wrMaxShaderCompilerThreadsARB(GLuint count);
 
 		static void wrTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
 		static void wrTextureStorage2D(GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
@@ -536,6 +536,8 @@ bool ContextImpl::isSupported(graphics::SpecialFeatures _feature) const
 		return m_glInfo.eglImageFramebuffer;
 	case graphics::SpecialFeatures::DualSourceBlending:
 		return m_glInfo.dual_source_blending;
+	case graphics::SpecialFeatures::ParallelShaderCompile:
+		return m_glInfo.parallelShaderCompile;
 	}
 	return false;
 }
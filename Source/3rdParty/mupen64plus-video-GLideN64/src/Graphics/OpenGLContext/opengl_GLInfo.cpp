@@ -230,6 +230,19 @@ void GLInfo::init() {
 		coverage = maxVertexAttribs >= 10;
 	}
 
+	// Async combiners index the ubershader inputs with uniforms, which GLES2 does not allow.
+	parallelShaderCompile = config.generalEmulation.enableAsyncShaders != 0 && !isGLES2 &&
+		(Utils::isExtensionSupported(*this, "GL_KHR_parallel_shader_compile") ||
+		Utils::isExtensionSupported(*this, "GL_ARB_parallel_shader_compile"));
+#ifdef EGL
+	if (isGLESX && parallelShaderCompile)
+		ptrMaxShaderCompilerThreadsARB = (PFNGLMAXSHADERCOMPILERTHREADSARBPROC) eglGetProcAddress("glMaxShaderCompilerThreadsKHR");
+#endif
+	if (parallelShaderCompile && IS_GL_FUNCTION_VALID(MaxShaderCompilerThreadsARB))
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+	if (config.generalEmulation.enableAsyncShaders != 0 && !parallelShaderCompile)
+		LOG(LOG_WARNING, "Your GPU driver does not support parallel shader compilation. Shaders will be compiled synchronously.");
+
 #ifdef EGL
 	if (isGLESX)
 	{
@@ -115,6 +115,21 @@ void LogDebug(const char* _fileName, int _line, u16 _type, const char* _format,
 	fileOutput.flush();
 }
 
+void LogInfo(const char* _fileName, int _line, const char* _format, ...)
+{
+	va_list vaArgs;
+	va_start(vaArgs, _format);
+	va_list vaCopy;
+	va_copy(vaCopy, vaArgs);
+	const int iLen = std::vsnprintf(NULL, 0, _format, vaCopy);
+	va_end(vaCopy);
+	std::vector<char> zc(iLen + 1);
+	std::vsnprintf(zc.data(), zc.size(), _format, vaArgs);
+	va_end(vaArgs);
+
+	LogDebug(_fileName, _line, LOG_MINIMAL, "%s", zc.data());
+}
+
 #else // mupen64plus
 #include "mupenplus/GLideN64_mupenplus.h"
 
@@ -161,6 +176,24 @@ void LogDebug(const char* _fileName, int _line, u16 _type, const char* _format,
 
 	CoreDebugCallback(CoreDebugCallbackContext, logLevel[_type], formatString.str().c_str());
 }
+
+void LogInfo(const char* _fileName, int _line, const char* _format, ...)
+{
+	if (CoreDebugCallback == nullptr)
+		return;
+
+	va_list vaArgs;
+	va_start(vaArgs, _format);
+	va_list vaCopy;
+	va_copy(vaCopy, vaArgs);
+	const int iLen = std::vsnprintf(NULL, 0, _format, vaCopy);
+	va_end(vaCopy);
+	std::vector<char> zc(iLen + 1);
+	std::vsnprintf(zc.data(), zc.size(), _format, vaArgs);
+	va_end(vaArgs);
+
+	CoreDebugCallback(CoreDebugCallbackContext, M64MSG_INFO, zc.data());
+}
 #endif
 
 #if defined(OS_WINDOWS) && !defined(MINGW)
@@ -27,11 +27,17 @@
 
 #define LOG(...) LogDebug(__FILENAME__, __LINE__, __VA_ARGS__)
 
+// Runtime reports, which are passed to the core debug callback
+// as is, so they show up in the log of the frontend
+#define LOG_INFO(...) LogInfo(__FILENAME__, __LINE__, __VA_ARGS__)
+
 void LogDebug(const char* _fileName, int _line, u16 _type, const char* _format, ...);
+void LogInfo(const char* _fileName, int _line, const char* _format, ...);
 
 #else
 
 #define LOG(A, ...)
+#define LOG_INFO(...)
 
 #endif
 
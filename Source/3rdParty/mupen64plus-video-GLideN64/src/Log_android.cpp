@@ -51,4 +51,17 @@ void LogDebug(const char* _fileName, int _line, u16 _type, const char* _format,
 	};
 
 	__android_log_write(androidLogTranslate[_type], "GLideN64", lcFormatString.str().c_str());
-}
\ No newline at end of file
+}
+void LogInfo(const char* _fileName, int _line, const char* _format, ...) {
+	va_list vaArgs;
+	va_start(vaArgs, _format);
+	va_list vaCopy;
+	va_copy(vaCopy, vaArgs);
+	const int iLen = std::vsnprintf(NULL, 0, _format, vaCopy);
+	va_end(vaCopy);
+	std::vector<char> zc(iLen + 1);
+	std::vsnprintf(zc.data(), zc.size(), _format, vaArgs);
+	va_end(vaArgs);
+
+	LogDebug(_fileName, _line, LOG_MINIMAL, "%s", zc.data());
+}
@@ -0,0 +1,196 @@
+/*
+ * Texel decoder test
+ *
+ * Checks that the row decoders of TexelDecoders.cpp, including the SSE2 and
+ * NEON ones, decode TMEM exactly like the per-texel getters they replace.
+ * Every getter is run over random TMEM contents for every line width up to
+ * a few TMEM lines, odd and even lines, several TMEM offsets and palettes,
+ * both output texel sizes, and for clamped and masked s coordinates.
+ *
+ * usage: TexelDecodersTest
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "N64.h"
+#include "TexelDecoders.h"
+
+struct TexelFormat
+{
+	const char *name;
+	GetTexelFunc getTexel;
+};
+
+static const TexelFormat formats[] = {
+	{ "CI4_RGBA8888", GetCI4_RGBA8888 },
+	{ "CI4_RGBA4444", GetCI4_RGBA4444 },
+	{ "CI4IA_RGBA4444", GetCI4IA_RGBA4444 },
+	{ "CI4IA_RGBA8888", GetCI4IA_RGBA8888 },
+	{ "CI4RGBA_RGBA5551", GetCI4RGBA_RGBA5551 },
+	{ "CI4RGBA_RGBA8888", GetCI4RGBA_RGBA8888 },
+	{ "IA31_RGBA8888", GetIA31_RGBA8888 },
+	{ "IA31_RGBA4444", GetIA31_RGBA4444 },
+	{ "I4_RGBA8888", GetI4_RGBA8888 },
+	{ "I4_RGBA4444", GetI4_RGBA4444 },
+	{ "CI8IA_RGBA4444", GetCI8IA_RGBA4444 },
+	{ "CI8IA_RGBA8888", GetCI8IA_RGBA8888 },
+	{ "CI8RGBA_RGBA5551", GetCI8RGBA_RGBA5551 },
+	{ "CI8RGBA_RGBA8888", GetCI8RGBA_RGBA8888 },
+	{ "IA44_RGBA8888", GetIA44_RGBA8888 },
+	{ "IA44_RGBA4444", GetIA44_RGBA4444 },
+	{ "I8_RGBA8888", GetI8_RGBA8888 },
+	{ "I8_RGBA4444", GetI8_RGBA4444 },
+	{ "I16_RGBA8888", GetI16_RGBA8888 },
+	{ "I16_RGBA4444", GetI16_RGBA4444 },
+	{ "CI16IA_RGBA8888", GetCI16IA_RGBA8888 },
+	{ "CI16IA_RGBA4444", GetCI16IA_RGBA4444 },
+	{ "CI16RGBA_RGBA8888", GetCI16RGBA_RGBA8888 },
+	{ "CI16RGBA_RGBA5551", GetCI16RGBA_RGBA5551 },
+	{ "RGBA5551_RGBA8888", GetRGBA5551_RGBA8888 },
+	{ "RGBA5551_RGBA5551", GetRGBA5551_RGBA5551 },
+	{ "IA88_RGBA8888", GetIA88_RGBA8888 },
+	{ "IA88_RGBA4444", GetIA88_RGBA4444 },
+	{ "RGBA8888_RGBA8888", GetRGBA8888_RGBA8888 },
+	{ "RGBA8888_RGBA4444", GetRGBA8888_RGBA4444 },
+};
+
+/* TMEM offsets are in 64-bit words, the last ones wrap around */
+static const u16 offsets[] = { 0x000, 0x037, 0x100, 0x1C3, 0x1FF };
+static const u16 lines[] = { 0, 2 };
+static const u8 palettes[] = { 0, 5, 15 };
+
+/* widths of the full lines, the larger ones exceed what fits in TMEM */
+static const u16 maxWidth = 160;
+static const u16 largeWidths[] = { 256, 511, 1024, 2047, 4096, 8192 };
+
+/* clamped and masked lines, clamps are relative to the width */
+static const u16 clampWidths[] = { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 100, 256 };
+static const u16 masks[] = { 0xFFFF, 1, 3, 7, 15, 31, 63, 127, 255, 511, 1023 };
+
+static u32 seed = 0x12345678;
+
+static void fillTMEM()
+{
+	for (u64 &word : TMEM) {
+		seed = seed * 1103515245 + 12345;
+		const u64 hi = seed;
+		seed = seed * 1103515245 + 12345;
+		word = (hi << 32) | seed;
+	}
+}
+
+/* guard bytes after the decoded line, to catch writes past its end */
+#define GUARD_SIZE 64
+#define GUARD_BYTE 0xCD
+
+static bool checkLine(const TexelFormat &format, GetTexelRowFunc getRow, u16 offset, u16 i, u8 palette,
+	u16 width, u16 clampS, u16 maskS, bool rgba8)
+{
+	const u32 texelSize = rgba8 ? 4 : 2;
+	std::vector<u32> decoded((width * texelSize + GUARD_SIZE) / 4);
+	u8 *pDecoded = reinterpret_cast<u8*>(decoded.data());
+	memset(pDecoded, GUARD_BYTE, decoded.size() * 4);
+	std::vector<u32> rowTexels(GetTexelRowWidth(width, clampS, maskS));
+
+	GetTexelLine(format.getTexel, getRow, offset, i, palette, width, clampS, maskS,
+		pDecoded, rowTexels.data(), rgba8);
+
+	for (u16 x = 0; x < width; ++x) {
+		u32 expected = format.getTexel(offset, std::min(x, clampS) & maskS, i, palette);
+		u32 texel;
+		if (rgba8) {
+			texel = decoded[x];
+		} else {
+			expected = static_cast<u16>(expected);
+			texel = reinterpret_cast<u16*>(pDecoded)[x];
+		}
+		if (texel != expected) {
+			printf("FAIL: %s %s offset 0x%03x i %u palette %u width %u clamp %u mask 0x%x: texel %u is %08x, expected %08x\n",
+				format.name, rgba8 ? "32 bit" : "16 bit", offset, i, palette, width, clampS, maskS, x, texel, expected);
+			return false;
+		}
+	}
+
+	for (u32 b = width * texelSize; b < decoded.size() * 4; ++b) {
+		if (pDecoded[b] != GUARD_BYTE) {
+			printf("FAIL: %s %s width %u clamp %u mask 0x%x writes past the end of the line\n",
+				format.name, rgba8 ? "32 bit" : "16 bit", width, clampS, maskS);
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool checkFormat(const TexelFormat &format, u32 &numLines)
+{
+	const GetTexelRowFunc getRow = GetTexelRowFor(format.getTexel);
+	if (getRow == nullptr) {
+		printf("FAIL: %s has no row decoder\n", format.name);
+		return false;
+	}
+
+	fillTMEM();
+
+	for (int rgba8 = 0; rgba8 < 2; ++rgba8) {
+		for (u16 offset : offsets) {
+			for (u16 i : lines) {
+				for (u8 palette : palettes) {
+					/* whole lines */
+					for (u16 width = 1; width <= maxWidth; ++width, ++numLines) {
+						if (!checkLine(format, getRow, offset, i, palette, width, width - 1, 0xFFFF, rgba8 != 0))
+							return false;
+					}
+					for (u16 width : largeWidths) {
+						++numLines;
+						if (!checkLine(format, getRow, offset, i, palette, width, width - 1, 0xFFFF, rgba8 != 0))
+							return false;
+					}
+
+					/* clamped, mirrored and masked lines */
+					for (u16 width : clampWidths) {
+						const u16 clamps[] = { 0, 1, 3, static_cast<u16>(width / 2), static_cast<u16>(width - 1),
+							width, static_cast<u16>(width + 5), static_cast<u16>((width << 1) - 1) };
+						for (u16 clampS : clamps) {
+							for (u16 maskS : masks) {
+								++numLines;
+								if (!checkLine(format, getRow, offset, i, palette, width, clampS, maskS, rgba8 != 0))
+									return false;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	printf("row decoders: SSE2\n");
+#elif defined(__NEON_OPT)
+	printf("row decoders: NEON\n");
+#else
+	printf("row decoders: scalar\n");
+#endif
+
+	u32 numLines = 0;
+	bool passed = true;
+	for (const TexelFormat &format : formats)
+		passed = checkFormat(format, numLines) && passed;
+
+	if (!passed)
+		return 1;
+
+	printf("PASS: %u formats, %u lines\n", (u32)(sizeof(formats) / sizeof(formats[0])), numLines);
+	return 0;
+}
@@ -0,0 +1,589 @@
+#include <algorithm>
+#include "TexelDecoders.h"
+#include "N64.h"
+#include "convert.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXEL_ROW_SSE2
+#include <emmintrin.h>
+#elif defined(__NEON_OPT)
+#define TEXEL_ROW_NEON
+#include <arm_neon.h>
+#endif
+
+inline u8 Get4BitPaletteColor(u16 offset, u16 x, u16 i)
+{
+	u8* tmem8 = reinterpret_cast<u8*>(TMEM);
+	return tmem8[((offset << 3) + ((x >> 1) ^ (i << 1))) & 0xFFF];
+}
+
+u32 GetCI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return CI4_RGBA8888((x & 1) ? (palette << 4) | (color4B & 0x0F) : (palette << 4) | (color4B >> 4));
+}
+
+u32 GetCI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return CI4_RGBA4444((x & 1) ? (palette << 4) | (color4B & 0x0F) : (palette << 4) | (color4B >> 4));
+}
+
+u32 GetCI4IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+
+	if (x & 1)
+		return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
+	else
+		return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI4IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+
+	if (x & 1)
+		return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
+	else
+		return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI4RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+
+	if (x & 1)
+		return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
+	else
+		return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI4RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+
+	if (x & 1)
+		return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
+	else
+		return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetIA31_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return IA31_RGBA8888((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
+}
+
+u32 GetIA31_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return IA31_RGBA4444((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
+}
+
+u32 GetI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return I4_RGBA8888((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
+}
+
+u32 GetI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color4B = Get4BitPaletteColor(offset, x, i);
+	return I4_RGBA4444((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
+}
+
+inline u8 Get8BitPaletteColor(u16 offset, u16 x, u16 i)
+{
+	u8* tmem8 = reinterpret_cast<u8*>(TMEM);
+	return tmem8[((offset << 3) + (x ^ (i << 1))) & 0xFFF];
+}
+
+u32 GetCI8IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI8IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI8RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetCI8RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
+}
+
+u32 GetIA44_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return IA44_RGBA8888(color);
+}
+
+u32 GetIA44_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return IA44_RGBA4444(color);
+}
+
+u32 GetI8_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return I8_RGBA8888(color);
+}
+u32 GetI8_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u8 color = Get8BitPaletteColor(offset, x, i);
+	return I8_RGBA4444(color);
+}
+
+inline u16 Get16BitColor(u16 offset, u16 x, u16 i)
+{
+	u16* tmem16 = reinterpret_cast<u16*>(TMEM);
+	return tmem16[((offset << 2) + (x ^ i)) & 0x7FF];
+}
+
+u32 GetI16_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	u32 r = tex >> 8;
+	u32 g = tex & 0xFF;
+	u32 b = r;
+	u32 a = g;
+	return (a << 24) | (b << 16) | (g << 8) | r;
+}
+
+u32 GetI16_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	u16 r = tex >> 12;
+	u16 g = tex & 0x0F;
+	u16 b = r;
+	u16 a = g;
+	return (a << 12) | (b << 8) | (g << 4) | r;
+}
+
+u32 GetCI16IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	const u16 col = (static_cast<u16>(TMEM[0x100 + (tex & 0xFF)] & 0xFFFF));
+	const u16 c = col >> 8;
+	const u16 a = col & 0xFF;
+	return (a << 24) | (c << 16) | (c << 8) | c;
+}
+
+u32 GetCI16IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	const u16 col = (static_cast<u16>(TMEM[0x100 + (tex & 0xFF)] & 0xFFFF));
+	const u16 c = col >> 12;
+	const u16 a = col & 0x0F;
+	return (a << 12) | (c << 8) | (c << 4) | c;
+}
+
+u32 GetCI16RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i) & 0xFF;
+	return RGBA5551_RGBA8888(((u16*)&TMEM[0x100])[tex << 2]);
+}
+
+u32 GetCI16RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i) & 0xFF;
+	return RGBA5551_RGBA5551(((u16*)&TMEM[0x100])[tex << 2]);
+}
+
+u32 GetRGBA5551_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	return RGBA5551_RGBA8888(tex);
+}
+
+u32 GetRGBA5551_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	return RGBA5551_RGBA5551(tex);
+}
+
+u32 GetIA88_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	return IA88_RGBA8888(tex);
+}
+
+u32 GetIA88_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u16 tex = Get16BitColor(offset, x, i);
+	return IA88_RGBA4444(tex);
+}
+
+inline u32 Get32BitColor(u16 offset, u16 x, u16 i)
+{
+	u32* tmem32 = reinterpret_cast<u32*>(TMEM);
+	return tmem32[((offset << 1) + (x ^ i)) & 0x3FF];
+}
+
+u32 GetRGBA8888_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
+{
+	return Get32BitColor(offset, x, i);
+}
+
+u32 GetRGBA8888_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
+{
+	const u32 tex = Get32BitColor(offset, x, i);
+	return RGBA8888_RGBA4444(tex);
+}
+
+// Scalar row decoder, also the reference the SIMD decoders have to match
+template <GetTexelFunc GetTexel>
+void GetTexelRow(u16 offset, u16 i, u8 palette, u16 width, void * pDest, bool rgba8)
+{
+	if (rgba8) {
+		u32 * pDst = reinterpret_cast<u32*>(pDest);
+		for (u16 x = 0; x < width; ++x)
+			pDst[x] = GetTexel(offset, x, i, palette);
+	} else {
+		u16 * pDst = reinterpret_cast<u16*>(pDest);
+		for (u16 x = 0; x < width; ++x)
+			pDst[x] = static_cast<u16>(GetTexel(offset, x, i, palette));
+	}
+}
+
+#if defined(TEXEL_ROW_SSE2) || defined(TEXEL_ROW_NEON)
+
+// Copy one TMEM line into linear order, undoing the 32-bit word swap of odd lines
+static
+void GatherTexelRow(u16 offset, u16 i, u32 numWords, u64 * pDst)
+{
+	for (u32 w = 0; w < numWords; ++w) {
+		const u64 word = TMEM[(offset + w) & 0x1FF];
+		pDst[w] = i != 0 ? (word << 32) | (word >> 32) : word;
+	}
+}
+
+#ifdef TEXEL_ROW_SSE2
+
+// 5 bit to 8 bit expansion with the rounding of Five2Eight
+static inline
+__m128i Expand5To8(__m128i c)
+{
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(527)), _mm_set1_epi16(23)), 6);
+}
+
+// Interleaves two 16 bit halves into 8 RGBA8888 texels
+static inline
+void StoreRGBA8888(u32 * pDst, __m128i lo, __m128i hi)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_unpacklo_epi16(lo, hi));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4), _mm_unpackhi_epi16(lo, hi));
+}
+
+static
+u32 ConvertRowRGBA5551_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	const __m128i mask5 = _mm_set1_epi16(0x1F);
+	const __m128i one = _mm_set1_epi16(1);
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x * 2));
+		c = _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8));
+		const __m128i r = Expand5To8(_mm_srli_epi16(c, 11));
+		const __m128i g = Expand5To8(_mm_and_si128(_mm_srli_epi16(c, 6), mask5));
+		const __m128i b = Expand5To8(_mm_and_si128(_mm_srli_epi16(c, 1), mask5));
+		const __m128i a = _mm_cmpeq_epi16(_mm_and_si128(c, one), one);
+		StoreRGBA8888(pDst + x, _mm_or_si128(r, _mm_slli_epi16(g, 8)), _mm_or_si128(b, _mm_slli_epi16(a, 8)));
+	}
+	return x;
+}
+
+static
+u32 ConvertRowRGBA5551_RGBA5551(const u8 * pSrc, u32 width, u16 * pDst)
+{
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x * 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8)));
+	}
+	return x;
+}
+
+static
+u32 ConvertRowIA88_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	const __m128i maskI = _mm_set1_epi16(0xFF);
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x * 2));
+		const __m128i i = _mm_and_si128(c, maskI);
+		StoreRGBA8888(pDst + x, _mm_or_si128(i, _mm_slli_epi16(i, 8)), c);
+	}
+	return x;
+}
+
+static
+u32 ConvertRowIA44_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	const __m128i mask4 = _mm_set1_epi16(0x0F);
+	const __m128i zero = _mm_setzero_si128();
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc + x)), zero);
+		const __m128i i = _mm_mullo_epi16(_mm_srli_epi16(c, 4), _mm_set1_epi16(0x11));
+		const __m128i a = _mm_mullo_epi16(_mm_and_si128(c, mask4), _mm_set1_epi16(0x11));
+		StoreRGBA8888(pDst + x, _mm_or_si128(i, _mm_slli_epi16(i, 8)), _mm_or_si128(i, _mm_slli_epi16(a, 8)));
+	}
+	return x;
+}
+
+static
+u32 ConvertRowI8_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	u32 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + x));
+		const __m128i lo = _mm_unpacklo_epi8(c, c);
+		const __m128i hi = _mm_unpackhi_epi8(c, c);
+		StoreRGBA8888(pDst + x, lo, lo);
+		StoreRGBA8888(pDst + x + 8, hi, hi);
+	}
+	return x;
+}
+
+static
+u32 ConvertRowI4_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	const __m128i mask4 = _mm_set1_epi8(0x0F);
+	u32 x = 0;
+	for (; x + 32 <= width; x += 32) {
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + (x >> 1)));
+		const __m128i even = _mm_and_si128(_mm_srli_epi16(c, 4), mask4);
+		const __m128i odd = _mm_and_si128(c, mask4);
+		const __m128i lo = _mm_unpacklo_epi8(even, odd);
+		const __m128i hi = _mm_unpackhi_epi8(even, odd);
+		const __m128i lo8 = _mm_or_si128(lo, _mm_slli_epi16(lo, 4));
+		const __m128i hi8 = _mm_or_si128(hi, _mm_slli_epi16(hi, 4));
+		const __m128i t0 = _mm_unpacklo_epi8(lo8, lo8);
+		const __m128i t1 = _mm_unpackhi_epi8(lo8, lo8);
+		const __m128i t2 = _mm_unpacklo_epi8(hi8, hi8);
+		const __m128i t3 = _mm_unpackhi_epi8(hi8, hi8);
+		StoreRGBA8888(pDst + x, t0, t0);
+		StoreRGBA8888(pDst + x + 8, t1, t1);
+		StoreRGBA8888(pDst + x + 16, t2, t2);
+		StoreRGBA8888(pDst + x + 24, t3, t3);
+	}
+	return x;
+}
+
+#else // TEXEL_ROW_NEON
+
+static inline
+uint16x8_t Expand5To8(uint16x8_t c)
+{
+	return vshrq_n_u16(vmlaq_n_u16(vdupq_n_u16(23), c, 527), 6);
+}
+
+static inline
+void StoreRGBA8888(u32 * pDst, uint16x8_t lo, uint16x8_t hi)
+{
+	const uint16x8x2_t t = vzipq_u16(lo, hi);
+	vst1q_u32(pDst, vreinterpretq_u32_u16(t.val[0]));
+	vst1q_u32(pDst + 4, vreinterpretq_u32_u16(t.val[1]));
+}
+
+static
+u32 ConvertRowRGBA5551_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const uint16x8_t c = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(pSrc + x * 2)));
+		const uint16x8_t r = Expand5To8(vshrq_n_u16(c, 11));
+		const uint16x8_t g = Expand5To8(vandq_u16(vshrq_n_u16(c, 6), mask5));
+		const uint16x8_t b = Expand5To8(vandq_u16(vshrq_n_u16(c, 1), mask5));
+		const uint16x8_t a = vtstq_u16(c, vdupq_n_u16(1));
+		StoreRGBA8888(pDst + x, vorrq_u16(r, vshlq_n_u16(g, 8)), vorrq_u16(b, vshlq_n_u16(a, 8)));
+	}
+	return x;
+}
+
+static
+u32 ConvertRowRGBA5551_RGBA5551(const u8 * pSrc, u32 width, u16 * pDst)
+{
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8)
+		vst1q_u8(reinterpret_cast<u8*>(pDst + x), vrev16q_u8(vld1q_u8(pSrc + x * 2)));
+	return x;
+}
+
+static
+u32 ConvertRowIA88_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const uint16x8_t c = vld1q_u16(reinterpret_cast<const u16*>(pSrc + x * 2));
+		const uint16x8_t i = vandq_u16(c, vdupq_n_u16(0xFF));
+		StoreRGBA8888(pDst + x, vorrq_u16(i, vshlq_n_u16(i, 8)), c);
+	}
+	return x;
+}
+
+static
+u32 ConvertRowIA44_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	u32 x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const uint16x8_t c = vmovl_u8(vld1_u8(pSrc + x));
+		const uint16x8_t i = vmulq_n_u16(vshrq_n_u16(c, 4), 0x11);
+		const uint16x8_t a = vmulq_n_u16(vandq_u16(c, vdupq_n_u16(0x0F)), 0x11);
+		StoreRGBA8888(pDst + x, vorrq_u16(i, vshlq_n_u16(i, 8)), vorrq_u16(i, vshlq_n_u16(a, 8)));
+	}
+	return x;
+}
+
+static
+u32 ConvertRowI8_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	u32 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t c = vld1q_u8(pSrc + x);
+		const uint8x16x4_t t = { { c, c, c, c } };
+		vst4q_u8(reinterpret_cast<u8*>(pDst + x), t);
+	}
+	return x;
+}
+
+static
+u32 ConvertRowI4_RGBA8888(const u8 * pSrc, u32 width, u32 * pDst)
+{
+	u32 x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const uint8x8_t c = vld1_u8(pSrc + (x >> 1));
+		const uint8x8x2_t n = vzip_u8(vshr_n_u8(c, 4), vand_u8(c, vdup_n_u8(0x0F)));
+		const uint8x16_t i = vmulq_u8(vcombine_u8(n.val[0], n.val[1]), vdupq_n_u8(0x11));
+		const uint8x16x4_t t = { { i, i, i, i } };
+		vst4q_u8(reinterpret_cast<u8*>(pDst + x), t);
+	}
+	return x;
+}
+
+#endif // TEXEL_ROW_SSE2
+
+// Decodes the bulk of a row with SIMD, the tail and 16 bit targets with the scalar getter
+template <GetTexelFunc GetTexel, u32 bitsPerTexel, typename T, u32 (*ConvertRow)(const u8 *, u32, T *)>
+void GetTexelRowSIMD(u16 offset, u16 i, u8 palette, u16 width, void * pDest, bool rgba8)
+{
+	const u32 numWords = (width * bitsPerTexel + 63) / 64;
+	if (rgba8 != (sizeof(T) == 4) || numWords > 512) {
+		GetTexelRow<GetTexel>(offset, i, palette, width, pDest, rgba8);
+		return;
+	}
+
+	u64 row[512];
+	GatherTexelRow(offset, i, numWords, row);
+	T * pDst = reinterpret_cast<T*>(pDest);
+	for (u32 x = ConvertRow(reinterpret_cast<const u8*>(row), width, pDst); x < width; ++x)
+		pDst[x] = static_cast<T>(GetTexel(offset, static_cast<u16>(x), i, palette));
+}
+
+#endif // TEXEL_ROW_SSE2 || TEXEL_ROW_NEON
+
+GetTexelRowFunc GetTexelRowFor(GetTexelFunc _getTexel)
+{
+	struct TexelRowFunc
+	{
+		GetTexelFunc getTexel;
+		GetTexelRowFunc getTexelRow;
+	};
+	static const TexelRowFunc texelRowFuncs[] = {
+#if defined(TEXEL_ROW_SSE2) || defined(TEXEL_ROW_NEON)
+		{ GetRGBA5551_RGBA8888, GetTexelRowSIMD<GetRGBA5551_RGBA8888, 16, u32, ConvertRowRGBA5551_RGBA8888> },
+		{ GetRGBA5551_RGBA5551, GetTexelRowSIMD<GetRGBA5551_RGBA5551, 16, u16, ConvertRowRGBA5551_RGBA5551> },
+		{ GetIA88_RGBA8888, GetTexelRowSIMD<GetIA88_RGBA8888, 16, u32, ConvertRowIA88_RGBA8888> },
+		{ GetIA44_RGBA8888, GetTexelRowSIMD<GetIA44_RGBA8888, 8, u32, ConvertRowIA44_RGBA8888> },
+		{ GetI8_RGBA8888, GetTexelRowSIMD<GetI8_RGBA8888, 8, u32, ConvertRowI8_RGBA8888> },
+		{ GetI4_RGBA8888, GetTexelRowSIMD<GetI4_RGBA8888, 4, u32, ConvertRowI4_RGBA8888> },
+#else
+		{ GetRGBA5551_RGBA8888, GetTexelRow<GetRGBA5551_RGBA8888> },
+		{ GetRGBA5551_RGBA5551, GetTexelRow<GetRGBA5551_RGBA5551> },
+		{ GetIA88_RGBA8888, GetTexelRow<GetIA88_RGBA8888> },
+		{ GetIA44_RGBA8888, GetTexelRow<GetIA44_RGBA8888> },
+		{ GetI8_RGBA8888, GetTexelRow<GetI8_RGBA8888> },
+		{ GetI4_RGBA8888, GetTexelRow<GetI4_RGBA8888> },
+#endif
+		{ GetIA88_RGBA4444, GetTexelRow<GetIA88_RGBA4444> },
+		{ GetIA44_RGBA4444, GetTexelRow<GetIA44_RGBA4444> },
+		{ GetIA31_RGBA8888, GetTexelRow<GetIA31_RGBA8888> },
+		{ GetIA31_RGBA4444, GetTexelRow<GetIA31_RGBA4444> },
+		{ GetI8_RGBA4444, GetTexelRow<GetI8_RGBA4444> },
+		{ GetI4_RGBA4444, GetTexelRow<GetI4_RGBA4444> },
+		{ GetI16_RGBA8888, GetTexelRow<GetI16_RGBA8888> },
+		{ GetI16_RGBA4444, GetTexelRow<GetI16_RGBA4444> },
+		{ GetCI4_RGBA8888, GetTexelRow<GetCI4_RGBA8888> },
+		{ GetCI4_RGBA4444, GetTexelRow<GetCI4_RGBA4444> },
+		{ GetCI4IA_RGBA8888, GetTexelRow<GetCI4IA_RGBA8888> },
+		{ GetCI4IA_RGBA4444, GetTexelRow<GetCI4IA_RGBA4444> },
+		{ GetCI4RGBA_RGBA8888, GetTexelRow<GetCI4RGBA_RGBA8888> },
+		{ GetCI4RGBA_RGBA5551, GetTexelRow<GetCI4RGBA_RGBA5551> },
+		{ GetCI8IA_RGBA8888, GetTexelRow<GetCI8IA_RGBA8888> },
+		{ GetCI8IA_RGBA4444, GetTexelRow<GetCI8IA_RGBA4444> },
+		{ GetCI8RGBA_RGBA8888, GetTexelRow<GetCI8RGBA_RGBA8888> },
+		{ GetCI8RGBA_RGBA5551, GetTexelRow<GetCI8RGBA_RGBA5551> },
+		{ GetCI16IA_RGBA8888, GetTexelRow<GetCI16IA_RGBA8888> },
+		{ GetCI16IA_RGBA4444, GetTexelRow<GetCI16IA_RGBA4444> },
+		{ GetCI16RGBA_RGBA8888, GetTexelRow<GetCI16RGBA_RGBA8888> },
+		{ GetCI16RGBA_RGBA5551, GetTexelRow<GetCI16RGBA_RGBA5551> },
+		{ GetRGBA8888_RGBA8888, GetTexelRow<GetRGBA8888_RGBA8888> },
+		{ GetRGBA8888_RGBA4444, GetTexelRow<GetRGBA8888_RGBA4444> },
+	};
+
+	for (const TexelRowFunc & func : texelRowFuncs) {
+		if (func.getTexel == _getTexel)
+			return func.getTexelRow;
+	}
+	return nullptr;
+}
+
+u16 GetTexelRowWidth(u16 width, u16 clampS, u16 maskS)
+{
+	return std::min(std::min(static_cast<u16>(width - 1), clampS), maskS) + 1;
+}
+
+void GetTexelLine(GetTexelFunc GetTexel, GetTexelRowFunc GetRow, u16 offset, u16 i, u8 palette, u16 width,
+	u16 clampS, u16 maskS, void * pDest, u32 * pRowTexels, bool rgba8)
+{
+	if (GetRow == nullptr) {
+		for (u16 x = 0; x < width; ++x) {
+			const u16 tx = std::min(x, clampS) & maskS;
+			if (rgba8)
+				reinterpret_cast<u32*>(pDest)[x] = GetTexel(offset, tx, i, palette);
+			else
+				reinterpret_cast<u16*>(pDest)[x] = GetTexel(offset, tx, i, palette);
+		}
+		return;
+	}
+
+	const u16 rowWidth = GetTexelRowWidth(width, clampS, maskS);
+	if (rowWidth == width) {
+		GetRow(offset, i, palette, width, pDest, rgba8);
+		return;
+	}
+
+	// Decode the texels the line samples once, then clamp and mask
+	GetRow(offset, i, palette, rowWidth, pRowTexels, rgba8);
+	for (u16 x = 0; x < width; ++x) {
+		const u16 tx = std::min(x, clampS) & maskS;
+		if (rgba8)
+			reinterpret_cast<u32*>(pDest)[x] = pRowTexels[tx];
+		else
+			reinterpret_cast<u16*>(pDest)[x] = reinterpret_cast<u16*>(pRowTexels)[tx];
+	}
+}
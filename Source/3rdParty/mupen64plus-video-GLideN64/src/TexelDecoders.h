@@ -0,0 +1,55 @@
+#pragma once
+#include "Types.h"
+#include "Textures.h"
+
+/*
+ * Texel getters, they decode texel x of the TMEM line at offset.
+ * i is 2 on odd lines, whose 32-bit words are swapped.
+ */
+u32 GetCI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI4IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI4IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI4RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI4RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA31_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA31_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI8IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI8IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI8RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI8RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA44_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA44_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI8_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI8_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI16_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetI16_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI16IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI16IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI16RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetCI16RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetRGBA5551_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetRGBA5551_RGBA5551(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA88_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetIA88_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetRGBA8888_RGBA8888(u16 offset, u16 x, u16 i, u8 palette);
+u32 GetRGBA8888_RGBA4444(u16 offset, u16 x, u16 i, u8 palette);
+
+/*
+ * Whole-row texel decoding.
+ * A row of a tile is decoded at once when s is neither clamped nor masked inside it.
+ * The row decoder is looked up once per texture from the per-texel getter it replaces.
+ */
+typedef void (*GetTexelRowFunc)(u16 offset, u16 i, u8 palette, u16 width, void * pDest, bool rgba8);
+
+GetTexelRowFunc GetTexelRowFor(GetTexelFunc _getTexel);
+
+// Number of texels at the start of a line that cover every s coordinate the line samples
+u16 GetTexelRowWidth(u16 width, u16 clampS, u16 maskS);
+
+// Decodes a line of width texels with s clamped to clampS and masked with maskS.
+// pRowTexels holds GetTexelRowWidth() texels when GetRow is not null.
+void GetTexelLine(GetTexelFunc GetTexel, GetTexelRowFunc GetRow, u16 offset, u16 i, u8 palette, u16 width,
+	u16 clampS, u16 maskS, void * pDest, u32 * pRowTexels, bool rgba8);
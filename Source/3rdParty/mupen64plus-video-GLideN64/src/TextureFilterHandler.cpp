@@ -67,6 +67,8 @@ u32 TextureFilterHandler::_getConfigOptions() const
 		options |= FILE_HIRESTEXCACHE;
 	if (config.textureFilter.txNoTextureFileStorage)
 		options |= FILE_NOTEXCACHE;
+	if (config.textureFilter.txHiresAsyncLoad)
+		options |= ASYNC_HIRESTEX;
 	return options;
 }
 
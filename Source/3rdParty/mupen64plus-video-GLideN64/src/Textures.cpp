@@ -5,6 +5,7 @@
 #include <chrono>         // std::chrono::seconds
 #include "Platform.h"
 #include "Textures.h"
+#include "TexelDecoders.h"
 #include "GBI.h"
 #include "RSP.h"
 #include "RDP.h"
@@ -29,238 +30,6 @@ u32 GetNone(u16 offset, u16 x, u16 i, u8 palette)
 	return 0x00000000;
 }
 
-inline u8 Get4BitPaletteColor(u16 offset, u16 x, u16 i)
-{
-	u8* tmem8 = reinterpret_cast<u8*>(TMEM);
-	return tmem8[((offset << 3) + ((x >> 1) ^ (i << 1))) & 0xFFF];
-}
-
-u32 GetCI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return CI4_RGBA8888((x & 1) ? (palette << 4) | (color4B & 0x0F) : (palette << 4) | (color4B >> 4));
-}
-
-u32 GetCI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return CI4_RGBA4444((x & 1) ? (palette << 4) | (color4B & 0x0F) : (palette << 4) | (color4B >> 4));
-}
-
-u32 GetCI4IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-
-	if (x & 1)
-		return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
-	else
-		return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI4IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-
-	if (x & 1)
-		return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
-	else
-		return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI4RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-
-	if (x & 1)
-		return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
-	else
-		return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI4RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-
-	if (x & 1)
-		return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B & 0x0F)) & 0x1FF] & 0xFFFF));
-	else
-		return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + (palette << 4) + (color4B >> 4)) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetIA31_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return IA31_RGBA8888((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
-}
-
-u32 GetIA31_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return IA31_RGBA4444((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
-}
-
-u32 GetI4_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return I4_RGBA8888((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
-}
-
-u32 GetI4_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color4B = Get4BitPaletteColor(offset, x, i);
-	return I4_RGBA4444((x & 1) ? (color4B & 0x0F) : (color4B >> 4));
-}
-
-inline u8 Get8BitPaletteColor(u16 offset, u16 x, u16 i)
-{
-	u8* tmem8 = reinterpret_cast<u8*>(TMEM);
-	return tmem8[((offset << 3) + (x ^ (i << 1))) & 0xFFF];
-}
-
-u32 GetCI8IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return IA88_RGBA4444(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI8IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return IA88_RGBA8888(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI8RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return RGBA5551_RGBA5551(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetCI8RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return RGBA5551_RGBA8888(static_cast<u16>(TMEM[(0x100 + color) & 0x1FF] & 0xFFFF));
-}
-
-u32 GetIA44_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return IA44_RGBA8888(color);
-}
-
-u32 GetIA44_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return IA44_RGBA4444(color);
-}
-
-u32 GetI8_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return I8_RGBA8888(color);
-}
-u32 GetI8_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u8 color = Get8BitPaletteColor(offset, x, i);
-	return I8_RGBA4444(color);
-}
-
-inline u16 Get16BitColor(u16 offset, u16 x, u16 i)
-{
-	u16* tmem16 = reinterpret_cast<u16*>(TMEM);
-	return tmem16[((offset << 2) + (x ^ i)) & 0x7FF];
-}
-
-u32 GetI16_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	u32 r = tex >> 8;
-	u32 g = tex & 0xFF;
-	u32 b = r;
-	u32 a = g;
-	return (a << 24) | (b << 16) | (g << 8) | r;
-}
-
-u32 GetI16_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	u16 r = tex >> 12;
-	u16 g = tex & 0x0F;
-	u16 b = r;
-	u16 a = g;
-	return (a << 12) | (b << 8) | (g << 4) | r;
-}
-
-u32 GetCI16IA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	const u16 col = (static_cast<u16>(TMEM[0x100 + (tex & 0xFF)] & 0xFFFF));
-	const u16 c = col >> 8;
-	const u16 a = col & 0xFF;
-	return (a << 24) | (c << 16) | (c << 8) | c;
-}
-
-u32 GetCI16IA_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	const u16 col = (static_cast<u16>(TMEM[0x100 + (tex & 0xFF)] & 0xFFFF));
-	const u16 c = col >> 12;
-	const u16 a = col & 0x0F;
-	return (a << 12) | (c << 8) | (c << 4) | c;
-}
-
-u32 GetCI16RGBA_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i) & 0xFF;
-	return RGBA5551_RGBA8888(((u16*)&TMEM[0x100])[tex << 2]);
-}
-
-u32 GetCI16RGBA_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i) & 0xFF;
-	return RGBA5551_RGBA5551(((u16*)&TMEM[0x100])[tex << 2]);
-}
-
-u32 GetRGBA5551_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	return RGBA5551_RGBA8888(tex);
-}
-
-u32 GetRGBA5551_RGBA5551(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	return RGBA5551_RGBA5551(tex);
-}
-
-u32 GetIA88_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	return IA88_RGBA8888(tex);
-}
-
-u32 GetIA88_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u16 tex = Get16BitColor(offset, x, i);
-	return IA88_RGBA4444(tex);
-}
-
-inline u32 Get32BitColor(u16 offset, u16 x, u16 i)
-{
-	u32* tmem32 = reinterpret_cast<u32*>(TMEM);
-	return tmem32[((offset << 1) + (x ^ i)) & 0x3FF];
-}
-
-u32 GetRGBA8888_RGBA8888(u16 offset, u16 x, u16 i, u8 palette)
-{
-	return Get32BitColor(offset, x, i);
-}
-
-u32 GetRGBA8888_RGBA4444(u16 offset, u16 x, u16 i, u8 palette)
-{
-	const u32 tex = Get32BitColor(offset, x, i);
-	return RGBA8888_RGBA4444(tex);
-}
-
 inline u32 YUV_RGBA8888(u8 y, u8 u, u8 v)
 {
 	return (0xff << 24) | (y << 16) | (v << 8) | u;
@@ -1016,9 +785,68 @@ bool TextureCache::_loadHiresBackground(CachedTexture *_pTexture, u64 & _ricecrc
 		_updateCachedTexture(ghqTexInfo, _pTexture, tile_width, tile_height);
 		return true;
 	}
+	_markHiresPending(_pTexture, _ricecrc, 0, tile_width, tile_height);
 	return false;
 }
 
+void TextureCache::_markHiresPending(CachedTexture *_pTexture, u64 _ricecrc, u64 _strongcrc, u16 widthOrg, u16 heightOrg)
+{
+	const N64FormatSize n64FmtSz(_pTexture->format, _pTexture->size);
+	if (txfilter_hirestex_pending(_ricecrc, n64FmtSz))
+		_pTexture->hiresPendingCrc = _ricecrc;
+	else if (_strongcrc != 0U && txfilter_hirestex_pending(_strongcrc, n64FmtSz))
+		_pTexture->hiresPendingCrc = _strongcrc;
+	else
+		return;
+	_pTexture->hiresPendingWidth = widthOrg;
+	_pTexture->hiresPendingHeight = heightOrg;
+}
+
+void TextureCache::_loadPendingHiresTexture(u32 _tile, CachedTexture *_pTexture)
+{
+	const N64FormatSize n64FmtSz(_pTexture->format, _pTexture->size);
+	GHQTexInfo ghqTexInfo;
+	if (!txfilter_hirestex(_pTexture->crc, _pTexture->hiresPendingCrc, nullptr, n64FmtSz, &ghqTexInfo)) {
+		// Keep the texture we have if loading failed.
+		if (!txfilter_hirestex_pending(_pTexture->hiresPendingCrc, n64FmtSz))
+			_pTexture->hiresPendingCrc = 0;
+		return;
+	}
+
+	_pTexture->hiresPendingCrc = 0;
+	if (ghqTexInfo.width == 0 || ghqTexInfo.height == 0)
+		return;
+
+	if (_pTexture->bHDTexture)
+		m_hdTexCacheSize -= _pTexture->textureBytes;
+
+	// Move the texture to the front, so that _checkHdTexLimit() keeps it.
+	Texture_Locations::iterator locations_iter = m_lruTextureLocations.find(_pTexture->crc);
+	if (locations_iter != m_lruTextureLocations.end())
+		m_textures.splice(m_textures.begin(), m_textures, locations_iter->second);
+
+	ghqTexInfo.format = gfxContext.convertInternalTextureFormat(ghqTexInfo.format);
+	Context::InitTextureParams params;
+	params.handle = _pTexture->name;
+	params.mipMapLevel = 0;
+	params.msaaLevel = 0;
+	params.width = ghqTexInfo.width;
+	params.height = ghqTexInfo.height;
+	params.internalFormat = InternalColorFormatParam(ghqTexInfo.format);
+	params.format = ColorFormatParam(ghqTexInfo.texture_format);
+	params.dataType = DatatypeParam(ghqTexInfo.pixel_type);
+	params.data = ghqTexInfo.data;
+	params.textureUnitIndex = textureIndices::Tex[_tile];
+	gfxContext.init2DTexture(params);
+	assert(!gfxContext.isError());
+
+	// Hires textures have no mipmaps, same as when loaded in place.
+	_pTexture->max_level = 0;
+	_pTexture->mipmapAtlasWidth = 0;
+	_pTexture->mipmapAtlasHeight = 0;
+	_updateCachedTexture(ghqTexInfo, _pTexture, _pTexture->hiresPendingWidth, _pTexture->hiresPendingHeight);
+}
+
 void TextureCache::_loadBackground(CachedTexture *pTexture)
 {
 	u64 ricecrc = 0;
@@ -1251,6 +1079,7 @@ bool TextureCache::_loadHiresTexture(u32 _tile, CachedTexture *_pTexture, u64 &
 		return true;
 	}
 
+	_markHiresPending(_pTexture, _ricecrc, _strongcrc, width, height);
 	return false;
 }
 
@@ -1356,20 +1185,18 @@ void TextureCache::_getTextureDestData(CachedTexture& tmptex,
 	} else {
 		j = 0;
 		const u32 tMemMask = gDP.otherMode.textureLUT == G_TT_NONE ? 0x1FF : 0xFF;
+		const bool rgba8 = glInternalFormat == internalcolorFormat::RGBA8;
+		const GetTexelRowFunc GetRow = GetTexelRowFor(GetTexel);
+		std::vector<u32> rowTexels(GetRow != nullptr ? GetTexelRowWidth(tmptex.width, clampSClamp, maskSMask) : 0);
 		for (y = 0; y < tmptex.height; ++y) {
 			ty = min(y, clampTClamp) & maskTMask;
 
 			u16 tmemOffset = (tmptex.tMem + *pLine * ty) & tMemMask;
 
 			i = (ty & 1) << 1;
-			for (x = 0; x < tmptex.width; ++x) {
-				tx = min(x, clampSClamp) & maskSMask;
-
-				if (glInternalFormat == internalcolorFormat::RGBA8)
-					pDest[j++] = GetTexel(tmemOffset, tx, i, tmptex.palette);
-				else
-					((u16*)pDest)[j++] = GetTexel(tmemOffset, tx, i, tmptex.palette);
-			}
+			GetTexelLine(GetTexel, GetRow, tmemOffset, i, tmptex.palette, tmptex.width, clampSClamp, maskSMask,
+				rgba8 ? (void*)(pDest + j) : (void*)((u16*)pDest + j), rowTexels.data(), rgba8);
+			j += tmptex.width;
 		}
 	}
 }
@@ -1833,6 +1660,19 @@ struct TextureParams
 	u32 flags;
 };
 
+// Hash of the TMEM data of the last texture looked up per tile.
+// It stays valid until TMEM is loaded again.
+struct TmemCRC
+{
+	u32 generation = 0xFFFFFFFF;
+	u32 tmem = 0;
+	u32 tMemMask = 0;
+	u32 bytes = 0;
+	bool rgba32 = false;
+	u64 crc = 0;
+};
+static TmemCRC tmemCRC[2];
+
 static
 u64 _calculateCRC(u32 _t, const TextureParams & _params, u32 _bytes)
 {
@@ -1850,12 +1690,28 @@ u64 _calculateCRC(u32 _t, const TextureParams & _params, u32 _bytes)
 	const u32 tileTmemInBytes = tMem << 3;
 	if (!rgba32 && (tileTmemInBytes + _bytes > maxBytes))
 		_bytes = maxBytes - tileTmemInBytes;
-	u64 crc = UINT64_MAX;
-	crc = CRC_Calculate(crc, src, _bytes);
+	u64 crc;
+	TmemCRC & cached = tmemCRC[_t];
+	if (cached.generation == gDP.tmemGeneration &&
+		cached.tmem == gSP.textureTile[_t]->tmem &&
+		cached.tMemMask == tMemMask &&
+		cached.bytes == _bytes &&
+		cached.rgba32 == rgba32) {
+		crc = cached.crc;
+	} else {
+		crc = CRC_Calculate(UINT64_MAX, src, _bytes);
+
+		if (rgba32) {
+			src = (u64*)&TMEM[(gSP.textureTile[_t]->tmem + 256) & 0x1FF];
+			crc = CRC_Calculate(crc, src, _bytes);
+		}
 
-	if (rgba32) {
-		src = (u64*)&TMEM[(gSP.textureTile[_t]->tmem + 256) & 0x1FF];
-		crc = CRC_Calculate(crc, src, _bytes);
+		cached.generation = gDP.tmemGeneration;
+		cached.tmem = gSP.textureTile[_t]->tmem;
+		cached.tMemMask = tMemMask;
+		cached.bytes = _bytes;
+		cached.rgba32 = rgba32;
+		cached.crc = crc;
 	}
 
 	if (gDP.otherMode.textureLUT != G_TT_NONE || gSP.textureTile[_t]->format == G_IM_FMT_CI) {
@@ -1986,6 +1842,8 @@ void TextureCache::_updateBackground()
 		currentTex.clampS = gSP.bgImage.clampS;
 		currentTex.clampT = gSP.bgImage.clampT;
 
+		if (currentTex.hiresPendingCrc != 0)
+			_loadPendingHiresTexture(0, &currentTex);
 		activateTexture(0, &currentTex);
 		m_hits++;
 		return;
@@ -2111,6 +1969,8 @@ void TextureCache::update(u32 _t)
 	const u64 crc = _calculateCRC(_t, params, sizes.bytes);
 
 	if (current[_t] != nullptr && current[_t]->crc == crc) {
+		if (current[_t]->hiresPendingCrc != 0)
+			_loadPendingHiresTexture(_t, current[_t]);
 		activateTexture(_t, current[_t]);
 		return;
 	}
@@ -2126,6 +1986,8 @@ void TextureCache::update(u32 _t)
 			assert(currentTex.format == pTile->format);
 			assert(currentTex.size == pTile->size);
 
+			if (currentTex.hiresPendingCrc != 0)
+				_loadPendingHiresTexture(_t, &currentTex);
 			activateTexture(_t, &currentTex);
 			m_hits++;
 			return;
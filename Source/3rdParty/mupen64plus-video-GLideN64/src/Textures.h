@@ -45,6 +45,9 @@ struct CachedTexture
 	u8		max_level;
 	u16		mipmapAtlasWidth{ 0 };
 	u16		mipmapAtlasHeight{ 0 };
+	u64		hiresPendingCrc{ 0 };		// Checksum of hires texture being loaded in background
+	u16		hiresPendingWidth{ 0 };
+	u16		hiresPendingHeight{ 0 };
 	enum {
 		fbNone = 0,
 		fbOneSample = 1,
@@ -93,6 +96,8 @@ private:
 	bool _loadHiresTexture(u32 _tile, CachedTexture *_pTexture, u64 & _ricecrc, u64 & _strongcrc);
 	void _loadBackground(CachedTexture *pTexture);
 	bool _loadHiresBackground(CachedTexture *_pTexture, u64 & _ricecrc);
+	void _markHiresPending(CachedTexture *_pTexture, u64 _ricecrc, u64 _strongcrc, u16 widthOrg, u16 heightOrg);
+	void _loadPendingHiresTexture(u32 _tile, CachedTexture *_pTexture);
 	void _loadDepthTexture(CachedTexture * _pTexture, u16* _pDest);
 	void _updateBackground();
 	void _initDummyTexture(CachedTexture * _pDummy);
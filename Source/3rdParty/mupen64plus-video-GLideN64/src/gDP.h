@@ -265,6 +265,7 @@ struct gDPInfo
 	u16 TexFilterPalette[512];
 	u64 paletteCRC16[16];
 	u64 paletteCRC256;
+	u32 tmemGeneration; // incremented on every TMEM load
 	u32 half_1, half_2;
 
 	gDPLoadTileInfo loadInfo[512];
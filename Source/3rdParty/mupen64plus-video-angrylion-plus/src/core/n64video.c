@@ -2,12 +2,21 @@
 #include "common.h"
 #include "msg.h"
 #include "parallel.h"
+#include "rdp_thread.h"
 
 #include <memory.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define N64VIDEO_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define N64VIDEO_NEON
+#include <arm_neon.h>
+#endif
+
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #define MAX(a, b) (((a) > (b)) ? (a) : (b))
 #define CLAMP(x, lo, hi) (((x) > (hi)) ? (hi) : (((x) < (lo)) ? (lo) : (x)))
@@ -36,11 +45,9 @@
 // maximum number of commands to buffer for parallel processing
 #define CMD_BUFFER_SIZE 1024
 
-// maximum data size of a single command in bytes
-#define CMD_MAX_SIZE 176
-
-// maximum data size of a single command in 32 bit integers
-#define CMD_MAX_INTS (CMD_MAX_SIZE / sizeof(int32_t))
+// scanlines are handed out to workers in bands of 2^n lines, so that
+// primitives can be binned to the workers owning the bands they cover
+#define CMD_BAND_SHIFT 2
 
 // extracts the command ID from a command buffer
 #define CMD_ID(cmd) ((*(cmd) >> 24) & 0x3f)
@@ -118,6 +125,12 @@ static STRICTINLINE uint32_t irand(uint32_t* state)
 static uint32_t rdp_cmd_buf[CMD_BUFFER_SIZE][CMD_MAX_INTS];
 static uint32_t rdp_cmd_buf_pos;
 
+// mask of workers that need to run each buffered command
+static uint64_t rdp_cmd_bins[CMD_BUFFER_SIZE];
+
+// command being read while the RDP thread works on the buffer
+static uint32_t rdp_cmd_stage[CMD_MAX_INTS];
+
 static uint32_t rdp_cmd_pos;
 static uint32_t rdp_cmd_id;
 static uint32_t rdp_cmd_len;
@@ -128,10 +141,63 @@ static bool rdp_cmd_sync[64];
 
 static void cmd_run_buffered(uint32_t worker_id)
 {
+    const uint64_t worker_mask = 1ULL << worker_id;
     uint32_t pos;
     for (pos = 0; pos < rdp_cmd_buf_pos; pos++) {
-        rdp_cmd(&state[worker_id], rdp_cmd_buf[pos]);
+        // primitives that don't cover a band of this worker would only
+        // rasterize invalid scanlines, so they can be skipped entirely
+        if (rdp_cmd_bins[pos] & worker_mask) {
+            rdp_cmd(&state[worker_id], rdp_cmd_buf[pos]);
+        }
+    }
+}
+
+static uint64_t cmd_bin(const uint32_t* cmd)
+{
+    const uint32_t num_workers = parallel_num_workers();
+    const uint64_t all_workers = num_workers >= 64 ? ~0ULL : (1ULL << num_workers) - 1;
+    int32_t yh, yl;
+
+    switch (CMD_ID(cmd)) {
+        case CMD_ID_FILL_TRIANGLE:
+        case CMD_ID_FILL_ZBUFFER_TRIANGLE:
+        case CMD_ID_TEXTURE_TRIANGLE:
+        case CMD_ID_TEXTURE_ZBUFFER_TRIANGLE:
+        case CMD_ID_SHADE_TRIANGLE:
+        case CMD_ID_SHADE_ZBUFFER_TRIANGLE:
+        case CMD_ID_SHADE_TEXTURE_TRIANGLE:
+        case CMD_ID_SHADE_TEXTURE_Z_BUFFER_TRIANGLE:
+            yl = SIGN(cmd[0], 14);
+            yh = SIGN(cmd[1], 14);
+            break;
+        case CMD_ID_TEXTURE_RECTANGLE:
+        case CMD_ID_TEXTURE_RECTANGLE_FLIP:
+        case CMD_ID_FILL_RECTANGLE:
+            yl = (cmd[0] & 0xfff) | 3;
+            yh = cmd[1] & 0xfff;
+            break;
+        default:
+            // state changes are needed by all workers
+            return all_workers;
+    }
+
+    // play safe with degenerate or offscreen coordinates
+    if (yh < 0 || yl < yh) {
+        return all_workers;
+    }
+
+    // the edgewalker may touch one scanline past yl
+    uint32_t band = (uint32_t)(yh >> 2) >> CMD_BAND_SHIFT;
+    uint32_t band_end = (uint32_t)((yl >> 2) + 1) >> CMD_BAND_SHIFT;
+    if (band_end - band >= num_workers) {
+        return all_workers;
+    }
+
+    uint64_t mask = 0;
+    for (; band <= band_end; band++) {
+        mask |= 1ULL << (band % num_workers);
     }
+    return mask;
 }
 
 static void cmd_flush(void)
@@ -145,6 +211,22 @@ static void cmd_flush(void)
     }
 }
 
+// runs on the RDP thread in asynchronous mode
+static void cmd_run_async(const uint32_t* cmd, uint32_t len)
+{
+    if (config.parallel) {
+        memcpy(rdp_cmd_buf[rdp_cmd_buf_pos], cmd, len * sizeof(uint32_t));
+        rdp_cmd_bins[rdp_cmd_buf_pos] = cmd_bin(cmd);
+        rdp_cmd_buf_pos++;
+
+        if (rdp_cmd_buf_pos >= CMD_BUFFER_SIZE || rdp_cmd_sync[CMD_ID(cmd)]) {
+            cmd_flush();
+        }
+    } else {
+        rdp_cmd(&state[0], cmd);
+    }
+}
+
 static void cmd_init(void)
 {
     rdp_cmd_pos = 0;
@@ -230,6 +312,11 @@ void n64video_init(struct n64video_config* _config)
         wstate->offset = 0;
         wstate->rseed = 3;
     }
+
+    if (config.dp.async) {
+        // commands are run on the RDP thread, which drives the workers
+        rdp_thread_init(cmd_run_async, cmd_flush);
+    }
 }
 
 void n64video_process_list(void)
@@ -248,7 +335,7 @@ void n64video_process_list(void)
         uint32_t i, toload;
         bool xbus_dma = (*dp_reg[DP_STATUS] & DP_STATUS_XBUS_DMA) != 0;
         uint32_t* dmem = (uint32_t*)config.gfx.dmem;
-        uint32_t* cmd_buf = rdp_cmd_buf[rdp_cmd_buf_pos];
+        uint32_t* cmd_buf = config.dp.async ? rdp_cmd_stage : rdp_cmd_buf[rdp_cmd_buf_pos];
 
         // when reading the first int, extract the command ID and update the buffer length
         if (rdp_cmd_pos == 0) {
@@ -277,8 +364,19 @@ void n64video_process_list(void)
 
         // if there's enough data for the current command...
         if (rdp_cmd_pos == rdp_cmd_len) {
-            // check if parallel processing is enabled
-            if (config.parallel) {
+            // check if asynchronous or parallel processing is enabled
+            if (config.dp.async) {
+                if (rdp_cmd_id == CMD_ID_SYNC_FULL) {
+                    // the CPU may read anything rendered so far once the
+                    // interrupt is raised, so wait for the RDP thread first
+                    rdp_thread_wait();
+
+                    // parameters are unused, so NULL is fine
+                    rdp_sync_full(NULL, NULL);
+                } else {
+                    rdp_thread_push(cmd_buf, rdp_cmd_len);
+                }
+            } else if (config.parallel) {
                 // special case: sync_full always needs to be run in main thread
                 if (rdp_cmd_id == CMD_ID_SYNC_FULL) {
                     // first, run all pending commands
@@ -287,6 +385,9 @@ void n64video_process_list(void)
                     // parameters are unused, so NULL is fine
                     rdp_sync_full(NULL, NULL);
                 } else {
+                    // bin command to the workers that need to run it
+                    rdp_cmd_bins[rdp_cmd_buf_pos] = cmd_bin(cmd_buf);
+
                     // increment buffer position
                     rdp_cmd_buf_pos++;
 
@@ -316,6 +417,7 @@ void n64video_process_list(void)
 
 void n64video_close(void)
 {
+    rdp_thread_close();
     vi_close();
     parallel_close();
 }
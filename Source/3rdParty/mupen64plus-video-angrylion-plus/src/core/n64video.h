@@ -108,6 +108,7 @@ struct n64video_config
     } vi;
     struct {
         enum dp_compat_profile compat;  // multithreading compatibility mode
+        bool async;                     // process commands on a separate thread if true
     } dp;
     bool parallel;                  // use multithreaded renderer if true
     bool busyloop;                  // use a busyloop while waiting for work
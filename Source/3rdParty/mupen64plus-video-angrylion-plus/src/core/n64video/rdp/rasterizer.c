@@ -2401,8 +2401,8 @@ static void edgewalker_for_prims(struct rdp_state* wstate, int32_t* ewdata)
                     if ((wstate->span[j].lx - wstate->span[j].rx) >= oldhb_diff)
                         wstate->last_overwriting_scanline = j;
 
-                // skip line if not assigned to this worker
-                wstate->span[j].validline &= (!wstate->stride || j % wstate->stride == wstate->offset);
+                // skip line if its band is not assigned to this worker
+                wstate->span[j].validline &= (!wstate->stride || (j >> CMD_BAND_SHIFT) % wstate->stride == wstate->offset);
             }
 
 
@@ -2494,8 +2494,8 @@ static void edgewalker_for_prims(struct rdp_state* wstate, int32_t* ewdata)
                     if ((wstate->span[j].rx - wstate->span[j].lx) >= oldhb_diff)
                         wstate->last_overwriting_scanline = j;
 
-                // skip line if not assigned to this worker
-                wstate->span[j].validline &= (!wstate->stride || j % wstate->stride == wstate->offset);
+                // skip line if its band is not assigned to this worker
+                wstate->span[j].validline &= (!wstate->stride || (j >> CMD_BAND_SHIFT) % wstate->stride == wstate->offset);
             }
 
         }
@@ -619,6 +619,9 @@ void vi_set_zbuffer_address(uint32_t address)
 
 void n64video_update_screen(struct n64video_frame_buffer* fb)
 {
+    // the VI reads what the RDP thread has rendered
+    rdp_thread_wait();
+
     // check for configuration errors
     if (config.vi.mode >= VI_MODE_NUM) {
         msg_error("Invalid VI mode: %d", config.vi.mode);
@@ -9,6 +9,26 @@ static STRICTINLINE void divot_filter(struct n64video_pixel* final, struct n64vi
         return;
     }
 
+#if defined(N64VIDEO_SSE2) || defined(N64VIDEO_NEON)
+    // the divot filter picks the median of the three components
+    uint32_t c, l, r, m;
+    memcpy(&c, &center, sizeof(c));
+    memcpy(&l, &left, sizeof(l));
+    memcpy(&r, &right, sizeof(r));
+#if defined(N64VIDEO_SSE2)
+    const __m128i cv = _mm_cvtsi32_si128(c);
+    const __m128i lv = _mm_cvtsi32_si128(l);
+    const __m128i rv = _mm_cvtsi32_si128(r);
+    m = _mm_cvtsi128_si32(_mm_max_epu8(_mm_min_epu8(lv, cv), _mm_min_epu8(_mm_max_epu8(lv, cv), rv)));
+#else
+    const uint8x8_t cv = vreinterpret_u8_u32(vdup_n_u32(c));
+    const uint8x8_t lv = vreinterpret_u8_u32(vdup_n_u32(l));
+    const uint8x8_t rv = vreinterpret_u8_u32(vdup_n_u32(r));
+    m = vget_lane_u32(vreinterpret_u32_u8(vmax_u8(vmin_u8(lv, cv), vmin_u8(vmax_u8(lv, cv), rv))), 0);
+#endif
+    memcpy(final, &m, sizeof(m));
+    final->a = center.a;
+#else
     if ((left.r >= center.r && right.r >= left.r) || (left.r >= right.r && center.r >= left.r))
         final->r = left.r;
     else if ((right.r >= center.r && left.r >= right.r) || (right.r >= left.r && center.r >= right.r))
@@ -23,6 +43,7 @@ static STRICTINLINE void divot_filter(struct n64video_pixel* final, struct n64vi
         final->b = left.b;
     else if ((right.b >= center.b && left.b >= right.b) || (right.b >= left.b && center.b >= right.b))
         final->b = right.b;
+#endif
 }
 
 #endif // N64VIDEO_C
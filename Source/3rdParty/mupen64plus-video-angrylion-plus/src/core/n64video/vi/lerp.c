@@ -2,10 +2,28 @@
 
 static STRICTINLINE void vi_vl_lerp(struct n64video_pixel* up, struct n64video_pixel down, uint32_t frac)
 {
-    uint32_t r0, g0, b0;
     if (!frac)
         return;
 
+#if defined(N64VIDEO_SSE2)
+    uint32_t u, d, res;
+    memcpy(&u, up, sizeof(u));
+    memcpy(&d, &down, sizeof(d));
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i uv = _mm_unpacklo_epi8(_mm_cvtsi32_si128(u), zero);
+    const __m128i dv = _mm_unpacklo_epi8(_mm_cvtsi32_si128(d), zero);
+    __m128i lv = _mm_mullo_epi16(_mm_sub_epi16(dv, uv), _mm_set1_epi16((int16_t)frac));
+    lv = _mm_add_epi16(_mm_srai_epi16(_mm_add_epi16(lv, _mm_set1_epi16(16)), 5), uv);
+    lv = _mm_and_si128(lv, _mm_set1_epi16(0xff));
+    res = _mm_cvtsi128_si32(_mm_packus_epi16(lv, zero));
+
+    const uint8_t a = up->a;
+    memcpy(up, &res, sizeof(res));
+    up->a = a;
+#else
+    uint32_t r0, g0, b0;
+
     r0 = up->r;
     g0 = up->g;
     b0 = up->b;
@@ -13,6 +31,7 @@ static STRICTINLINE void vi_vl_lerp(struct n64video_pixel* up, struct n64video_p
     up->r = ((((down.r - r0) * frac + 16) >> 5) + r0) & 0xff;
     up->g = ((((down.g - g0) * frac + 16) >> 5) + g0) & 0xff;
     up->b = ((((down.b - b0) * frac + 16) >> 5) + b0) & 0xff;
+#endif
 }
 
 #endif // N64VIDEO_C
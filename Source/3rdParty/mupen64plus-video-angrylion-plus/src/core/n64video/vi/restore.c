@@ -2,6 +2,32 @@
 
 static int vi_restore_table[0x400];
 
+#if defined(N64VIDEO_SSE2) || defined(N64VIDEO_NEON)
+// sum of vi_restore_table entries for eight 5 bit neighbour components
+// around the 5 bit center component, as 16 bit lanes
+#if defined(N64VIDEO_SSE2)
+static STRICTINLINE int restore_sum(__m128i neighbours, int center)
+{
+    const __m128i c = _mm_set1_epi16((int16_t)((center >> 3) & 0x1f));
+    __m128i d = _mm_sub_epi16(_mm_cmpgt_epi16(c, neighbours), _mm_cmpgt_epi16(neighbours, c));
+    d = _mm_madd_epi16(d, _mm_set1_epi16(1));
+    d = _mm_add_epi32(d, _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+    d = _mm_add_epi32(d, _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(d);
+}
+#else
+static STRICTINLINE int restore_sum(int16x8_t neighbours, int center)
+{
+    const int16x8_t c = vdupq_n_s16((int16_t)((center >> 3) & 0x1f));
+    int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vcltq_s16(neighbours, c)), vreinterpretq_s16_u16(vcgtq_s16(neighbours, c)));
+    int16x4_t s = vadd_s16(vget_low_s16(d), vget_high_s16(d));
+    s = vpadd_s16(s, s);
+    s = vpadd_s16(s, s);
+    return vget_lane_s16(s, 0);
+}
+#endif
+#endif
+
 static STRICTINLINE void restore_filter16(int* r, int* g, int* b, uint32_t fboffset, uint32_t num, uint32_t hres, uint32_t fetchbugstate)
 {
     int i;
@@ -27,12 +53,7 @@ static STRICTINLINE void restore_filter16(int* r, int* g, int* b, uint32_t fboff
     int rend = *r;
     int gend = *g;
     int bend = *b;
-    const int* redptr = &vi_restore_table[(rend << 2) & 0x3e0];
-    const int* greenptr = &vi_restore_table[(gend << 2) & 0x3e0];
-    const int* blueptr = &vi_restore_table[(bend << 2) & 0x3e0];
-
-    uint32_t tempr, tempg, tempb;
-    uint16_t pix;
+    uint16_t pix[8];
 
     const uint32_t dirs[] =
     {
@@ -43,30 +64,39 @@ static STRICTINLINE void restore_filter16(int* r, int* g, int* b, uint32_t fboff
     if (rdram_valid_idx16(maxpix) && rdram_valid_idx16(leftuppix))
     {
         for (i = 0; i < 8; i++)
-        {
-            pix = rdram_read_idx16_fast(dirs[i]);
-            tempr = (pix >> 11) & 0x1f;
-            tempg = (pix >> 6) & 0x1f;
-            tempb = (pix >> 1) & 0x1f;
-            rend += redptr[tempr];
-            gend += greenptr[tempg];
-            bend += blueptr[tempb];
-        }
+            pix[i] = rdram_read_idx16_fast(dirs[i]);
     }
     else
     {
         for (i = 0; i < 8; i++)
-        {
-            pix = rdram_read_idx16(dirs[i]);
-            tempr = (pix >> 11) & 0x1f;
-            tempg = (pix >> 6) & 0x1f;
-            tempb = (pix >> 1) & 0x1f;
-            rend += redptr[tempr];
-            gend += greenptr[tempg];
-            bend += blueptr[tempb];
-        }
+            pix[i] = rdram_read_idx16(dirs[i]);
     }
 
+#if defined(N64VIDEO_SSE2)
+    const __m128i mask = _mm_set1_epi16(0x1f);
+    const __m128i pixv = _mm_loadu_si128((const __m128i*)pix);
+    rend += restore_sum(_mm_and_si128(_mm_srli_epi16(pixv, 11), mask), *r);
+    gend += restore_sum(_mm_and_si128(_mm_srli_epi16(pixv, 6), mask), *g);
+    bend += restore_sum(_mm_and_si128(_mm_srli_epi16(pixv, 1), mask), *b);
+#elif defined(N64VIDEO_NEON)
+    const uint16x8_t mask = vdupq_n_u16(0x1f);
+    const uint16x8_t pixv = vld1q_u16(pix);
+    rend += restore_sum(vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(pixv, 11), mask)), *r);
+    gend += restore_sum(vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(pixv, 6), mask)), *g);
+    bend += restore_sum(vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(pixv, 1), mask)), *b);
+#else
+    const int* redptr = &vi_restore_table[(rend << 2) & 0x3e0];
+    const int* greenptr = &vi_restore_table[(gend << 2) & 0x3e0];
+    const int* blueptr = &vi_restore_table[(bend << 2) & 0x3e0];
+
+    for (i = 0; i < 8; i++)
+    {
+        rend += redptr[(pix[i] >> 11) & 0x1f];
+        gend += greenptr[(pix[i] >> 6) & 0x1f];
+        bend += blueptr[(pix[i] >> 1) & 0x1f];
+    }
+#endif
+
 
     *r = rend;
     *g = gend;
@@ -98,12 +128,7 @@ static STRICTINLINE void restore_filter32(int* r, int* g, int* b, uint32_t fboff
     int rend = *r;
     int gend = *g;
     int bend = *b;
-    const int* redptr = &vi_restore_table[(rend << 2) & 0x3e0];
-    const int* greenptr = &vi_restore_table[(gend << 2) & 0x3e0];
-    const int* blueptr = &vi_restore_table[(bend << 2) & 0x3e0];
-
-    uint32_t tempr, tempg, tempb;
-    uint32_t pix;
+    uint32_t pix[8];
 
     const uint32_t dirs[] =
     {
@@ -114,29 +139,40 @@ static STRICTINLINE void restore_filter32(int* r, int* g, int* b, uint32_t fboff
     if (rdram_valid_idx32(maxpix) && rdram_valid_idx32(leftuppix))
     {
         for (i = 0; i < 8; i++)
-        {
-            pix = rdram_read_idx32_fast(dirs[i]);
-            tempr = (pix >> 27) & 0x1f;
-            tempg = (pix >> 19) & 0x1f;
-            tempb = (pix >> 11) & 0x1f;
-            rend += redptr[tempr];
-            gend += greenptr[tempg];
-            bend += blueptr[tempb];
-        }
+            pix[i] = rdram_read_idx32_fast(dirs[i]);
     }
     else
     {
         for (i = 0; i < 8; i++)
-        {
-            pix = rdram_read_idx32(dirs[i]);
-            tempr = (pix >> 27) & 0x1f;
-            tempg = (pix >> 19) & 0x1f;
-            tempb = (pix >> 11) & 0x1f;
-            rend += redptr[tempr];
-            gend += greenptr[tempg];
-            bend += blueptr[tempb];
-        }
+            pix[i] = rdram_read_idx32(dirs[i]);
+    }
+
+#if defined(N64VIDEO_SSE2)
+    const __m128i mask = _mm_set1_epi32(0x1f);
+    const __m128i pixlo = _mm_loadu_si128((const __m128i*)&pix[0]);
+    const __m128i pixhi = _mm_loadu_si128((const __m128i*)&pix[4]);
+    rend += restore_sum(_mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(pixlo, 27), mask), _mm_and_si128(_mm_srli_epi32(pixhi, 27), mask)), *r);
+    gend += restore_sum(_mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(pixlo, 19), mask), _mm_and_si128(_mm_srli_epi32(pixhi, 19), mask)), *g);
+    bend += restore_sum(_mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(pixlo, 11), mask), _mm_and_si128(_mm_srli_epi32(pixhi, 11), mask)), *b);
+#elif defined(N64VIDEO_NEON)
+    const uint32x4_t mask = vdupq_n_u32(0x1f);
+    const uint32x4_t pixlo = vld1q_u32(&pix[0]);
+    const uint32x4_t pixhi = vld1q_u32(&pix[4]);
+    rend += restore_sum(vcombine_s16(vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixlo, 27), mask))), vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixhi, 27), mask)))), *r);
+    gend += restore_sum(vcombine_s16(vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixlo, 19), mask))), vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixhi, 19), mask)))), *g);
+    bend += restore_sum(vcombine_s16(vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixlo, 11), mask))), vmovn_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixhi, 11), mask)))), *b);
+#else
+    const int* redptr = &vi_restore_table[(rend << 2) & 0x3e0];
+    const int* greenptr = &vi_restore_table[(gend << 2) & 0x3e0];
+    const int* blueptr = &vi_restore_table[(bend << 2) & 0x3e0];
+
+    for (i = 0; i < 8; i++)
+    {
+        rend += redptr[(pix[i] >> 27) & 0x1f];
+        gend += greenptr[(pix[i] >> 19) & 0x1f];
+        bend += blueptr[(pix[i] >> 11) & 0x1f];
     }
+#endif
 
     *r = rend;
     *g = gend;
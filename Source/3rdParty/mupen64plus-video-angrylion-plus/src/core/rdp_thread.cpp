@@ -0,0 +1,155 @@
+#include "rdp_thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs RDP commands on a dedicated thread. Commands are passed through a
+// single producer, single consumer ring buffer, so the emulation thread only
+// has to block when the ring is full or when it waits for the RDP to finish.
+class RdpThread
+{
+public:
+    RdpThread(void run(const uint32_t*, uint32_t), void idle(void)) :
+        m_run(run), m_idle(idle), m_buffer(BUFFER_SIZE)
+    {
+        m_thread = std::thread(&RdpThread::do_work, this);
+    }
+
+    ~RdpThread()
+    {
+        // finish all queued commands before exiting
+        wait();
+
+        {
+            std::unique_lock<std::mutex> ul(m_signal_mutex);
+            m_exit = true;
+        }
+        m_signal_work.notify_one();
+
+        m_thread.join();
+    }
+
+    void push(const uint32_t* cmd, uint32_t len)
+    {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+        // wait for the RDP thread to free enough space
+        while (BUFFER_SIZE - (head - m_tail.load(std::memory_order_acquire)) < len + 1) {
+            std::this_thread::yield();
+        }
+
+        m_buffer[head & BUFFER_MASK] = len;
+        for (uint32_t i = 0; i < len; i++) {
+            m_buffer[(head + 1 + i) & BUFFER_MASK] = cmd[i];
+        }
+        m_head.store(head + len + 1);
+
+        // only take the lock if the RDP thread went to sleep
+        if (m_sleeping.load()) {
+            std::unique_lock<std::mutex> ul(m_signal_mutex);
+            m_signal_work.notify_one();
+        }
+    }
+
+    void wait()
+    {
+        const uint32_t head = m_head.load();
+
+        std::unique_lock<std::mutex> ul(m_signal_mutex);
+        m_signal_idle.wait(ul, [this, head] {
+            return m_sleeping.load() && m_done == head;
+        });
+    }
+
+private:
+    // ring buffer size in 32 bit words, must be a power of two
+    static const uint32_t BUFFER_SIZE = 1 << 20;
+    static const uint32_t BUFFER_MASK = BUFFER_SIZE - 1;
+
+    void (*m_run)(const uint32_t*, uint32_t);
+    void (*m_idle)(void);
+    std::vector<uint32_t> m_buffer;
+    std::atomic<uint32_t> m_head{0};
+    std::atomic<uint32_t> m_tail{0};
+    std::atomic<bool> m_sleeping{false};
+    uint32_t m_done = 0;
+    bool m_exit = false;
+    std::thread m_thread;
+    std::mutex m_signal_mutex;
+    std::condition_variable m_signal_work;
+    std::condition_variable m_signal_idle;
+
+    void do_work()
+    {
+        uint32_t cmd[CMD_MAX_INTS];
+
+        while (true) {
+            const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+            if (tail == m_head.load()) {
+                // queue is drained, finish buffered work before going to sleep
+                m_idle();
+
+                std::unique_lock<std::mutex> ul(m_signal_mutex);
+                m_done = tail;
+                m_sleeping.store(true);
+                m_signal_idle.notify_all();
+
+                m_signal_work.wait(ul, [this, tail] {
+                    return m_head.load() != tail || m_exit;
+                });
+                m_sleeping.store(false);
+
+                if (m_head.load() == tail) {
+                    return;
+                }
+                continue;
+            }
+
+            uint32_t len = m_buffer[tail & BUFFER_MASK];
+            if (len > CMD_MAX_INTS) {
+                len = CMD_MAX_INTS;
+            }
+            for (uint32_t i = 0; i < len; i++) {
+                cmd[i] = m_buffer[(tail + 1 + i) & BUFFER_MASK];
+            }
+
+            m_run(cmd, len);
+
+            m_tail.store(tail + m_buffer[tail & BUFFER_MASK] + 1, std::memory_order_release);
+        }
+    }
+
+    void operator=(const RdpThread&) = delete;
+    RdpThread(const RdpThread&) = delete;
+};
+
+// C interface for the RdpThread class
+static std::unique_ptr<RdpThread> rdp_thread;
+
+void rdp_thread_init(void run(const uint32_t*, uint32_t), void idle(void))
+{
+    rdp_thread = std::make_unique<RdpThread>(run, idle);
+}
+
+void rdp_thread_push(const uint32_t* cmd, uint32_t len)
+{
+    rdp_thread->push(cmd, len);
+}
+
+void rdp_thread_wait(void)
+{
+    if (rdp_thread) {
+        rdp_thread->wait();
+    }
+}
+
+void rdp_thread_close(void)
+{
+    rdp_thread.reset();
+}
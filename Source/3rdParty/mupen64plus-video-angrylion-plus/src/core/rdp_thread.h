@@ -0,0 +1,23 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// maximum data size of a single command in bytes
+#define CMD_MAX_SIZE 176
+
+// maximum data size of a single command in 32 bit integers
+#define CMD_MAX_INTS (CMD_MAX_SIZE / sizeof(int32_t))
+
+void rdp_thread_init(void run(const uint32_t*, uint32_t), void idle(void));
+void rdp_thread_push(const uint32_t* cmd, uint32_t len);
+void rdp_thread_wait(void);
+void rdp_thread_close(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -51,6 +51,7 @@ MainDialog::MainDialog(QWidget* parent) : QDialog(parent)
 
     this->parallelCheckBox->setChecked(ConfigGetParamBool(configVideoAngrylionPlus, KEY_PARALLEL));
     this->busyLoopCheckBox->setChecked(ConfigGetParamBool(configVideoAngrylionPlus, KEY_BUSY_LOOP));
+    this->dpAsyncCheckBox->setChecked(ConfigGetParamBool(configVideoAngrylionPlus, KEY_DP_ASYNC));
 
     this->viWidescreenCheckBox->setChecked(ConfigGetParamBool(configVideoAngrylionPlus, KEY_VI_WIDESCREEN));
     this->viHideOverscanCheckBox->setChecked(ConfigGetParamBool(configVideoAngrylionPlus, KEY_VI_HIDE_OVERSCAN));
@@ -96,6 +97,7 @@ void MainDialog::on_buttonBox_clicked(QAbstractButton* button)
         // checkboxes
         int parallelValue = this->parallelCheckBox->isChecked() ? 1 : 0;
         int busyLoopValue = this->busyLoopCheckBox->isChecked() ? 1 : 0;
+        int dpAsyncValue = this->dpAsyncCheckBox->isChecked() ? 1 : 0;
 
         int viWidescreenValue = this->viWidescreenCheckBox->isChecked() ? 1 : 0;
         int viHideOverscanValue = this->viHideOverscanCheckBox->isChecked() ? 1 : 0;
@@ -104,6 +106,7 @@ void MainDialog::on_buttonBox_clicked(QAbstractButton* button)
 
         ConfigSetParameter(configVideoAngrylionPlus, KEY_PARALLEL, M64TYPE_BOOL, &parallelValue);
         ConfigSetParameter(configVideoAngrylionPlus, KEY_BUSY_LOOP, M64TYPE_BOOL, &busyLoopValue);
+        ConfigSetParameter(configVideoAngrylionPlus, KEY_DP_ASYNC, M64TYPE_BOOL, &dpAsyncValue);
 
         ConfigSetParameter(configVideoAngrylionPlus, KEY_VI_WIDESCREEN, M64TYPE_BOOL, &viWidescreenValue);
         ConfigSetParameter(configVideoAngrylionPlus, KEY_VI_HIDE_OVERSCAN, M64TYPE_BOOL, &viHideOverscanValue);
@@ -124,6 +127,7 @@ void MainDialog::on_buttonBox_clicked(QAbstractButton* button)
         this->dpCompatComboBox->setCurrentIndex(config.dp.compat);
         this->parallelCheckBox->setChecked(config.parallel);
         this->busyLoopCheckBox->setChecked(config.busyloop);
+        this->dpAsyncCheckBox->setChecked(config.dp.async);
         this->viWidescreenCheckBox->setChecked(config.vi.widescreen);
         this->viHideOverscanCheckBox->setChecked(config.vi.hide_overscan);
         this->viIntegerScalingCheckBox->setChecked(config.vi.integer_scaling);
@@ -108,6 +108,7 @@ EXPORT m64p_error CALL PluginStartup(m64p_dynlib_handle _CoreLibHandle, void *Co
     ConfigSetDefaultBool(configVideoAngrylionPlus, KEY_VI_INTEGER_SCALING, config.vi.integer_scaling, "Display upscaled pixels as groups of 1x1, 2x2, 3x3, etc. if True");
     ConfigSetDefaultBool(configVideoAngrylionPlus, KEY_VI_VSYNC, config.vi.vsync, "Enable vsync to prevent tearing");
     ConfigSetDefaultInt(configVideoAngrylionPlus, KEY_DP_COMPAT, config.dp.compat, "Compatibility mode (0=Fast 1=Moderate 2=Slow");
+    ConfigSetDefaultBool(configVideoAngrylionPlus, KEY_DP_ASYNC, config.dp.async, "Process RDP commands on a separate thread if True");
 
     ConfigSaveSection("Video-AngrylionPlus");
 
@@ -214,6 +215,7 @@ EXPORT int CALL RomOpen (void)
     config.vi.vsync = ConfigGetParamBool(configVideoAngrylionPlus, KEY_VI_VSYNC);
 
     config.dp.compat = (dp_compat_profile)ConfigGetParamInt(configVideoAngrylionPlus, KEY_DP_COMPAT);
+    config.dp.async = ConfigGetParamBool(configVideoAngrylionPlus, KEY_DP_ASYNC);
 
     config.gfx.rdram = gfx.RDRAM;
 
@@ -43,3 +43,4 @@ extern ptr_PluginGetVersion       CoreGetVersion;
 
 
 #define KEY_DP_COMPAT "DpCompat"
+#define KEY_DP_ASYNC "DpAsync"
@@ -11,12 +11,15 @@
 #include "Directories.hpp"
 #include "RomSettings.hpp"
 #include "RomHeader.hpp"
+#include "Trace.hpp"
 #include "File.hpp"
 
+#include <unordered_map>
 #include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <vector>
+#include <mutex>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -64,9 +67,15 @@ struct l_CacheEntry
 // Local Variables
 //
 
+static std::once_flag            l_CacheEntriesRead;
 static bool                      l_CacheEntriesChanged = false;
 static std::vector<l_CacheEntry> l_CacheEntries;
 
+// index of the cache entry for each file name,
+// to prevent having to search all entries
+// for every ROM in the ROM browser
+static std::unordered_map<std::filesystem::path::string_type, size_t> l_CacheEntryIndexes;
+
 //
 // Internal Functions
 //
@@ -82,24 +91,40 @@ static std::filesystem::path get_cache_file_name()
     return file;
 }
 
+static void update_cache_entry_indexes(void)
+{
+    l_CacheEntryIndexes.clear();
+
+    for (size_t i = 0; i < l_CacheEntries.size(); i++)
+    {
+        l_CacheEntryIndexes[l_CacheEntries[i].fileName.native()] = i;
+    }
+}
+
 static std::vector<l_CacheEntry>::iterator get_cache_entry_iter(std::filesystem::path file, bool checkFileTime = true)
 {
-    CoreFileTime fileTime = CoreGetFileTime(file);
+    auto indexIter = l_CacheEntryIndexes.find(file.native());
+    if (indexIter == l_CacheEntryIndexes.end())
+    {
+        return l_CacheEntries.end();
+    }
 
-    auto predicate = [file, fileTime, checkFileTime](const auto& entry)
+    auto iter = l_CacheEntries.begin() + indexIter->second;
+    if (checkFileTime && (*iter).fileTime != CoreGetFileTime(file))
     {
-        return entry.fileName == file &&
-                (!checkFileTime || entry.fileTime == fileTime);
-    };
+        return l_CacheEntries.end();
+    }
 
-    return std::find_if(l_CacheEntries.begin(), l_CacheEntries.end(), predicate);
+    return iter;
 }
 
-//
-// Exported Functions
-//
+static void erase_cache_entry(std::vector<l_CacheEntry>::iterator iter)
+{
+    l_CacheEntries.erase(iter);
+    update_cache_entry_indexes();
+}
 
-void CoreReadRomHeaderAndSettingsCache(void)
+static void read_cache_file(void)
 {
     std::ifstream inputStream;
     char magicBuf[sizeof(CACHE_FILE_MAGIC)];
@@ -175,6 +200,24 @@ void CoreReadRomHeaderAndSettingsCache(void)
 #undef FREAD_STR
 
     inputStream.close();
+
+    update_cache_entry_indexes();
+}
+
+//
+// Exported Functions
+//
+
+void CoreReadRomHeaderAndSettingsCache(void)
+{
+    // only read the cache file once, either
+    // on first use or when explicitly requested
+    std::call_once(l_CacheEntriesRead, []
+    {
+        CoreTraceTime traceStart = CoreTraceBegin();
+        read_cache_file();
+        CoreTraceEnd("ROM Cache Load", traceStart);
+    });
 }
 
 bool CoreSaveRomHeaderAndSettingsCache(void)
@@ -265,6 +308,8 @@ bool CoreSaveRomHeaderAndSettingsCache(void)
 
 bool CoreGetCachedRomHeaderAndSettings(std::filesystem::path file, CoreRomType& type, CoreRomHeader& header, CoreRomSettings& settings)
 {
+    CoreReadRomHeaderAndSettingsCache();
+
     bool ret = false;
     auto iter = get_cache_entry_iter(file);
     if (iter == l_CacheEntries.end())
@@ -304,16 +349,18 @@ bool CoreAddCachedRomHeaderAndSettings(std::filesystem::path file, CoreRomType t
 {
     l_CacheEntry cacheEntry;
 
+    CoreReadRomHeaderAndSettingsCache();
+
     // try to find existing entry with same filename,
     // when found, remove it from the cache
     auto iter = get_cache_entry_iter(file, false);
     if (iter != l_CacheEntries.end())
     {
-        l_CacheEntries.erase(iter);
+        erase_cache_entry(iter);
     }
     else if (l_CacheEntries.size() >= CACHE_FILE_ITEMS_MAX)
     { // delete first item when we're over the item limit
-        l_CacheEntries.erase(l_CacheEntries.begin());
+        erase_cache_entry(l_CacheEntries.begin());
     }
 
     cacheEntry.fileName = file;
@@ -323,6 +370,7 @@ bool CoreAddCachedRomHeaderAndSettings(std::filesystem::path file, CoreRomType t
     cacheEntry.settings = settings;
 
     l_CacheEntries.push_back(cacheEntry);
+    l_CacheEntryIndexes[file.native()] = l_CacheEntries.size() - 1;
     l_CacheEntriesChanged = true;
     return true;
 }
@@ -334,6 +382,8 @@ bool CoreUpdateCachedRomHeaderAndSettings(std::filesystem::path file)
     CoreRomHeader header;
     CoreRomSettings settings;
 
+    CoreReadRomHeaderAndSettingsCache();
+
     // try to find existing entry with same filename,
     // when not found, do nothing
     auto iter = get_cache_entry_iter(file, false);
@@ -377,7 +427,12 @@ bool CoreUpdateCachedRomHeaderAndSettings(std::filesystem::path file)
 
 bool CoreClearRomHeaderAndSettingsCache(void)
 {
+    // make sure the cache file isn't
+    // read after clearing the entries
+    CoreReadRomHeaderAndSettingsCache();
+
     l_CacheEntries.clear();
+    l_CacheEntryIndexes.clear();
     l_CacheEntriesChanged = true;
     return true;
 }
@@ -11,16 +11,74 @@
 #include "ConvertStringEncoding.hpp"
 #include "Callback.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <cstring>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+//
+// Local Defines
+//
+
+// size of the debug message buffer of each thread,
+// when it's full, new messages are dropped
+#define DEBUG_MESSAGE_BUFFER_SIZE (128 * 1024)
+
+// maximum size of a single debug message,
+// longer messages are truncated
+#define DEBUG_MESSAGE_SIZE_MAX (DEBUG_MESSAGE_BUFFER_SIZE / 8)
+
+#define DEBUG_MESSAGE_ALIGN(x) (((x) + 7) & ~(size_t)7)
+
+// level of the record which fills the space at the
+// end of the buffer when a message doesn't fit there
+#define DEBUG_MESSAGE_LEVEL_PADDING -1
 
 //
 // Local Structs
 //
 
+struct l_DebugMessageHeader
+{
+    uint64_t    Sequence;
+    const char* Context;
+    int32_t     Level;
+    uint32_t    MessageSize;
+};
+
+// single producer single consumer ring buffer,
+// the thread which owns it writes messages to it
+// and CoreProcessDebugCallbacks() reads them
+struct l_DebugMessageBuffer
+{
+    std::atomic<uint64_t> Head    = 0;
+    std::atomic<uint64_t> Tail    = 0;
+    std::atomic<uint64_t> Dropped = 0;
+    std::atomic<bool>     Orphaned = false;
+    alignas(8) char       Data[DEBUG_MESSAGE_BUFFER_SIZE];
+};
+
+struct l_DebugMessageBufferOwner
+{
+    l_DebugMessageBuffer* Buffer = nullptr;
+
+    ~l_DebugMessageBufferOwner()
+    {
+        // the buffer is freed once it has been read
+        if (this->Buffer != nullptr)
+        {
+            this->Buffer->Orphaned.store(true, std::memory_order_release);
+        }
+    }
+};
+
 struct l_DebugCallbackMessage
 {
-    std::string Context;
-    int         Level = 0;
+    uint64_t    Sequence;
+    const char* Context;
+    int         Level;
     std::string Message;
 };
 
@@ -32,40 +90,133 @@ static bool l_SetupCallbacks = false;
 static std::function<void(enum CoreDebugMessageType, std::string, std::string)> l_DebugCallbackFunc;
 static std::function<void(enum CoreStateCallbackType, int)> l_StateCallbackFunc;
 static bool l_PrintCallbacks = false;
-static std::vector<l_DebugCallbackMessage> l_PendingCallbacks;
+static std::atomic<bool> l_VerboseCallbacks = true;
 
+static std::atomic<uint64_t>              l_DebugMessageSequence = 0;
+static std::mutex                         l_DebugMessageBuffersMutex;
+static std::vector<l_DebugMessageBuffer*> l_DebugMessageBuffers;
+static thread_local l_DebugMessageBufferOwner l_ThreadDebugMessageBuffer;
 
 //
-// Internal Functions
+// Local Functions
 //
 
-void CoreDebugCallback(void* context, int level, const char* message)
+static l_DebugMessageBuffer* get_thread_debug_message_buffer(void)
 {
-    std::string contextString((const char*)context);
-    std::string messageString(message);
+    if (l_ThreadDebugMessageBuffer.Buffer == nullptr)
+    {
+        l_DebugMessageBuffer* buffer = new l_DebugMessageBuffer();
 
-    if (!l_SetupCallbacks)
+        std::lock_guard<std::mutex> guard(l_DebugMessageBuffersMutex);
+        l_DebugMessageBuffers.push_back(buffer);
+        l_ThreadDebugMessageBuffer.Buffer = buffer;
+    }
+
+    return l_ThreadDebugMessageBuffer.Buffer;
+}
+
+static void write_debug_message(const char* context, int level, const char* message)
+{
+    l_DebugMessageBuffer* buffer = get_thread_debug_message_buffer();
+    l_DebugMessageHeader header;
+
+    header.Sequence    = l_DebugMessageSequence.fetch_add(1, std::memory_order_relaxed);
+    header.Context     = context;
+    header.Level       = level;
+    header.MessageSize = std::min(strlen(message), (size_t)DEBUG_MESSAGE_SIZE_MAX);
+
+    const size_t messageSize = DEBUG_MESSAGE_ALIGN(sizeof(header) + header.MessageSize);
+    const uint64_t head = buffer->Head.load(std::memory_order_relaxed);
+    const uint64_t tail = buffer->Tail.load(std::memory_order_acquire);
+    const size_t offset = head % DEBUG_MESSAGE_BUFFER_SIZE;
+    const size_t spaceAtEnd = DEBUG_MESSAGE_BUFFER_SIZE - offset;
+    const size_t paddingSize = spaceAtEnd < messageSize ? spaceAtEnd : 0;
+
+    // never wait for the reader, drop the message instead
+    if (DEBUG_MESSAGE_BUFFER_SIZE - (head - tail) < paddingSize + messageSize)
     {
-        l_PendingCallbacks.push_back({contextString, level, message});
+        buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
         return;
     }
 
-    if (l_PrintCallbacks)
+    // messages are stored contiguously, so when it doesn't
+    // fit at the end, skip to the start of the buffer, when
+    // there's no space for a header either, the reader
+    // skips to the start by itself
+    if (paddingSize >= sizeof(l_DebugMessageHeader))
+    {
+        l_DebugMessageHeader padding = {};
+        padding.Level = DEBUG_MESSAGE_LEVEL_PADDING;
+        std::memcpy(buffer->Data + offset, &padding, sizeof(padding));
+    }
+
+    char* data = buffer->Data + ((head + paddingSize) % DEBUG_MESSAGE_BUFFER_SIZE);
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), message, header.MessageSize);
+
+    buffer->Head.store(head + paddingSize + messageSize, std::memory_order_release);
+}
+
+static void read_debug_messages(l_DebugMessageBuffer* buffer, std::vector<l_DebugCallbackMessage>& messages)
+{
+    uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+    const uint64_t head = buffer->Head.load(std::memory_order_acquire);
+    l_DebugMessageHeader header;
+
+    while (tail != head)
     {
-        std::cout << contextString << messageString << std::endl;
+        const size_t offset = tail % DEBUG_MESSAGE_BUFFER_SIZE;
+        const size_t spaceAtEnd = DEBUG_MESSAGE_BUFFER_SIZE - offset;
+        if (spaceAtEnd < sizeof(header))
+        {
+            tail += spaceAtEnd;
+            continue;
+        }
+
+        const char* data = buffer->Data + offset;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.Level == DEBUG_MESSAGE_LEVEL_PADDING)
+        {
+            tail += spaceAtEnd;
+            continue;
+        }
+
+        messages.push_back(
+        {
+            header.Sequence,
+            header.Context,
+            header.Level,
+            std::string(data + sizeof(header), header.MessageSize)
+        });
+
+        tail += DEBUG_MESSAGE_ALIGN(sizeof(header) + header.MessageSize);
     }
 
-    // convert string encoding accordingly
-    if (messageString.starts_with("IS64:"))
+    buffer->Tail.store(tail, std::memory_order_release);
+}
+
+//
+// Internal Functions
+//
+
+void CoreDebugCallback(void* context, int level, const char* message)
+{
+    if (l_PrintCallbacks)
     {
-        messageString = CoreConvertStringEncoding(message, CoreStringEncoding::EUC_JP);
+        std::cout << (const char*)context << message << std::endl;
     }
-    else if (contextString.starts_with("[CORE]"))
+
+    // drop verbose messages early when they aren't shown
+    if (level == (int)CoreDebugMessageType::Verbose &&
+        !l_VerboseCallbacks.load(std::memory_order_relaxed))
     {
-        messageString = CoreConvertStringEncoding(message, CoreStringEncoding::Shift_JIS);
+        return;
     }
 
-    l_DebugCallbackFunc((CoreDebugMessageType)level, contextString, messageString);
+    // the context is a static string,
+    // so only its pointer is stored
+    write_debug_message((const char*)context, level, message);
 }
 
 void CoreStateCallback(void* context, m64p_core_param param, int value)
@@ -88,15 +239,76 @@ bool CoreSetupCallbacks(std::function<void(enum CoreDebugMessageType, std::strin
     l_DebugCallbackFunc = debugCallbackFunc;
     l_StateCallbackFunc = stateCallbackFunc;
     l_SetupCallbacks = true;
-    
-    // send pending messages
-    for (const auto& callback : l_PendingCallbacks)
+    return true;
+}
+
+void CoreProcessDebugCallbacks(void)
+{
+    std::vector<l_DebugCallbackMessage> messages;
+    uint64_t droppedMessages = 0;
+
+    if (!l_SetupCallbacks)
     {
-        CoreDebugCallback((void*)callback.Context.c_str(), callback.Level, callback.Message.c_str());
+        return;
     }
-    l_PendingCallbacks.clear();
 
-    return true;
+    {
+        std::lock_guard<std::mutex> guard(l_DebugMessageBuffersMutex);
+
+        for (auto iter = l_DebugMessageBuffers.begin(); iter != l_DebugMessageBuffers.end();)
+        {
+            l_DebugMessageBuffer* buffer = (*iter);
+
+            // when the thread has exited, it won't
+            // write any messages anymore, so the buffer
+            // can be freed after reading it
+            bool orphaned = buffer->Orphaned.load(std::memory_order_acquire);
+
+            read_debug_messages(buffer, messages);
+            droppedMessages += buffer->Dropped.exchange(0, std::memory_order_relaxed);
+
+            if (orphaned)
+            {
+                delete buffer;
+                iter = l_DebugMessageBuffers.erase(iter);
+            }
+            else
+            {
+                iter++;
+            }
+        }
+    }
+
+    // messages of different threads are
+    // put back into the order they were sent in
+    std::sort(messages.begin(), messages.end(), [](const auto& a, const auto& b)
+    {
+        return a.Sequence < b.Sequence;
+    });
+
+    for (const auto& message : messages)
+    {
+        std::string contextString(message.Context);
+        std::string messageString(message.Message);
+
+        // convert string encoding accordingly
+        if (messageString.starts_with("IS64:"))
+        {
+            messageString = CoreConvertStringEncoding(messageString, CoreStringEncoding::EUC_JP);
+        }
+        else if (contextString.starts_with("[CORE]"))
+        {
+            messageString = CoreConvertStringEncoding(messageString, CoreStringEncoding::Shift_JIS);
+        }
+
+        l_DebugCallbackFunc((CoreDebugMessageType)message.Level, contextString, messageString);
+    }
+
+    if (droppedMessages != 0)
+    {
+        l_DebugCallbackFunc(CoreDebugMessageType::Warning, "[GUI]   ",
+            "Dropped " + std::to_string(droppedMessages) + " debug messages because they were sent too quickly");
+    }
 }
 
 void CoreSetPrintDebugCallback(bool enabled)
@@ -104,6 +316,11 @@ void CoreSetPrintDebugCallback(bool enabled)
     l_PrintCallbacks = enabled;
 }
 
+void CoreSetVerboseDebugCallback(bool enabled)
+{
+    l_VerboseCallbacks.store(enabled, std::memory_order_relaxed);
+}
+
 void CoreAddCallbackMessage(CoreDebugMessageType type, std::string message)
 {
     CoreDebugCallback((void*)"[GUI]   ", (int)type, message.c_str());
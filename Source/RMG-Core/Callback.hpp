@@ -52,9 +52,19 @@ enum class CoreStateCallbackType
 bool CoreSetupCallbacks(std::function<void(enum CoreDebugMessageType, std::string, std::string)> debugCallbackFunc,
                         std::function<void(enum CoreStateCallbackType, int)> stateCallbackFunc);
 
+// calls the debug callback with the debug messages which have
+// been sent since the last call, debug messages are buffered per
+// thread and only converted here, so this should be called
+// periodically from the thread which handles them
+void CoreProcessDebugCallbacks(void);
+
 // sets whether the debug callbacks will be printed to stdout
 void CoreSetPrintDebugCallback(bool enabled);
 
+// sets whether verbose debug messages
+// will be sent to the debug callback
+void CoreSetVerboseDebugCallback(bool enabled);
+
 // sends message to the debug callback
 void CoreAddCallbackMessage(CoreDebugMessageType type, std::string message);
 
@@ -19,6 +19,7 @@
 #include "Library.hpp"
 #include "Plugins.hpp"
 #include "Error.hpp"
+#include "Trace.hpp"
 #include "Core.hpp"
 
 #include "m64p/Api.hpp"
@@ -91,11 +92,14 @@ bool CoreInit(void)
     std::string           error;
     std::filesystem::path core_file;
     m64p_error            m64p_ret;
+    CoreTraceTime         traceStart;
     bool ret = false;
 
     // initialize context string
     std::strcpy(l_CoreContextString, "[CORE]  ");
 
+    traceStart = CoreTraceBegin();
+
     core_file = find_core_lib();
     if (core_file.empty())
     {
@@ -139,6 +143,9 @@ bool CoreInit(void)
     }
 
     CoreAddCallbackMessage(CoreDebugMessageType::Info, "Initialized " + core_file.filename().string());
+    CoreTraceEnd("Core Library", traceStart);
+
+    traceStart = CoreTraceBegin();
 
     ret = CoreSetupMediaLoader();
     if (!ret)
@@ -170,11 +177,22 @@ bool CoreInit(void)
         return false;
     }
 
-    CoreReadRomHeaderAndSettingsCache();
+    CoreTraceEnd("Core Settings", traceStart);
+
+    // the rom header & settings cache is only
+    // needed by the ROM browser, so it's read
+    // on first use instead of here
+
+    traceStart = CoreTraceBegin();
+    CoreReadPluginCache();
+    CoreStartPluginDiscovery();
+    CoreTraceEnd("Plugin Cache", traceStart);
 
 #ifdef DISCORD_RPC
+    traceStart = CoreTraceBegin();
     CoreDiscordRpcInit();
     CoreDiscordRpcUpdate(false);
+    CoreTraceEnd("Discord RPC", traceStart);
 #endif // DISCORD_RPC
 
     return true;
@@ -186,6 +204,10 @@ void CoreShutdown(void)
 
     CoreSaveRomHeaderAndSettingsCache();
 
+    CoreSavePluginCache();
+
+    CoreSaveTrace();
+
 #ifdef DISCORD_RPC
     CoreDiscordRpcShutdown();
 #endif // DISCORD_RPC
@@ -235,7 +235,7 @@ bool CoreStartEmulation(std::filesystem::path n64rom, std::filesystem::path n64d
 #ifdef NETPLAY
     if (netplay)
     {
-        netplay_ret = CoreInitNetplay(address, port, player);
+        netplay_ret = CoreInitNetplay(address, port, player, CoreSettingsGetIntValue(SettingsID::Netplay_RollbackFrames));
         if (!netplay_ret)
         {
             m64p_ret = M64ERR_SYSTEM_FAIL;
@@ -27,7 +27,7 @@ static bool l_HasInitNetplay = false;
 // Exported Functions
 //
 
-bool CoreInitNetplay(std::string address, int port, int player)
+bool CoreInitNetplay(std::string address, int port, int player, int rollbackFrames)
 {
 #ifdef NETPLAY
     std::string error;
@@ -75,6 +75,19 @@ bool CoreInitNetplay(std::string address, int port, int player)
         return false;
     }
 
+    if (rollbackFrames > 0)
+    {
+        ret = m64p::Core.DoCommand(M64CMD_NETPLAY_SET_ROLLBACK, rollbackFrames, nullptr);
+        if (ret != M64ERR_SUCCESS)
+        {
+            error = "CoreInitNetplay m64p::Core.DoCommand(M64CMD_NETPLAY_SET_ROLLBACK) Failed: ";
+            error += m64p::Core.ErrorMessage(ret);
+            CoreSetError(error);
+            CoreShutdownNetplay();
+            return false;
+        }
+    }
+
     l_HasInitNetplay = true;
     return true;
 #else
@@ -91,6 +104,41 @@ bool CoreHasInitNetplay(void)
 #endif // NETPLAY
 }
 
+bool CoreGetNetplayStats(CoreNetplayStats& stats)
+{
+#ifdef NETPLAY
+    std::string error;
+    m64p_error ret;
+    m64p_netplay_stats netplayStats;
+
+    ret = m64p::Core.DoCommand(M64CMD_NETPLAY_GET_STATS, sizeof(netplayStats), &netplayStats);
+    if (ret != M64ERR_SUCCESS)
+    {
+        error = "CoreGetNetplayStats m64p::Core.DoCommand(M64CMD_NETPLAY_GET_STATS) Failed: ";
+        error += m64p::Core.ErrorMessage(ret);
+        CoreSetError(error);
+        return false;
+    }
+
+    stats.PacketsSent     = netplayStats.packets_sent;
+    stats.PacketsReceived = netplayStats.packets_received;
+    stats.EventsReceived  = netplayStats.events_received;
+    stats.EventsDiscarded = netplayStats.events_discarded;
+    stats.InputStalls     = netplayStats.input_stalls;
+    stats.InputRequests   = netplayStats.input_requests;
+    stats.InputWaitMs     = netplayStats.input_wait_ms;
+    stats.InputWaitMaxMs  = netplayStats.input_wait_max_ms;
+    stats.InputPredictions = netplayStats.input_predictions;
+    stats.Mispredictions   = netplayStats.mispredictions;
+    stats.Rollbacks        = netplayStats.rollbacks;
+    stats.ResimulatedVIs   = netplayStats.resimulated_vis;
+    stats.EventsMissed     = netplayStats.events_missed;
+    return true;
+#else
+    return false;
+#endif // NETPLAY
+}
+
 bool CoreShutdownNetplay(void)
 {
 #ifdef NETPLAY
@@ -11,13 +11,35 @@
 #define CORE_NETPLAY_HPP
 
 #include <string>
+#include <cstdint>
 
-// attempts to initialize netplay
-bool CoreInitNetplay(std::string address, int port, int player);
+struct CoreNetplayStats
+{
+    uint32_t PacketsSent     = 0;
+    uint32_t PacketsReceived = 0;
+    uint32_t EventsReceived  = 0;
+    uint32_t EventsDiscarded = 0;
+    uint32_t InputStalls     = 0;
+    uint32_t InputRequests   = 0;
+    uint32_t InputWaitMs     = 0;
+    uint32_t InputWaitMaxMs  = 0;
+    uint32_t InputPredictions = 0;
+    uint32_t Mispredictions   = 0;
+    uint32_t Rollbacks        = 0;
+    uint32_t ResimulatedVIs   = 0;
+    uint32_t EventsMissed     = 0;
+};
+
+// attempts to initialize netplay,
+// rollback is enabled when rollbackFrames > 0
+bool CoreInitNetplay(std::string address, int port, int player, int rollbackFrames);
 
 // returns whether netplay has been initialized
 bool CoreHasInitNetplay(void);
 
+// retrieves the netplay packet and input wait counters
+bool CoreGetNetplayStats(CoreNetplayStats& stats);
+
 // attempts to shutdown netplay
 bool CoreShutdownNetplay(void);
 
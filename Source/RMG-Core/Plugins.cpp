@@ -16,6 +16,8 @@
 #include "Library.hpp"
 #include "Plugins.hpp"
 #include "Error.hpp"
+#include "Trace.hpp"
+#include "File.hpp"
 
 #include "m64p/PluginApi.hpp"
 #include "m64p/Api.hpp"
@@ -23,6 +25,34 @@
 #include <filesystem>
 #include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <future>
+#include <mutex>
+
+//
+// Local Defines
+//
+
+#ifdef _WIN32
+#define CACHE_FILE_MAGIC "RMGCorePluginCacheWindows_01"
+#else // Linux
+#define CACHE_FILE_MAGIC "RMGCorePluginCacheLinux_01"
+#endif // _WIN32
+#define CACHE_FILE_STRING_MAX 4096
+
+//
+// Local Structures
+//
+
+struct l_PluginCacheEntry
+{
+    std::filesystem::path fileName;
+    uint64_t              fileSize;
+    CoreFileTime          fileTime;
+
+    std::string    name;
+    CorePluginType type;
+};
 
 //
 // Local Variables
@@ -32,6 +62,11 @@ static m64p::PluginApi l_Plugins[(int)CorePluginType::Input];
 static std::string     l_PluginFiles[(int)CorePluginType::Input];
 static char l_PluginContext[(int)CorePluginType::Input][20];
 
+static std::mutex                      l_PluginCacheMutex;
+static bool                            l_PluginCacheEntriesChanged = false;
+static std::vector<l_PluginCacheEntry> l_PluginCacheEntries;
+static std::future<void>               l_PluginDiscoveryFuture;
+
 //
 // Local Functions
 //
@@ -81,6 +116,106 @@ static std::string get_plugin_name(m64p::PluginApi* plugin, std::string filename
     return std::string(name);
 }
 
+static std::filesystem::path get_plugin_cache_file_name(void)
+{
+    std::filesystem::path file;
+
+    file = CoreGetUserCacheDirectory();
+    file += CORE_DIR_SEPERATOR_STR;
+    file += "PluginCache.cache";
+
+    return file;
+}
+
+static l_PluginCacheEntry read_plugin_info(std::filesystem::path file, uint64_t fileSize, CoreFileTime fileTime)
+{
+    l_PluginCacheEntry cacheEntry;
+    CoreLibraryHandle  handle;
+    m64p::PluginApi    plugin;
+
+    cacheEntry.fileName = file;
+    cacheEntry.fileSize = fileSize;
+    cacheEntry.fileTime = fileTime;
+    cacheEntry.type     = CorePluginType::Invalid;
+
+    handle = CoreOpenLibrary(file);
+    if (handle == nullptr)
+    { // cache invalid libs as well,
+      // so we don't retry them every time
+        return cacheEntry;
+    }
+
+    if (plugin.Hook(handle))
+    {
+        cacheEntry.name = get_plugin_name(&plugin, file.filename().string());
+        cacheEntry.type = get_plugin_type(&plugin);
+    }
+
+    plugin.Unhook();
+    CoreCloseLibrary(handle);
+    return cacheEntry;
+}
+
+static std::vector<CorePlugin> discover_plugins(void)
+{
+    std::vector<CorePlugin>            plugins;
+    std::vector<l_PluginCacheEntry>    cacheEntries;
+    std::error_code                    errorCode;
+    uint64_t                           fileSize;
+    CoreFileTime                       fileTime;
+
+    const std::lock_guard<std::mutex> guard(l_PluginCacheMutex);
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(CoreGetPluginDirectory(), errorCode))
+    {
+        std::string path = entry.path().string();
+        std::string file = entry.path().filename().string();
+        if (entry.is_directory() ||
+            !path.ends_with(CORE_LIBRARY_EXT_STR))
+        {
+            continue;
+        }
+
+        fileSize = entry.file_size(errorCode);
+        fileTime = CoreGetFileTime(entry.path());
+
+        // only open the library when it isn't
+        // cached or when it has changed since
+        auto iter = std::find_if(l_PluginCacheEntries.begin(), l_PluginCacheEntries.end(), [&](const auto& cacheEntry)
+        {
+            return cacheEntry.fileName == entry.path() &&
+                    cacheEntry.fileSize == fileSize &&
+                    cacheEntry.fileTime == fileTime;
+        });
+        if (iter != l_PluginCacheEntries.end())
+        {
+            cacheEntries.push_back(*iter);
+        }
+        else
+        {
+            cacheEntries.push_back(read_plugin_info(entry.path(), fileSize, fileTime));
+            l_PluginCacheEntriesChanged = true;
+        }
+
+        if (cacheEntries.back().type == CorePluginType::Invalid)
+        { // skip invalid libs and unsupported plugin types
+            continue;
+        }
+
+        CorePlugin corePlugin = {file, cacheEntries.back().name, cacheEntries.back().type};
+        plugins.emplace_back(corePlugin);
+    }
+
+    // drop the entries of plugins which have been removed
+    if (cacheEntries.size() != l_PluginCacheEntries.size())
+    {
+        l_PluginCacheEntriesChanged = true;
+    }
+    l_PluginCacheEntries = std::move(cacheEntries);
+
+    return plugins;
+}
+
 static std::string get_plugin_type_name(CorePluginType type)
 {
     std::string name;
@@ -385,43 +520,151 @@ static bool open_plugin_config(CorePluginType type, bool romConfig)
 // Exported Functions
 //
 
-std::vector<CorePlugin> CoreGetAllPlugins(void)
+void CoreReadPluginCache(void)
 {
-    std::vector<CorePlugin> plugins;
-    std::string             plugin_name;
-    CorePluginType          plugin_type;
-    CoreLibraryHandle       handle;
-    m64p::PluginApi         plugin;
+    std::ifstream inputStream;
+    char magicBuf[sizeof(CACHE_FILE_MAGIC)];
+    std::wstring fileNameBuf;
+    std::string nameBuf;
+    uint32_t size;
+    l_PluginCacheEntry cacheEntry;
+
+    const std::lock_guard<std::mutex> guard(l_PluginCacheMutex);
 
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(CoreGetPluginDirectory()))
+    inputStream.open(get_plugin_cache_file_name(), std::ios::binary);
+    if (!inputStream.good())
     {
-        std::string path = entry.path().string();
-        std::string file = entry.path().filename().string();
-        if (!entry.is_directory() &&
-            path.ends_with(CORE_LIBRARY_EXT_STR))
+        return;
+    }
+
+    // when magic doesn't match, don't read cache file
+    inputStream.read((char*)magicBuf, sizeof(CACHE_FILE_MAGIC));
+    if (!inputStream.good() ||
+        std::string(magicBuf, sizeof(magicBuf) - 1) != std::string(CACHE_FILE_MAGIC))
+    {
+        inputStream.close();
+        return;
+    }
+
+    // read all file entries
+#define FREAD(x) inputStream.read((char*)&x, sizeof(x))
+#define FREAD_STR(x, y) inputStream.read((char*)x.data(), y)
+    while (inputStream.good())
+    {
+        // file info
+        size = 0;
+        FREAD(size);
+        if (!inputStream.good() || size > CACHE_FILE_STRING_MAX)
         {
-            handle = CoreOpenLibrary(path.c_str());
-            if (handle == nullptr || !plugin.Hook(handle))
-            { // skip invalid libs
-                continue;
-            }
+            break;
+        }
+        fileNameBuf.assign(size / sizeof(wchar_t), L'\0');
+        FREAD_STR(fileNameBuf, size);
+        cacheEntry.fileName = std::filesystem::path(fileNameBuf);
+        FREAD(cacheEntry.fileSize);
+        FREAD(cacheEntry.fileTime);
+        // plugin info
+        FREAD(cacheEntry.type);
+        size = 0;
+        FREAD(size);
+        if (!inputStream.good() || size > CACHE_FILE_STRING_MAX)
+        {
+            break;
+        }
+        nameBuf.assign(size, '\0');
+        FREAD_STR(nameBuf, size);
+        cacheEntry.name = nameBuf;
 
-            plugin_name = get_plugin_name(&plugin, entry.path().filename().string());
-            plugin_type = get_plugin_type(&plugin);
+        // don't add incomplete entries
+        if (!inputStream.good())
+        {
+            break;
+        }
 
-            plugin.Unhook();
-            CoreCloseLibrary(handle);
+        // add to cached entries
+        l_PluginCacheEntries.push_back(cacheEntry);
+    }
+#undef FREAD
+#undef FREAD_STR
 
-            if (plugin_type == CorePluginType::Invalid)
-            { // skip unsupported plugin types
-                continue;
-            }
+    inputStream.close();
+}
 
-            CorePlugin corePlugin = {file, plugin_name, plugin_type};
-            plugins.emplace_back(corePlugin);
-        }
+void CoreStartPluginDiscovery(void)
+{
+    // opening every plugin can be slow, so
+    // fill the plugin cache in the background,
+    // CoreGetAllPlugins() waits for it when needed
+    l_PluginDiscoveryFuture = std::async(std::launch::async, []
+    {
+        CoreTraceTime traceStart = CoreTraceBegin();
+        discover_plugins();
+        CoreTraceEnd("Plugin Discovery", traceStart);
+    });
+}
+
+bool CoreSavePluginCache(void)
+{
+    std::ofstream outputStream;
+    std::wstring fileName;
+    uint32_t size;
+
+    // make sure the discovery has finished
+    if (l_PluginDiscoveryFuture.valid())
+    {
+        l_PluginDiscoveryFuture.wait();
+    }
+
+    const std::lock_guard<std::mutex> guard(l_PluginCacheMutex);
+
+    // only save cache when the entries have changed
+    if (!l_PluginCacheEntriesChanged)
+    {
+        return true;
+    }
+
+    outputStream.open(get_plugin_cache_file_name(), std::ios::binary);
+    if (!outputStream.good())
+    {
+        return false;
     }
 
+    // write magic header
+    outputStream.write((char*)CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+
+    // write each entry in the file
+#define FWRITE(x) outputStream.write((char*)&x, sizeof(x))
+#define FWRITE_STR(x, y) outputStream.write((char*)x, y)
+    for (const l_PluginCacheEntry& cacheEntry : l_PluginCacheEntries)
+    {
+        fileName = cacheEntry.fileName.wstring();
+
+        // file info
+        size = fileName.size() * sizeof(wchar_t);
+        FWRITE(size);
+        FWRITE_STR(fileName.c_str(), size);
+        FWRITE(cacheEntry.fileSize);
+        FWRITE(cacheEntry.fileTime);
+        // plugin info
+        FWRITE(cacheEntry.type);
+        size = cacheEntry.name.size();
+        FWRITE(size);
+        FWRITE_STR(cacheEntry.name.c_str(), size);
+    }
+#undef FWRITE
+#undef FWRITE_STR
+
+    outputStream.close();
+    l_PluginCacheEntriesChanged = false;
+    return true;
+}
+
+std::vector<CorePlugin> CoreGetAllPlugins(void)
+{
+    std::vector<CorePlugin> plugins;
+
+    plugins = discover_plugins();
+
     std::sort(plugins.begin(), plugins.end(), [](CorePlugin& a, CorePlugin& b)
     {
         return a.Name > b.Name;
@@ -29,7 +29,22 @@ struct CorePlugin
     CorePluginType Type;
 };
 
-// retrieves all available plugins
+#ifdef CORE_INTERNAL
+// attempts to read the plugin cache
+void CoreReadPluginCache(void);
+
+// starts discovering all available plugins
+// in the background, updating the plugin cache
+void CoreStartPluginDiscovery(void);
+
+// returns whether saving the plugin cache
+// succeeds
+bool CoreSavePluginCache(void);
+#endif // CORE_INTERNAL
+
+// retrieves all available plugins, only plugins
+// which aren't in the plugin cache or have changed
+// since they were cached will be opened
 std::vector<CorePlugin> CoreGetAllPlugins(void);
 
 // applies updated plugin settings,
@@ -169,6 +169,9 @@ static l_Setting get_setting(SettingsID settingId)
     case SettingsID::Netplay_SelectedServer:
         setting = {SETTING_SECTION_NETPLAY, "SelectedServer", std::string("")};
         break;
+    case SettingsID::Netplay_RollbackFrames:
+        setting = {SETTING_SECTION_NETPLAY, "RollbackFrames", 0};
+        break;
 
     case SettingsID::Core_GFX_Plugin:
         setting = {SETTING_SECTION_CORE, "GFX_Plugin", 
@@ -46,6 +46,7 @@ enum class SettingsID
     Netplay_Nickname,
     Netplay_ServerJsonUrl,
     Netplay_SelectedServer,
+    Netplay_RollbackFrames,
 
     // Core Plugin Settings
     Core_GFX_Plugin,
@@ -0,0 +1,165 @@
+/*
+ * Rosalie's Mupen GUI - https://github.com/Rosalie241/RMG
+ *  Copyright (C) 2020 Rosalie Wanders <rosalie@mailbox.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3.
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Directories.hpp"
+#include "Callback.hpp"
+#include "Trace.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+//
+// Local Structures
+//
+
+struct l_TraceSpan
+{
+    std::string   name;
+    CoreTraceTime start;
+    CoreTraceTime end;
+    int           threadId;
+};
+
+//
+// Local Variables
+//
+
+static const std::chrono::steady_clock::time_point l_TraceEpoch = std::chrono::steady_clock::now();
+static std::atomic<bool>        l_TraceEnabled = false;
+static std::atomic<int>         l_TraceThreadCount = 0;
+static thread_local int         l_TraceThreadId = 0;
+static std::mutex               l_TraceMutex;
+static std::vector<l_TraceSpan> l_TraceSpans;
+
+//
+// Local Functions
+//
+
+static CoreTraceTime get_trace_time(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_TraceEpoch).count();
+}
+
+static int get_trace_thread_id(void)
+{
+    // the chrome trace viewer only needs an unique
+    // number per thread, so hand them out in order
+    if (l_TraceThreadId == 0)
+    {
+        l_TraceThreadId = ++l_TraceThreadCount;
+    }
+
+    return l_TraceThreadId;
+}
+
+static std::string escape_json_string(std::string str)
+{
+    std::string escapedStr;
+
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escapedStr += '\\';
+        }
+        else if ((unsigned char)c < 0x20)
+        { // skip control characters
+            continue;
+        }
+        escapedStr += c;
+    }
+
+    return escapedStr;
+}
+
+//
+// Exported Functions
+//
+
+void CoreSetTraceEnabled(bool enabled)
+{
+    l_TraceEnabled = enabled;
+}
+
+bool CoreIsTraceEnabled(void)
+{
+    return l_TraceEnabled;
+}
+
+CoreTraceTime CoreTraceBegin(void)
+{
+    return get_trace_time();
+}
+
+void CoreTraceEnd(std::string name, CoreTraceTime start)
+{
+    CoreTraceTime end;
+
+    if (!l_TraceEnabled)
+    {
+        return;
+    }
+
+    end = get_trace_time();
+
+    const std::lock_guard<std::mutex> guard(l_TraceMutex);
+    l_TraceSpans.push_back({name, start, end, get_trace_thread_id()});
+}
+
+bool CoreSaveTrace(void)
+{
+    std::ofstream         outputStream;
+    std::filesystem::path file;
+
+    if (!l_TraceEnabled)
+    {
+        return false;
+    }
+
+    file = CoreGetUserCacheDirectory();
+    file += CORE_DIR_SEPERATOR_STR;
+    file += "Trace.json";
+
+    const std::lock_guard<std::mutex> guard(l_TraceMutex);
+
+    outputStream.open(file, std::ios::trunc);
+    if (!outputStream.good())
+    {
+        return false;
+    }
+
+    // every span is a complete event, see
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    outputStream << "{\"traceEvents\":[";
+    for (size_t i = 0; i < l_TraceSpans.size(); i++)
+    {
+        const l_TraceSpan& span = l_TraceSpans[i];
+
+        outputStream << (i == 0 ? "\n" : ",\n");
+        outputStream << "{\"name\":\"" << escape_json_string(span.name) << "\",";
+        outputStream << "\"cat\":\"RMG\",\"ph\":\"X\",";
+        outputStream << "\"ts\":" << span.start << ",";
+        outputStream << "\"dur\":" << (span.end - span.start) << ",";
+        outputStream << "\"pid\":1,\"tid\":" << span.threadId << "}";
+    }
+    outputStream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    outputStream.close();
+    if (!outputStream.good())
+    {
+        return false;
+    }
+
+    CoreAddCallbackMessage(CoreDebugMessageType::Info, "Saved trace to " + file.string());
+    return true;
+}
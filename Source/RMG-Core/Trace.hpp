@@ -0,0 +1,38 @@
+/*
+ * Rosalie's Mupen GUI - https://github.com/Rosalie241/RMG
+ *  Copyright (C) 2020 Rosalie Wanders <rosalie@mailbox.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3.
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_TRACE_HPP
+#define CORE_TRACE_HPP
+
+#include <cstdint>
+#include <string>
+
+// time in microseconds since RMG-Core was loaded
+typedef uint64_t CoreTraceTime;
+
+// sets whether trace spans will be recorded
+void CoreSetTraceEnabled(bool enabled);
+
+// returns whether trace spans are recorded
+bool CoreIsTraceEnabled(void);
+
+// returns the current trace time,
+// to be passed to CoreTraceEnd()
+CoreTraceTime CoreTraceBegin(void);
+
+// records a trace span with given name which
+// started at the given time and ends now
+void CoreTraceEnd(std::string name, CoreTraceTime start);
+
+// attempts to save all recorded trace spans
+// to Trace.json in the user cache directory,
+// in the chrome trace event format
+bool CoreSaveTrace(void);
+
+#endif // CORE_TRACE_HPP
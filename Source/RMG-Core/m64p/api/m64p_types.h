@@ -171,7 +171,10 @@ typedef enum {
   M64CMD_PIF_OPEN,
   M64CMD_ROM_SET_SETTINGS,
   M64CMD_DISK_OPEN,
-  M64CMD_DISK_CLOSE
+  M64CMD_DISK_CLOSE,
+  M64CMD_NETPLAY_GET_STATS,
+  M64CMD_NETPLAY_SET_ROLLBACK,
+  M64CMD_STORAGE_GET_STATS
 } m64p_command;
 
 typedef struct {
@@ -179,6 +182,32 @@ typedef struct {
   int      value;
 } m64p_cheat_code;
 
+typedef struct {
+  uint32_t packets_sent;      /* UDP packets sent to the server */
+  uint32_t packets_received;  /* UDP packets received from the server */
+  uint32_t events_received;   /* input events stored in the input buffers */
+  uint32_t events_discarded;  /* duplicate, stale or overflowing input events */
+  uint32_t input_stalls;      /* times emulation had to wait for missing input */
+  uint32_t input_requests;    /* input requests re-sent while waiting */
+  uint32_t input_wait_ms;     /* total time spent waiting for input */
+  uint32_t input_wait_max_ms; /* longest single wait for input */
+  uint32_t input_predictions; /* inputs predicted while running ahead (rollback mode) */
+  uint32_t mispredictions;    /* predicted inputs that turned out to be wrong */
+  uint32_t rollbacks;         /* snapshots restored to correct a misprediction */
+  uint32_t resimulated_vis;   /* VIs emulated again after a rollback */
+  uint32_t events_missed;     /* input events skipped in the received event counts */
+} m64p_netplay_stats;
+
+typedef struct {
+  uint32_t flushes;         /* save files written by the write-back service */
+  uint32_t flush_errors;    /* save files that couldn't be written */
+  uint32_t pending_flushes; /* save files queued but not written yet */
+  uint64_t bytes_dirty;     /* bytes changed by the game, coalesced per flush */
+  uint64_t bytes_written;   /* bytes written to disk */
+  uint32_t last_flush_ms;   /* time between queueing and completing the last flush */
+  uint32_t max_flush_ms;    /* longest flush */
+} m64p_storage_stats;
+
 typedef struct {
   /* Frontend-defined callback data. */
   void* cb_data;
@@ -298,7 +327,9 @@ typedef enum {
   M64P_DBG_PREVIOUS_PC,
   M64P_DBG_NUM_BREAKPOINTS,
   M64P_DBG_CPU_DYNACORE,
-  M64P_DBG_CPU_NEXT_INTERRUPT
+  M64P_DBG_CPU_NEXT_INTERRUPT,
+  M64P_DBG_CPU_CACHED_PAGES_ALLOCATED,
+  M64P_DBG_CPU_CACHED_ARENA_KB
 } m64p_dbg_state;
 
 typedef enum {
@@ -12,7 +12,6 @@
 #include <RMG-Core/Settings.hpp>
 
 #include <QTimerEvent>
-#include <QMutex>
 
 
 //
@@ -22,7 +21,6 @@
 static CoreCallbacks* l_CoreCallbacks = nullptr;
 static bool           l_showVerboseMessages = false;
 
-static QMutex                     l_CallbackMessagesMutex;
 static QList<CoreCallbackMessage> l_CallbackMessages;
 
 //
@@ -70,19 +68,22 @@ void CoreCallbacks::Stop(void)
 void CoreCallbacks::LoadSettings(void)
 {
     l_showVerboseMessages = CoreSettingsGetBoolValue(SettingsID::GUI_ShowVerboseLogMessages);
+    CoreSetVerboseDebugCallback(l_showVerboseMessages);
 }
 
 void CoreCallbacks::timerEvent(QTimerEvent *event)
 {
     if (event->timerId() == this->callbackTimerId)
     {
-        l_CallbackMessagesMutex.lock();
+        // the core buffers the debug messages,
+        // so retrieve them all at once
+        CoreProcessDebugCallbacks();
+
         if (!l_CallbackMessages.isEmpty())
         {
             emit this->OnCoreDebugCallback(l_CallbackMessages);
             l_CallbackMessages.clear();
         }
-        l_CallbackMessagesMutex.unlock();
     }
 }
 
@@ -99,9 +100,7 @@ void CoreCallbacks::coreDebugCallback(CoreDebugMessageType type, std::string con
         return;
     }
 
-    l_CallbackMessagesMutex.lock();
     l_CallbackMessages.append({type, QString::fromStdString(context), QString::fromStdString(message)});
-    l_CallbackMessagesMutex.unlock();
 }
 
 void CoreCallbacks::coreStateCallback(CoreStateCallbackType type, int value)
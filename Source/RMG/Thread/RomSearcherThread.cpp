@@ -10,12 +10,39 @@
 #include "RomSearcherThread.hpp"
 
 #include <RMG-Core/CachedRomHeaderAndSettings.hpp>
+#include <RMG-Core/Directories.hpp>
 
 #include <QElapsedTimer>
-#include <QDirIterator>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
 
 using namespace Thread;
 
+//
+// Local Defines
+//
+
+#define SNAPSHOT_FILE_MAGIC "RMGRomDirectorySnapshot_01"
+
+//
+// Local Functions
+//
+
+static QString get_snapshot_file_name(void)
+{
+    QString file = QString::fromStdString(CoreGetUserCacheDirectory().string());
+    file += "/RomDirectorySnapshot.cache";
+    return file;
+}
+
+//
+// Exported Functions
+//
+
 RomSearcherThread::RomSearcherThread(QObject *parent) : QThread(parent)
 {
     qRegisterMetaType<CoreRomType>("CoreRomType");
@@ -44,6 +71,18 @@ void RomSearcherThread::SetMaximumFiles(int value)
     this->maxItems = value;
 }
 
+void RomSearcherThread::SetUseSnapshot(bool value)
+{
+    this->useSnapshot = value;
+}
+
+void RomSearcherThread::SetIncremental(QSet<QString> knownFiles, QSet<QString> changedDirectories)
+{
+    this->incremental        = true;
+    this->knownFiles         = knownFiles;
+    this->changedDirectories = changedDirectories;
+}
+
 void RomSearcherThread::Stop(void)
 {
     this->stop = true;
@@ -56,7 +95,91 @@ void RomSearcherThread::Stop(void)
 void RomSearcherThread::run(void)
 {
     this->stop = false;
+
+    // a search which doesn't use the snapshot
+    // replaces it, so there's no need to read it
+    if (!this->snapshotRead)
+    {
+        if (this->useSnapshot)
+        {
+            this->readSnapshot();
+        }
+        this->snapshotRead = true;
+    }
+
     this->searchDirectory(this->directory);
+
+    // the next search is a full one,
+    // unless requested otherwise
+    this->incremental = false;
+    this->knownFiles.clear();
+    this->changedDirectories.clear();
+}
+
+void RomSearcherThread::readSnapshot(void)
+{
+    QFile file(get_snapshot_file_name());
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    // when magic doesn't match, don't read snapshot
+    QString magic;
+    stream >> magic;
+    if (magic != SNAPSHOT_FILE_MAGIC)
+    {
+        return;
+    }
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        QString path;
+        DirectorySnapshot directorySnapshot;
+        stream >> path;
+        stream >> directorySnapshot.modifiedTime;
+        stream >> directorySnapshot.directories;
+        stream >> directorySnapshot.files;
+        this->snapshot.insert(path, directorySnapshot);
+    }
+
+    // don't use a partially read snapshot
+    if (stream.status() != QDataStream::Ok)
+    {
+        this->snapshot.clear();
+    }
+}
+
+void RomSearcherThread::saveSnapshot(void)
+{
+    QSaveFile file(get_snapshot_file_name());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << QString(SNAPSHOT_FILE_MAGIC);
+    stream << (quint32)this->snapshot.size();
+    for (auto iter = this->snapshot.cbegin(); iter != this->snapshot.cend(); iter++)
+    {
+        stream << iter.key();
+        stream << iter.value().modifiedTime;
+        stream << iter.value().directories;
+        stream << iter.value().files;
+    }
+
+    if (file.commit())
+    {
+        this->snapshotChanged = false;
+    }
 }
 
 void RomSearcherThread::searchDirectory(QString directory)
@@ -70,20 +193,86 @@ void RomSearcherThread::searchDirectory(QString directory)
     filter << "*.ZIP";
     filter << "*.7Z";
 
-    QDirIterator::IteratorFlag flag = this->recursive ? 
-        QDirIterator::Subdirectories : 
-        QDirIterator::NoIteratorFlags;
-    QDirIterator romDirIt(directory, filter, QDir::Files, flag);
-
     CoreRomType     type;
     CoreRomHeader   header;
     CoreRomSettings settings;
-    bool            ret;
 
     QList<QString> roms;
-    while (romDirIt.hasNext())
+    QList<bool>    romsChanged;
+    QStringList    directories;
+    QHash<QString, DirectorySnapshot> newSnapshot;
+
+    // walk the directories, only directories which have
+    // been modified since the snapshot have to be listed,
+    // because adding, removing or renaming a file or
+    // directory changes the modification time of the
+    // directory containing it
+    QStringList pendingDirectories;
+    pendingDirectories.append(QDir::cleanPath(directory));
+    while (!pendingDirectories.isEmpty() && !this->stop)
+    {
+        QString path = pendingDirectories.takeFirst();
+        QFileInfo pathInfo(path);
+        if (!pathInfo.isDir())
+        {
+            continue;
+        }
+
+        qint64 modifiedTime = pathInfo.lastModified().toMSecsSinceEpoch();
+        bool   changed      = this->changedDirectories.contains(path);
+
+        DirectorySnapshot directorySnapshot;
+        auto iter = this->snapshot.constFind(path);
+        if (this->useSnapshot &&
+            iter != this->snapshot.cend() &&
+            iter.value().modifiedTime == modifiedTime &&
+            !changed)
+        {
+            directorySnapshot = iter.value();
+        }
+        else
+        {
+            QDir dir(path);
+            directorySnapshot.modifiedTime = modifiedTime;
+            directorySnapshot.files        = dir.entryList(filter, QDir::Files, QDir::NoSort);
+            directorySnapshot.directories  = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDir::NoSort);
+            this->snapshotChanged = true;
+        }
+
+        for (const QString& file : directorySnapshot.files)
+        {
+            roms.append(path + "/" + file);
+            romsChanged.append(changed);
+        }
+
+        if (this->recursive)
+        {
+            for (const QString& subDirectory : directorySnapshot.directories)
+            {
+                pendingDirectories.append(path + "/" + subDirectory);
+            }
+        }
+
+        directories.append(path);
+        newSnapshot.insert(path, directorySnapshot);
+    }
+
+    if (!this->stop)
     {
-        roms.push_back(romDirIt.next());
+        // directories which weren't found have been
+        // removed, or aren't searched anymore
+        if (newSnapshot.size() != this->snapshot.size())
+        {
+            this->snapshotChanged = true;
+        }
+
+        this->snapshot = newSnapshot;
+        if (this->snapshotChanged)
+        {
+            this->saveSnapshot();
+        }
+
+        emit this->DirectoriesFound(directories);
     }
 
     const int romAmount = std::min(this->maxItems, (int)roms.size());
@@ -95,18 +284,29 @@ void RomSearcherThread::searchDirectory(QString directory)
     QElapsedTimer timer;
     timer.start();
 
-    for (int i = 0; i < romAmount; i++)
+    for (int i = 0; i < romAmount && !this->stop; i++)
     {
         QString file = roms.at(i);
 
+        // when searching incrementally, only known
+        // ROMs in changed directories are validated again
+        if (this->incremental &&
+            !romsChanged.at(i) &&
+            this->knownFiles.remove(file))
+        {
+            continue;
+        }
+
         if (CoreGetCachedRomHeaderAndSettings(file.toStdU32String(), type, header, settings))
         {
+            this->knownFiles.remove(file);
             data.push_back(
             {
                 file,
                 type,
                 header,
-                settings
+                settings,
+                QFileInfo(file).size()
             });
         }
 
@@ -121,11 +321,6 @@ void RomSearcherThread::searchDirectory(QString directory)
             data.clear();
             timer.start();
         }
-
-        if (this->stop)
-        {
-            break;
-        }
     }
 
     // when we're done and
@@ -136,6 +331,14 @@ void RomSearcherThread::searchDirectory(QString directory)
         emit this->RomsFound(data, romAmount, romAmount);
     }
 
+    // the known ROMs which are left
+    // over weren't found anymore
+    if (this->incremental &&
+        !this->stop &&
+        !this->knownFiles.isEmpty())
+    {
+        emit this->RomsRemoved(this->knownFiles.values());
+    }
+
     emit this->Finished(this->stop);
 }
-
@@ -14,8 +14,11 @@
 #include <RMG-Core/RomHeader.hpp>
 #include <RMG-Core/Rom.hpp>
 
+#include <QStringList>
 #include <QString>
 #include <QThread>
+#include <QHash>
+#include <QSet>
 
 struct RomSearcherThreadData
 {
@@ -23,6 +26,7 @@ struct RomSearcherThreadData
     CoreRomType Type;
     CoreRomHeader Header;
     CoreRomSettings Settings;
+    qint64 FileSize;
 };
 
 namespace Thread
@@ -38,6 +42,18 @@ class RomSearcherThread : public QThread
     void SetDirectory(QString);
     void SetRecursive(bool);
     void SetMaximumFiles(int);
+
+    // sets whether directories which haven't been
+    // modified since they were last listed are
+    // skipped, instead of listing every directory
+    void SetUseSnapshot(bool);
+
+    // makes the next search only report the ROMs
+    // which aren't in the given files or which are
+    // in one of the given changed directories,
+    // and the given files which weren't found
+    void SetIncremental(QSet<QString> knownFiles, QSet<QString> changedDirectories);
+
     void Stop(void);
 
     void run(void) override;
@@ -48,10 +64,33 @@ class RomSearcherThread : public QThread
     int  maxItems = 0;
     bool stop = false;
 
+    bool incremental = false;
+    QSet<QString> knownFiles;
+    QSet<QString> changedDirectories;
+
+    // contents of every directory when it was
+    // last listed, directories which haven't been
+    // modified since then don't have to be listed again
+    struct DirectorySnapshot
+    {
+        qint64      modifiedTime = 0;
+        QStringList directories;
+        QStringList files;
+    };
+    QHash<QString, DirectorySnapshot> snapshot;
+    bool useSnapshot     = true;
+    bool snapshotRead    = false;
+    bool snapshotChanged = false;
+
+    void readSnapshot(void);
+    void saveSnapshot(void);
+
     void searchDirectory(QString);
 
   signals:
     void RomsFound(QList<RomSearcherThreadData> data, int index, int count);
+    void RomsRemoved(QStringList files);
+    void DirectoriesFound(QStringList directories);
     void Finished(bool canceled);
 };
 } // namespace Thread
@@ -19,6 +19,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 
+#include <RMG-Core/Settings.hpp>
 #include <RMG-Core/Error.hpp>
 #include <RMG-Core/Rom.hpp>
 
@@ -72,6 +73,8 @@ NetplaySessionDialog::NetplaySessionDialog(QWidget *parent, QWebSocket* webSocke
     cheatsButton->setText("Cheats");
     cheatsButton->setIcon(QIcon::fromTheme("code-box-line"));
 
+    this->rollbackSpinBox->setValue(CoreSettingsGetIntValue(SettingsID::Netplay_RollbackFrames));
+
     this->updateCheatsTreeWidget();
 }
 
@@ -191,6 +194,7 @@ void NetplaySessionDialog::on_webSocket_textMessageReceived(QString message)
         if (json.value("accept").toInt() == 0)
         {
             this->started = true;
+            this->rollbackSpinBox->setEnabled(false);
             this->applyCheats();
             emit OnPlayGame(this->sessionFile, this->webSocket->peerAddress().toString(), this->sessionPort, this->sessionNumber);
         }
@@ -246,6 +250,11 @@ void NetplaySessionDialog::on_sendPushButton_clicked(void)
     this->chatLineEdit->clear();
 }
 
+void NetplaySessionDialog::on_rollbackSpinBox_valueChanged(int value)
+{
+    CoreSettingsSetValue(SettingsID::Netplay_RollbackFrames, value);
+}
+
 void NetplaySessionDialog::on_buttonBox_clicked(QAbstractButton* button)
 {
     QPushButton* pushButton = (QPushButton*)button;
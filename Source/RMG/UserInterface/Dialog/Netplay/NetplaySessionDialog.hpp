@@ -51,6 +51,7 @@ class NetplaySessionDialog : public QDialog, private Ui::NetplaySessionDialog
 
     void on_chatLineEdit_textChanged(QString text);
     void on_sendPushButton_clicked(void);
+    void on_rollbackSpinBox_valueChanged(int value);
     void on_buttonBox_clicked(QAbstractButton* button);
     
   	void accept(void) Q_DECL_OVERRIDE;
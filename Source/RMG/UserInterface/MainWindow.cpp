@@ -67,6 +67,7 @@
 #include <RMG-Core/Cheats.hpp>
 #include <RMG-Core/Volume.hpp>
 #include <RMG-Core/Error.hpp>
+#include <RMG-Core/Trace.hpp>
 #include <RMG-Core/Video.hpp>
 #include <RMG-Core/Core.hpp>
 #include <RMG-Core/Key.hpp>
@@ -83,17 +84,24 @@ MainWindow::~MainWindow()
 
 bool MainWindow::Init(QApplication* app, bool showUI, bool launchROM)
 {
+    CoreTraceTime traceStart;
+
+    traceStart = CoreTraceBegin();
     if (!CoreInit())
     {
         this->showErrorMessage("CoreInit() Failed", QString::fromStdString(CoreGetError()));
         return false;
     }
+    CoreTraceEnd("CoreInit", traceStart);
 
+    traceStart = CoreTraceBegin();
     if (!CoreApplyPluginSettings())
     {
         this->showErrorMessage("CoreApplyPluginSettings() Failed", QString::fromStdString(CoreGetError()));
     }
+    CoreTraceEnd("Apply Plugin Settings", traceStart);
 
+    traceStart = CoreTraceBegin();
     this->configureTheme(app);
 
     this->initializeUI(launchROM);
@@ -104,16 +112,16 @@ bool MainWindow::Init(QApplication* app, bool showUI, bool launchROM)
     this->configureActions();
     this->updateActions(false, false);
 
-#ifdef UPDATER
-    this->checkForUpdates(true, false);
-#else
+#ifndef UPDATER
     this->action_Help_Update->setVisible(false);
 #endif // UPDATER
 
 #ifndef NETPLAY
     this->menuNetplay->menuAction()->setVisible(false);
 #endif // NETPLAY
+    CoreTraceEnd("Initialize UI", traceStart);
 
+    traceStart = CoreTraceBegin();
     this->initializeEmulationThread();
     this->connectEmulationThreadSignals();
 
@@ -135,6 +143,7 @@ bool MainWindow::Init(QApplication* app, bool showUI, bool launchROM)
         this->showErrorMessage("CoreCallbacks::Init() Failed", QString::fromStdString(CoreGetError()));
         return false;
     }
+    CoreTraceEnd("Initialize Emulation Thread", traceStart);
 
     // add actions when there's no UI
     if (!showUI)
@@ -142,6 +151,10 @@ bool MainWindow::Init(QApplication* app, bool showUI, bool launchROM)
         this->addActions();
     }
 
+    // finish starting up once the event loop runs,
+    // the window will be shown and usable by then
+    QTimer::singleShot(0, this, &MainWindow::finishStartup);
+
     return true;
 }
 
@@ -201,6 +214,26 @@ void MainWindow::closeEvent(QCloseEvent *event)
     QMainWindow::closeEvent(event);
 }
 
+void MainWindow::finishStartup(void)
+{
+    CoreTraceTime startupTime = CoreTraceBegin();
+
+    CoreTraceEnd("Startup", 0);
+    if (CoreIsTraceEnabled())
+    {
+        CoreAddCallbackMessage(CoreDebugMessageType::Info,
+            "Startup took " + std::to_string(startupTime / 1000) + " ms");
+        CoreSaveTrace();
+    }
+
+#ifdef UPDATER
+    // the update check isn't needed for
+    // the window to be usable, so it's
+    // done after starting up
+    this->checkForUpdates(true, false);
+#endif // UPDATER
+}
+
 void MainWindow::initializeUI(bool launchROM)
 {
     this->setupUi(this);
@@ -215,10 +248,12 @@ void MainWindow::initializeUI(bool launchROM)
 
     // only start refreshing the ROM browser
     // when RMG isn't launched with a ROM 
-    // specified on the commandline
+    // specified on the commandline, the
+    // directories which haven't been modified
+    // since the last search aren't listed again
     if (!launchROM)
     {
-        this->ui_Widget_RomBrowser->RefreshRomList();
+        this->ui_Widget_RomBrowser->RefreshRomList(true);
     }
 
     connect(this->ui_Widget_RomBrowser, &Widget::RomBrowserWidget::PlayGame, this,
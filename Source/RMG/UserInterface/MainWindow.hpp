@@ -123,6 +123,8 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
 
     void closeEvent(QCloseEvent *) Q_DECL_OVERRIDE;
 
+    void finishStartup(void);
+
     void initializeUI(bool launchROM);
 
     void configureUI(QApplication* app, bool showUI);
@@ -0,0 +1,544 @@
+/*
+ * Rosalie's Mupen GUI - https://github.com/Rosalie241/RMG
+ *  Copyright (C) 2020 Rosalie Wanders <rosalie@mailbox.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3.
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "RomBrowserModel.hpp"
+
+#include <QFileInfo>
+
+#include <algorithm>
+
+using namespace UserInterface::Widget;
+
+//
+// Local Defines
+//
+
+#define COLUMN_NAME          0
+#define COLUMN_INTERNAL_NAME 1
+#define COLUMN_MD5           2
+#define COLUMN_FORMAT        3
+#define COLUMN_FILE_NAME     4
+#define COLUMN_FILE_EXT      5
+#define COLUMN_FILE_SIZE     6
+#define COLUMN_GAME_ID       7
+#define COLUMN_REGION        8
+
+//
+// Exported Functions
+//
+
+RomBrowserModel::RomBrowserModel(QObject* parent) : QAbstractTableModel(parent)
+{
+    this->columnNames << "Name";
+    this->columnNames << "Internal Name";
+    this->columnNames << "MD5";
+    this->columnNames << "Format";
+    this->columnNames << "File Name";
+    this->columnNames << "File Ext.";
+    this->columnNames << "File Size";
+    this->columnNames << "I.D.";
+    this->columnNames << "Region";
+
+    this->texts.resize(this->columnNames.size());
+}
+
+RomBrowserModel::~RomBrowserModel(void)
+{
+}
+
+int RomBrowserModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+    {
+        return 0;
+    }
+
+    return this->rowSlots.size();
+}
+
+int RomBrowserModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+    {
+        return 0;
+    }
+
+    return this->columnNames.size();
+}
+
+QVariant RomBrowserModel::data(const QModelIndex& index, int role) const
+{
+    int slot = this->getSlot(index);
+    if (slot == -1)
+    {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole)
+    {
+        if (index.column() < 0 || index.column() >= (int)this->texts.size())
+        {
+            return QVariant();
+        }
+
+        return this->texts[index.column()][slot];
+    }
+    else if (role == Qt::DecorationRole &&
+             index.column() == COLUMN_NAME &&
+             this->showCovers)
+    {
+        if (this->covers[slot].isNull())
+        {
+            return this->coverPlaceholder;
+        }
+
+        return this->covers[slot];
+    }
+
+    return QVariant();
+}
+
+QVariant RomBrowserModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal &&
+        role == Qt::DisplayRole &&
+        section >= 0 && section < this->columnNames.size())
+    {
+        return this->columnNames.at(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void RomBrowserModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < 0 || column >= this->columnNames.size())
+    {
+        return;
+    }
+
+    const std::vector<QString>& keys = this->texts[column];
+    std::vector<int> sortedSlots = this->rowSlots;
+
+    auto lessThan = [&](int a, int b)
+    {
+        if (column == COLUMN_FILE_SIZE)
+        {
+            return this->fileSizes[a] < this->fileSizes[b];
+        }
+
+        return keys[a] < keys[b];
+    };
+
+    if (order == Qt::AscendingOrder)
+    {
+        std::stable_sort(sortedSlots.begin(), sortedSlots.end(), lessThan);
+    }
+    else
+    {
+        std::stable_sort(sortedSlots.begin(), sortedSlots.end(), [&](int a, int b)
+        {
+            return lessThan(b, a);
+        });
+    }
+
+    this->updateRows(sortedSlots, QAbstractItemModel::VerticalSortHint);
+}
+
+void RomBrowserModel::Clear(void)
+{
+    this->beginResetModel();
+
+    this->freeSlots.clear();
+    this->fileSlots.clear();
+    this->files.clear();
+    this->types.clear();
+    this->headers.clear();
+    this->settings.clear();
+    this->names.clear();
+    this->fileSizes.clear();
+    this->covers.clear();
+    this->coverFiles.clear();
+    this->coverSizes.clear();
+    for (std::vector<QString>& columnTexts : this->texts)
+    {
+        columnTexts.clear();
+    }
+    this->romIds.clear();
+    this->romIdSlots.clear();
+    this->rowSlots.clear();
+    this->slotRows.clear();
+
+    this->endResetModel();
+}
+
+void RomBrowserModel::AddRoms(const QList<RomSearcherThreadData>& data)
+{
+    std::vector<int> newRowSlots;
+
+    for (const RomSearcherThreadData& romData : data)
+    {
+        // replace ROMs which have changed in place,
+        // so they keep their row
+        auto iter = this->fileSlots.constFind(romData.File);
+        if (iter != this->fileSlots.cend())
+        {
+            int slot = iter.value();
+            this->setRom(slot, romData);
+
+            int row = this->slotRows[slot];
+            if (row != -1)
+            {
+                emit this->dataChanged(this->index(row, 0), this->index(row, this->columnNames.size() - 1));
+            }
+            continue;
+        }
+
+        int slot = this->allocateSlot();
+        this->setRom(slot, romData);
+        this->fileSlots.insert(romData.File, slot);
+        newRowSlots.push_back(slot);
+    }
+
+    if (newRowSlots.empty())
+    {
+        return;
+    }
+
+    int firstRow = this->rowSlots.size();
+    this->beginInsertRows(QModelIndex(), firstRow, firstRow + newRowSlots.size() - 1);
+    for (int slot : newRowSlots)
+    {
+        this->slotRows[slot] = this->rowSlots.size();
+        this->rowSlots.push_back(slot);
+    }
+    this->endInsertRows();
+}
+
+void RomBrowserModel::RemoveRoms(const QStringList& files)
+{
+    for (const QString& file : files)
+    {
+        auto iter = this->fileSlots.constFind(file);
+        if (iter != this->fileSlots.cend())
+        {
+            this->removeRom(iter.value());
+        }
+    }
+}
+
+QSet<QString> RomBrowserModel::GetFiles(void) const
+{
+    QSet<QString> files;
+    files.reserve(this->fileSlots.size());
+
+    for (auto iter = this->fileSlots.cbegin(); iter != this->fileSlots.cend(); iter++)
+    {
+        files.insert(iter.key());
+    }
+
+    return files;
+}
+
+bool RomBrowserModel::GetRomData(const QModelIndex& index, RomBrowserModelData& data) const
+{
+    int slot = this->getSlot(index);
+    if (slot == -1)
+    {
+        return false;
+    }
+
+    data = this->getRomData(slot);
+    return true;
+}
+
+QList<RomBrowserModelData> RomBrowserModel::GetAllRomData(void) const
+{
+    QList<RomBrowserModelData> data;
+    data.reserve(this->rowSlots.size());
+
+    for (int slot : this->rowSlots)
+    {
+        data.append(this->getRomData(slot));
+    }
+
+    return data;
+}
+
+int RomBrowserModel::GetRomId(const QModelIndex& index) const
+{
+    int slot = this->getSlot(index);
+    if (slot == -1)
+    {
+        return -1;
+    }
+
+    return this->romIds[slot];
+}
+
+void RomBrowserModel::SetShowCovers(bool value)
+{
+    if (this->showCovers == value)
+    {
+        return;
+    }
+
+    this->showCovers = value;
+
+    if (!this->rowSlots.empty())
+    {
+        emit this->dataChanged(this->index(0, COLUMN_NAME), this->index(this->rowSlots.size() - 1, COLUMN_NAME), { Qt::DecorationRole });
+    }
+}
+
+void RomBrowserModel::SetCoverPlaceholder(QIcon icon)
+{
+    this->coverPlaceholder = icon;
+}
+
+QSize RomBrowserModel::GetRequestedCoverSize(const QModelIndex& index) const
+{
+    int slot = this->getSlot(index);
+    if (slot == -1)
+    {
+        return QSize();
+    }
+
+    return this->coverSizes[slot];
+}
+
+void RomBrowserModel::SetRequestedCoverSize(const QModelIndex& index, QSize size)
+{
+    int slot = this->getSlot(index);
+    if (slot == -1)
+    {
+        return;
+    }
+
+    this->coverSizes[slot] = size;
+}
+
+void RomBrowserModel::SetCover(int romId, QIcon icon, QString coverFile)
+{
+    // the ROM might've been removed
+    // or replaced in the meantime
+    auto iter = this->romIdSlots.constFind(romId);
+    if (iter == this->romIdSlots.cend())
+    {
+        return;
+    }
+
+    int slot = iter.value();
+
+    this->covers[slot]     = icon;
+    this->coverFiles[slot] = coverFile;
+
+    int row = this->slotRows[slot];
+    if (row != -1 && this->showCovers)
+    {
+        QModelIndex index = this->index(row, COLUMN_NAME);
+        emit this->dataChanged(index, index, { Qt::DecorationRole });
+    }
+}
+
+//
+// Private Functions
+//
+
+int RomBrowserModel::getSlot(const QModelIndex& index) const
+{
+    if (!index.isValid() ||
+        index.model() != this ||
+        index.row() >= (int)this->rowSlots.size())
+    {
+        return -1;
+    }
+
+    return this->rowSlots[index.row()];
+}
+
+int RomBrowserModel::allocateSlot(void)
+{
+    if (!this->freeSlots.empty())
+    {
+        int slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+        return slot;
+    }
+
+    this->files.emplace_back();
+    this->types.emplace_back();
+    this->headers.emplace_back();
+    this->settings.emplace_back();
+    this->names.emplace_back();
+    this->fileSizes.emplace_back();
+    this->covers.emplace_back();
+    this->coverFiles.emplace_back();
+    this->coverSizes.emplace_back();
+    for (std::vector<QString>& columnTexts : this->texts)
+    {
+        columnTexts.emplace_back();
+    }
+    this->romIds.push_back(-1);
+    this->slotRows.push_back(-1);
+
+    return this->files.size() - 1;
+}
+
+void RomBrowserModel::setRom(int slot, const RomSearcherThreadData& data)
+{
+    // generate name to use in UI
+    QString name = QString::fromStdString(data.Settings.GoodName);
+    if (name.endsWith("(unknown rom)") ||
+        name.endsWith("(unknown disk)"))
+    {
+        name = QFileInfo(data.File).fileName();
+    }
+
+    // give the ROM a new id, so covers
+    // requested for the ROM which was
+    // in this slot before are ignored
+    this->romIdSlots.remove(this->romIds[slot]);
+    this->romIds[slot] = this->nextRomId++;
+    this->romIdSlots.insert(this->romIds[slot], slot);
+
+    this->files[slot]      = data.File;
+    this->types[slot]      = data.Type;
+    this->headers[slot]    = data.Header;
+    this->settings[slot]   = data.Settings;
+    this->names[slot]      = name;
+    this->fileSizes[slot]  = data.FileSize;
+    this->covers[slot]     = QIcon();
+    this->coverFiles[slot] = QString();
+    this->coverSizes[slot] = QSize();
+
+    for (size_t column = 0; column < this->texts.size(); column++)
+    {
+        this->texts[column][slot] = this->createText(slot, column);
+    }
+}
+
+QString RomBrowserModel::createText(int slot, int column) const
+{
+    switch (column)
+    {
+    default:
+        return QString();
+    case COLUMN_NAME:
+        return this->names[slot];
+    case COLUMN_INTERNAL_NAME:
+        return QString::fromStdString(this->headers[slot].Name);
+    case COLUMN_MD5:
+        return QString::fromStdString(this->settings[slot].MD5);
+    case COLUMN_FORMAT:
+        return this->types[slot] == CoreRomType::Disk ? "Disk" : "Cartridge";
+    case COLUMN_FILE_NAME:
+        return QFileInfo(this->files[slot]).completeBaseName();
+    case COLUMN_FILE_EXT:
+        return QFileInfo(this->files[slot]).suffix().prepend(".").toUpper();
+    case COLUMN_FILE_SIZE:
+    {
+        QString fileSizeString = QString::number(this->fileSizes[slot] / 1048576.0, 'f', 2).append(" MB");
+        if (fileSizeString.size() == 7)
+        {
+            fileSizeString.prepend("  ");
+        }
+        return fileSizeString;
+    }
+    case COLUMN_GAME_ID:
+        return QString::fromStdString(this->headers[slot].GameID);
+    case COLUMN_REGION:
+        return QString::fromStdString(this->headers[slot].Region);
+    }
+}
+
+RomBrowserModelData RomBrowserModel::getRomData(int slot) const
+{
+    RomBrowserModelData data;
+    data.file      = this->files[slot];
+    data.name      = this->names[slot];
+    data.type      = this->types[slot];
+    data.header    = this->headers[slot];
+    data.settings  = this->settings[slot];
+    data.coverFile = this->coverFiles[slot];
+    return data;
+}
+
+void RomBrowserModel::updateRows(const std::vector<int>& newRowSlots, QAbstractItemModel::LayoutChangeHint hint)
+{
+    emit this->layoutAboutToBeChanged({}, hint);
+
+    // retrieve the ROMs of the persistent
+    // indexes before the rows change
+    QModelIndexList oldIndexes = this->persistentIndexList();
+    std::vector<int> oldSlots;
+    oldSlots.reserve(oldIndexes.size());
+    for (const QModelIndex& index : oldIndexes)
+    {
+        oldSlots.push_back(this->getSlot(index));
+    }
+
+    this->rowSlots = newRowSlots;
+    for (size_t i = 0; i < this->rowSlots.size(); i++)
+    {
+        this->slotRows[this->rowSlots[i]] = i;
+    }
+
+    // move the persistent indexes
+    // to the new rows of their ROMs
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (qsizetype i = 0; i < oldIndexes.size(); i++)
+    {
+        int slot = oldSlots[i];
+        if (slot == -1)
+        {
+            newIndexes.append(QModelIndex());
+        }
+        else
+        {
+            newIndexes.append(this->index(this->slotRows[slot], oldIndexes[i].column()));
+        }
+    }
+    this->changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit this->layoutChanged({}, hint);
+}
+
+void RomBrowserModel::removeRom(int slot)
+{
+    int row = this->slotRows[slot];
+
+    this->beginRemoveRows(QModelIndex(), row, row);
+    this->slotRows[slot] = -1;
+    this->rowSlots.erase(this->rowSlots.begin() + row);
+    for (size_t i = row; i < this->rowSlots.size(); i++)
+    {
+        this->slotRows[this->rowSlots[i]] = i;
+    }
+    this->endRemoveRows();
+
+    this->fileSlots.remove(this->files[slot]);
+    this->romIdSlots.remove(this->romIds[slot]);
+    this->romIds[slot] = -1;
+
+    // release the data of the ROM,
+    // the slot is reused by the next ROM
+    this->files[slot]      = QString();
+    this->headers[slot]    = CoreRomHeader();
+    this->settings[slot]   = CoreRomSettings();
+    this->names[slot]      = QString();
+    this->covers[slot]     = QIcon();
+    this->coverFiles[slot] = QString();
+    for (std::vector<QString>& columnTexts : this->texts)
+    {
+        columnTexts[slot] = QString();
+    }
+    this->freeSlots.push_back(slot);
+}
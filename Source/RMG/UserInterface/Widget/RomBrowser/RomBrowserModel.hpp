@@ -0,0 +1,153 @@
+/*
+ * Rosalie's Mupen GUI - https://github.com/Rosalie241/RMG
+ *  Copyright (C) 2020 Rosalie Wanders <rosalie@mailbox.org>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3.
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef ROMBROWSERMODEL_HPP
+#define ROMBROWSERMODEL_HPP
+
+#include "Thread/RomSearcherThread.hpp"
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QString>
+#include <QIcon>
+#include <QSize>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+#include <vector>
+
+struct RomBrowserModelData
+{
+    QString         file;
+    QString         name;
+    CoreRomType     type;
+    CoreRomHeader   header;
+    CoreRomSettings settings;
+    QString         coverFile;
+};
+
+Q_DECLARE_METATYPE(RomBrowserModelData);
+
+namespace UserInterface
+{
+namespace Widget
+{
+// Table model shared by the list and grid view of the ROM browser.
+// The ROMs are stored per column in slots and referred to by an id, the
+// rows are a permutation of those slots, which is what sorting changes,
+// so it doesn't have to touch the stored ROM data.
+class RomBrowserModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+  public:
+    RomBrowserModel(QObject* parent);
+    ~RomBrowserModel(void);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) Q_DECL_OVERRIDE;
+
+    // removes all ROMs
+    void Clear(void);
+
+    // appends the given ROMs, they're sorted
+    // at the next call to sort(), ROMs which
+    // have been added before are replaced in place
+    void AddRoms(const QList<RomSearcherThreadData>& data);
+
+    // removes the ROMs with the given files
+    void RemoveRoms(const QStringList& files);
+
+    // returns the files of all ROMs
+    QSet<QString> GetFiles(void) const;
+
+    // returns whether retrieving the ROM data
+    // of the given index succeeds
+    bool GetRomData(const QModelIndex& index, RomBrowserModelData& data) const;
+
+    // returns the data of all ROMs
+    // in the current order
+    QList<RomBrowserModelData> GetAllRomData(void) const;
+
+    // returns the id of the ROM at the given index,
+    // which stays valid until the ROM is removed
+    // or replaced, ids are never reused
+    int GetRomId(const QModelIndex& index) const;
+
+    // sets whether the covers are returned as
+    // decoration of the first column
+    void SetShowCovers(bool value);
+
+    // sets the icon which is shown until
+    // a cover has been set
+    void SetCoverPlaceholder(QIcon icon);
+
+    // returns the size the cover of the
+    // ROM at the given index was requested at
+    QSize GetRequestedCoverSize(const QModelIndex& index) const;
+
+    // sets the size the cover of the ROM
+    // at the given index was requested at
+    void SetRequestedCoverSize(const QModelIndex& index, QSize size);
+
+    // sets the cover of the ROM with the given id
+    void SetCover(int romId, QIcon icon, QString coverFile);
+
+  private:
+    QStringList columnNames;
+
+    // ROM data, indexed by slot, the slots of
+    // removed ROMs are reused by the next ROMs
+    std::vector<int>             freeSlots;
+    QHash<QString, int>          fileSlots;
+    std::vector<QString>         files;
+    std::vector<CoreRomType>     types;
+    std::vector<CoreRomHeader>   headers;
+    std::vector<CoreRomSettings> settings;
+    std::vector<QString>         names;
+    std::vector<qint64>          fileSizes;
+    std::vector<QIcon>           covers;
+    std::vector<QString>         coverFiles;
+    std::vector<QSize>           coverSizes;
+
+    // the text of every column, created
+    // when the ROM is added, which is
+    // what's displayed and sorted by
+    std::vector<std::vector<QString>> texts;
+
+    // the id of every slot, and the
+    // slot of every id
+    int nextRomId = 0;
+    std::vector<int> romIds;
+    QHash<int, int>  romIdSlots;
+
+    // the slot of every row, and the row
+    // of every slot, or -1 when it has none
+    std::vector<int> rowSlots;
+    std::vector<int> slotRows;
+
+    bool  showCovers = false;
+    QIcon coverPlaceholder;
+
+    int getSlot(const QModelIndex& index) const;
+    int allocateSlot(void);
+    void setRom(int slot, const RomSearcherThreadData& data);
+    QString createText(int slot, int column) const;
+    RomBrowserModelData getRomData(int slot) const;
+    void updateRows(const std::vector<int>& newRowSlots, QAbstractItemModel::LayoutChangeHint hint);
+    void removeRom(int slot);
+};
+} // namespace Widget
+} // namespace UserInterface
+
+#endif // ROMBROWSERMODEL_HPP
@@ -9,11 +9,15 @@
  */
 #include "RomBrowserWidget.hpp"
 
+#include <QCryptographicHash>
 #include <QDesktopServices>
+#include <QApplication>
+#include <QImageReader>
 #include <QFileDialog>
 #include <QGridLayout>
 #include <QBoxLayout>
 #include <QScrollBar>
+#include <QSaveFile>
 #include <QPixmap>
 #include <QLabel>
 #include <vector>
@@ -28,29 +32,145 @@
 using namespace UserInterface::Widget;
 
 //
-// Internal Struct
+// Local Functions
 //
 
-struct RomBrowserModelData
+static QStringList get_cover_names(QString file, CoreRomHeader header, CoreRomSettings settings)
 {
-    QString         file;
-    CoreRomType     type;
-    CoreRomHeader   header;
-    CoreRomSettings settings;
-    QString         coverFile;
+    QStringList coverNames;
 
-    RomBrowserModelData() {}
+    // construct basename of file,
+    // by retrieving the last index of '.'
+    // and removing all characters from that index
+    // until the end of the string
+    QString baseName         = QFileInfo(file).fileName();
+    qsizetype lastIndexOfDot = baseName.lastIndexOf(".");
+    if (lastIndexOfDot != -1)
+    { // only remove when index was found
+        baseName.remove(lastIndexOfDot, baseName.size() - lastIndexOfDot);
+    }
+
+    // try to load cover using
+    // 1) basename of file
+    // 2) MD5
+    // 3) good name
+    // 4) internal name
+    for (QString name : { 
+        baseName,
+        QString::fromStdString(settings.MD5), 
+        QString::fromStdString(settings.GoodName), 
+        QString::fromStdString(header.Name) })
+    {
+        // fixup file name
+        QString fixedName = name;
+        for (const QChar c : QString(":<>\"/\\|?*"))
+        {
+            fixedName.replace(c, "_");
+        }
+
+        // skip empty names,
+        // this can i.e happen
+        // when ROMs don't have 
+        // an internal ROM name
+        if (fixedName.isEmpty())
+        {
+            continue;
+        }
 
-    RomBrowserModelData(QString file, CoreRomType type, CoreRomHeader header, CoreRomSettings settings)
+        coverNames.append(fixedName);
+    }
+
+    return coverNames;
+}
+
+static QImage load_cover_image(QString coversDirectory, QString thumbnailsDirectory, QStringList coverNames, QSize size, QString& coverFile)
+{
+    QImage image;
+
+    for (const QString& name : coverNames)
     {
-        this->file     = file;
-        this->type     = type;
-        this->header   = header;
-        this->settings = settings;
+        // we support jpg & png as file extensions
+        for (QString ext : { ".png", ".jpg", ".jpeg" })
+        {
+            QString coverPath = coversDirectory;
+            coverPath += "/";
+            coverPath += name;
+            coverPath += ext;
+
+            QFileInfo coverInfo(coverPath);
+            if (!coverInfo.exists())
+            {
+                continue;
+            }
+
+            // thumbnails are named after the cover file,
+            // its modification time and the size, so only
+            // the prefix is needed to find all of them
+            QString thumbnailPrefix = QString::fromLatin1(QCryptographicHash::hash(coverPath.toUtf8(), QCryptographicHash::Md5).toHex());
+            thumbnailPrefix += "-";
+
+            QString thumbnailName = thumbnailPrefix;
+            thumbnailName += QString::number(coverInfo.lastModified().toMSecsSinceEpoch());
+            thumbnailName += "-";
+            thumbnailName += QString::number(size.width()) + "x" + QString::number(size.height());
+            thumbnailName += ".png";
+
+            QString thumbnailPath = thumbnailsDirectory;
+            thumbnailPath += "/";
+            thumbnailPath += thumbnailName;
+
+            if (QFile::exists(thumbnailPath) &&
+                image.load(thumbnailPath))
+            {
+                coverFile = coverPath;
+                return image;
+            }
+
+            // only decode the cover at the size it's
+            // shown at, which for JPEG also saves
+            // decoding the full resolution image
+            QImageReader reader(coverPath);
+            QSize imageSize = reader.size();
+            if (imageSize.isValid() &&
+                (imageSize.width() > size.width() || imageSize.height() > size.height()))
+            {
+                reader.setScaledSize(imageSize.scaled(size, Qt::KeepAspectRatio));
+            }
+
+            if (!reader.read(&image))
+            {
+                continue;
+            }
+
+            // save thumbnail atomically, because
+            // the same cover can be loaded by
+            // multiple workers at once
+            QDir().mkpath(thumbnailsDirectory);
+            QSaveFile thumbnailFile(thumbnailPath);
+            if (thumbnailFile.open(QIODevice::WriteOnly) &&
+                image.save(&thumbnailFile, "PNG") &&
+                thumbnailFile.commit())
+            {
+                // only keep the thumbnail which was just written,
+                // thumbnails of other sizes or of an older cover
+                // would otherwise pile up with every zoom step
+                QDir thumbnailsDir(thumbnailsDirectory);
+                for (const QString& file : thumbnailsDir.entryList({ thumbnailPrefix + "*.png" }, QDir::Files))
+                {
+                    if (file != thumbnailName)
+                    {
+                        thumbnailsDir.remove(file);
+                    }
+                }
+            }
+
+            coverFile = coverPath;
+            return image;
+        }
     }
-};
 
-Q_DECLARE_METATYPE(RomBrowserModelData);
+    return QImage();
+}
 
 //
 // Exported Functions
@@ -61,11 +181,39 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
     // configure signal types
     qRegisterMetaType<CoreRomType>("CoreRomType");
 
+    // configure cover icons, the placeholder is shown
+    // until the cover has been loaded, it has the same
+    // size as the fallback to prevent layout changes
+    QPixmap coverFallbackPixmap(":Resource/CoverFallback.png");
+    QPixmap coverPlaceholderPixmap(coverFallbackPixmap.size());
+    coverPlaceholderPixmap.fill(Qt::transparent);
+    this->coverFallbackIcon = QIcon(coverFallbackPixmap);
+
+    // configure model, which is shared by the list and grid view
+    this->model = new Widget::RomBrowserModel(this);
+    this->model->SetCoverPlaceholder(QIcon(coverPlaceholderPixmap));
+
+    // configure cover loader, covers are loaded
+    // shortly after the visible items have changed
+    this->coverLoaderTimer.setSingleShot(true);
+    this->coverLoaderTimer.setInterval(50);
+    connect(&this->coverLoaderTimer, &QTimer::timeout, this, &RomBrowserWidget::loadVisibleCovers);
+
     // configure rom searcher thread
     this->romSearcherThread = new Thread::RomSearcherThread(this);
     connect(this->romSearcherThread, &Thread::RomSearcherThread::RomsFound, this, &RomBrowserWidget::on_RomBrowserThread_RomsFound);
+    connect(this->romSearcherThread, &Thread::RomSearcherThread::RomsRemoved, this, &RomBrowserWidget::on_RomBrowserThread_RomsRemoved);
+    connect(this->romSearcherThread, &Thread::RomSearcherThread::DirectoriesFound, this, &RomBrowserWidget::on_RomBrowserThread_DirectoriesFound);
     connect(this->romSearcherThread, &Thread::RomSearcherThread::Finished, this, &RomBrowserWidget::on_RomBrowserThread_Finished);
 
+    // configure ROM directory watcher, changes are applied
+    // shortly after the last change, so i.e copying
+    // multiple ROMs only causes a single update
+    this->romDirectoryTimer.setSingleShot(true);
+    this->romDirectoryTimer.setInterval(1000);
+    connect(&this->romDirectoryTimer, &QTimer::timeout, this, &RomBrowserWidget::updateRomList);
+    connect(&this->romDirectoryWatcher, &QFileSystemWatcher::directoryChanged, this, &RomBrowserWidget::on_romDirectoryWatcher_directoryChanged);
+
     // configure empty widget
     this->emptyWidget = new Widget::RomBrowserEmptyWidget(this);
     this->addWidget(this->emptyWidget);
@@ -81,8 +229,7 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
 
     // configure list view widget
     this->listViewWidget = new Widget::RomBrowserListViewWidget(this);
-    this->listViewModel  = new QStandardItemModel(this);
-    this->listViewWidget->setModel(this->listViewModel);
+    this->listViewWidget->setModel(this->model);
     this->listViewWidget->setFrameStyle(QFrame::NoFrame);
     this->listViewWidget->setItemDelegate(new NoFocusDelegate(this));
     this->listViewWidget->setWordWrap(false);
@@ -93,7 +240,7 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
     this->listViewWidget->setSelectionMode(QAbstractItemView::SingleSelection);
     this->listViewWidget->setVerticalScrollMode(QAbstractItemView::ScrollMode::ScrollPerPixel);
     this->listViewWidget->verticalHeader()->hide();
-    this->listViewWidget->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    this->listViewWidget->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     this->listViewWidget->horizontalHeader()->setSectionsMovable(true);
     this->listViewWidget->horizontalHeader()->setFirstSectionMovable(true);
     this->listViewWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
@@ -111,35 +258,20 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
     connect(this->listViewWidget, &Widget::RomBrowserListViewWidget::ZoomOut, this, &RomBrowserWidget::on_ZoomOut);
     connect(this->listViewWidget, &Widget::RomBrowserListViewWidget::FileDropped, this, &RomBrowserWidget::FileDropped);
 
-    // set up list view's columns
-    QStringList labels;
-    labels << "Name";
-    labels << "Internal Name";
-    labels << "MD5";
-    labels << "Format";
-    labels << "File Name";
-    labels << "File Ext.";
-    labels << "File Size";
-    labels << "I.D.";
-    labels << "Region";
-    this->listViewModel->setColumnCount(labels.size());
-    this->listViewModel->setHorizontalHeaderLabels(labels);
-
     // set full names of list view's columns
-    this->columnNames << labels.at(0);
-    this->columnNames << labels.at(1);
-    this->columnNames << labels.at(2);
+    this->columnNames << this->model->headerData(0, Qt::Horizontal).toString();
+    this->columnNames << this->model->headerData(1, Qt::Horizontal).toString();
+    this->columnNames << this->model->headerData(2, Qt::Horizontal).toString();
     this->columnNames << "Game Format";
-    this->columnNames << labels.at(4);
+    this->columnNames << this->model->headerData(4, Qt::Horizontal).toString();
     this->columnNames << "File Extension";
-    this->columnNames << labels.at(6);
+    this->columnNames << this->model->headerData(6, Qt::Horizontal).toString();
     this->columnNames << "Game I.D.";
     this->columnNames << "Game Region";
 
     // configure grid view widget
     this->gridViewWidget = new Widget::RomBrowserGridViewWidget(this);
-    this->gridViewModel  = new QStandardItemModel(this);
-    this->gridViewWidget->setModel(this->gridViewModel);
+    this->gridViewWidget->setModel(this->model);
     this->gridViewWidget->setFlow(QListView::Flow::LeftToRight);
     this->gridViewWidget->setResizeMode(QListView::Adjust);
 #ifndef DRAG_DROP
@@ -163,6 +295,11 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
     connect(this->gridViewWidget, &Widget::RomBrowserGridViewWidget::ZoomIn, this, &RomBrowserWidget::on_ZoomIn);
     connect(this->gridViewWidget, &Widget::RomBrowserGridViewWidget::ZoomOut, this, &RomBrowserWidget::on_ZoomOut);
     connect(this->gridViewWidget, &Widget::RomBrowserGridViewWidget::FileDropped, this, &RomBrowserWidget::FileDropped);
+    connect(this->gridViewWidget->verticalScrollBar(), &QScrollBar::valueChanged, &this->coverLoaderTimer, qOverload<>(&QTimer::start));
+    connect(this->gridViewWidget->verticalScrollBar(), &QScrollBar::rangeChanged, &this->coverLoaderTimer, qOverload<>(&QTimer::start));
+    connect(this->model, &QAbstractItemModel::rowsInserted, &this->coverLoaderTimer, qOverload<>(&QTimer::start));
+    connect(this->model, &QAbstractItemModel::layoutChanged, &this->coverLoaderTimer, qOverload<>(&QTimer::start));
+    connect(this, &QStackedWidget::currentChanged, &this->coverLoaderTimer, qOverload<>(&QTimer::start));
 
 #ifdef DRAG_DROP
     // configure drag & drop
@@ -256,21 +393,35 @@ RomBrowserWidget::RomBrowserWidget(QWidget *parent) : QStackedWidget(parent)
     {
         this->currentViewWidget = this->gridViewWidget;
     }
+
+    // covers are only shown in the grid view
+    this->model->SetShowCovers(this->currentViewWidget == this->gridViewWidget);
 }
 
 RomBrowserWidget::~RomBrowserWidget()
 {
+    this->coverLoaderPool.clear();
+    this->coverLoaderPool.waitForDone();
 }
 
-void RomBrowserWidget::RefreshRomList(void)
+void RomBrowserWidget::RefreshRomList(bool useSnapshot)
 {
-    this->listViewModel->removeRows(0, this->listViewModel->rowCount());
-    this->gridViewModel->removeRows(0, this->gridViewModel->rowCount());
+    this->model->Clear();
 
     this->menu_PlayGameWithDisk->clear();
 
+    // a full refresh includes the pending changes
+    this->romDirectoryTimer.stop();
+    this->changedRomDirectories.clear();
+    this->romSearcherIncremental = false;
+
+    // don't load covers for the removed items
+    this->coverLoaderPool.clear();
+
     this->coversDirectory = QString::fromStdString(CoreGetUserDataDirectory().string());
     this->coversDirectory += "/Covers";
+    this->coverThumbnailsDirectory = QString::fromStdString(CoreGetUserCacheDirectory().string());
+    this->coverThumbnailsDirectory += "/CoverThumbnails";
 
     this->listViewSortSection = CoreSettingsGetIntValue(SettingsID::RomBrowser_ListViewSortSection);
     this->listViewSortOrder   = CoreSettingsGetIntValue(SettingsID::RomBrowser_ListViewSortOrder);
@@ -278,16 +429,23 @@ void RomBrowserWidget::RefreshRomList(void)
     QString directory = QString::fromStdString(CoreSettingsGetStringValue(SettingsID::RomBrowser_Directory));
     if (directory.isEmpty())
     {
+        if (!this->romDirectoryWatcher.directories().isEmpty())
+        {
+            this->romDirectoryWatcher.removePaths(this->romDirectoryWatcher.directories());
+        }
+
         this->setCurrentWidget(this->emptyWidget);
         return;
     }
 
     this->setCurrentWidget(this->loadingWidget);
     this->romSearcherTimer.start();
+    this->romSearcherTraceStart = CoreTraceBegin();
 
     this->romSearcherThread->SetMaximumFiles(CoreSettingsGetIntValue(SettingsID::RomBrowser_MaxItems));
     this->romSearcherThread->SetRecursive(CoreSettingsGetBoolValue(SettingsID::RomBrowser_Recursive));
     this->romSearcherThread->SetDirectory(directory);
+    this->romSearcherThread->SetUseSnapshot(useSnapshot);
     this->romSearcherThread->start();
 }
 
@@ -304,6 +462,7 @@ void RomBrowserWidget::StopRefreshRomList(void)
 void RomBrowserWidget::ShowList(void)
 {
     this->currentViewWidget = this->listViewWidget;
+    this->model->SetShowCovers(false);
 
     // only change widget now when we're not refreshing
     if (!this->IsRefreshingRomList() &&
@@ -316,6 +475,7 @@ void RomBrowserWidget::ShowList(void)
 void RomBrowserWidget::ShowGrid(void)
 {
     this->currentViewWidget = this->gridViewWidget;
+    this->model->SetShowCovers(true);
 
     // only change widget now when we're not refreshing
     if (!this->IsRefreshingRomList() &&
@@ -346,17 +506,9 @@ void RomBrowserWidget::SetGridViewUniformSizes(bool value)
 QMap<QString, CoreRomSettings> RomBrowserWidget::GetModelData(void)
 {
     QMap<QString, CoreRomSettings> data;
-    QStandardItemModel* model = this->getCurrentModel();
-    RomBrowserModelData modelData;
 
-    if (model == nullptr)
+    for (const RomBrowserModelData& modelData : this->model->GetAllRomData())
     {
-        return data;
-    }
-
-    for (int i = 0; i < model->rowCount(); i++)
-    {
-        modelData = model->item(i)->data().value<RomBrowserModelData>();
         // only add cartridges, 64dd disks aren't supported
         if (modelData.type == CoreRomType::Cartridge)
         {
@@ -367,26 +519,6 @@ QMap<QString, CoreRomSettings> RomBrowserWidget::GetModelData(void)
     return data;
 }
 
-QStandardItemModel* RomBrowserWidget::getCurrentModel(void)
-{
-    QWidget* currentWidget = this->currentWidget();
-    if (currentWidget == this->loadingWidget)
-    {
-        currentWidget = this->currentViewWidget;
-    }
-
-    if (currentWidget == this->listViewWidget)
-    {
-        return this->listViewModel;
-    }
-    else if (currentWidget == this->gridViewWidget)
-    {
-        return this->gridViewModel;
-    }
-
-    return nullptr;
-}
-
 QAbstractItemView* RomBrowserWidget::getCurrentModelView(void)
 {
     QWidget* currentWidget = this->currentWidget();
@@ -409,24 +541,14 @@ QAbstractItemView* RomBrowserWidget::getCurrentModelView(void)
 
 bool RomBrowserWidget::getCurrentData(RomBrowserModelData& data)
 {
-    QStandardItemModel* model = this->getCurrentModel();
-    QAbstractItemView*  view  = this->getCurrentModelView();
-
-    if (model == nullptr || view == nullptr)
-    {
-        return false;
-    }
-
-    QModelIndex    index = view->currentIndex();
-    QStandardItem* item  = model->item(index.row(), 0);
+    QAbstractItemView* view = this->getCurrentModelView();
 
-    if (item == nullptr)
+    if (view == nullptr)
     {
         return false;
     }
 
-    data = item->data().value<RomBrowserModelData>();
-    return true;
+    return this->model->GetRomData(view->currentIndex(), data);
 }
 
 
@@ -442,172 +564,117 @@ QString RomBrowserWidget::getCurrentRom(void)
     return data.file;
 }
 
-void RomBrowserWidget::addRomData(QString file, CoreRomType type, CoreRomHeader header, CoreRomSettings settings)
+void RomBrowserWidget::updateRomList(void)
 {
-    QString name;
-    QString gameFormat;
-    float fileSize;
-    QString fileSizeString;
-    QString coverFile;
-    QIcon   coverIcon;
-    QVariant itemData;
-    RomBrowserModelData modelData;
-
-    // create item data
-    modelData = RomBrowserModelData(file, type, header, settings);
-
-    // generate name to use in UI
-    name = QString::fromStdString(settings.GoodName);
-    if (name.endsWith("(unknown rom)") ||
-        name.endsWith("(unknown disk)"))
+    // ROMs can't be read while searching, emulating
+    // or when a dialog is open which might've opened
+    // a ROM, so try again later on
+    if (this->IsRefreshingRomList() ||
+        !this->isVisible() ||
+        QApplication::activeModalWidget() != nullptr)
     {
-        name = QFileInfo(file).fileName();
+        this->romDirectoryTimer.start();
+        return;
     }
 
-    // generate game format to use in UI
-    if (type == CoreRomType::Disk)
+    // show the loading widget like usual
+    // when there weren't any ROMs yet
+    if (this->currentWidget() == this->emptyWidget)
     {
-        gameFormat = "Disk";
+        this->RefreshRomList(true);
+        return;
     }
-    else
-    {
-        gameFormat = "Cartridge";
-    }
-
-    // generate file size to use in UI
-    fileSize = QFileInfo(file).size()/1048576.0;
-    fileSizeString = (QString::number(fileSize, 'f', 2)).append(" MB");
-    if (fileSizeString.size() == 7)
-    {
-        fileSizeString = fileSizeString.prepend("  ");
-    }
-
-    // retrieve cover image
-    coverIcon = this->getCurrentCover(file, header, settings, coverFile);
-    modelData.coverFile = coverFile;
-
-    // create item data
-    itemData = QVariant::fromValue<RomBrowserModelData>(modelData);
-
-    QList<QStandardItem*> listViewRow;
-    // goodname
-    QStandardItem* listViewItem1 = new QStandardItem();
-    listViewItem1->setText(name);
-    listViewItem1->setData(itemData);
-    listViewRow.append(listViewItem1);
-    // internal name
-    QStandardItem* listViewItem2 = new QStandardItem();
-    listViewItem2->setText(QString::fromStdString(header.Name));
-    listViewRow.append(listViewItem2);
-    // MD5
-    QStandardItem* listViewItem3 = new QStandardItem();
-    listViewItem3->setText(QString::fromStdString(settings.MD5));
-    listViewRow.append(listViewItem3);
-    // game format
-    QStandardItem* listViewItem4 = new QStandardItem();
-    listViewItem4->setText(gameFormat);
-    listViewRow.append(listViewItem4);
-    // file name
-    QStandardItem* listViewItem5 = new QStandardItem();
-    listViewItem5->setText(QFileInfo(file).completeBaseName());
-    listViewRow.append(listViewItem5);
-    // file extension
-    QStandardItem* listViewItem6 = new QStandardItem();
-    listViewItem6->setText(((QFileInfo(file).suffix()).prepend(".")).toUpper());
-    listViewRow.append(listViewItem6);
-    // file size
-    QStandardItem* listViewItem7 = new QStandardItem();
-    listViewItem7->setText(fileSizeString);
-    listViewRow.append(listViewItem7);
-    // game i.d.
-    QStandardItem* listViewItem8 = new QStandardItem();
-    listViewItem8->setText(QString::fromStdString(header.GameID));
-    listViewRow.append(listViewItem8);
-    // region
-    QStandardItem* listViewItem9 = new QStandardItem();
-    listViewItem9->setText(QString::fromStdString(header.Region));
-    listViewRow.append(listViewItem9);
-    this->listViewModel->appendRow(listViewRow);
-
-    QStandardItem* gridViewItem = new QStandardItem();
-    gridViewItem->setIcon(coverIcon);
-    gridViewItem->setText(name);
-    gridViewItem->setData(itemData);
-    this->gridViewModel->appendRow(gridViewItem);
+
+    this->romSearcherIncremental = true;
+    this->romSearcherThread->SetUseSnapshot(true);
+    this->romSearcherThread->SetIncremental(this->model->GetFiles(), this->changedRomDirectories);
+    this->changedRomDirectories.clear();
+    this->romSearcherThread->start();
 }
 
-QIcon RomBrowserWidget::getCurrentCover(QString file, CoreRomHeader header, CoreRomSettings settings, QString& coverFileName)
+void RomBrowserWidget::loadVisibleCovers(void)
 {
-    QPixmap pixmap;
-
-    // construct basename of file,
-    // by retrieving the last index of '.'
-    // and removing all characters from that index
-    // until the end of the string
-    QString baseName         = QFileInfo(file).fileName();
-    qsizetype lastIndexOfDot = baseName.lastIndexOf(".");
-    if (lastIndexOfDot != -1)
-    { // only remove when index was found
-        baseName.remove(lastIndexOfDot, baseName.size() - lastIndexOfDot);
+    if (this->currentWidget() != this->gridViewWidget)
+    {
+        return;
     }
 
-    // try to load cover using
-    // 1) basename of file
-    // 2) MD5
-    // 3) good name
-    // 4) internal name
-    bool foundCover = false;
-    for (QString name : { 
-        baseName,
-        QString::fromStdString(settings.MD5), 
-        QString::fromStdString(settings.GoodName), 
-        QString::fromStdString(header.Name) })
-    {
-        // fixup file name
-        QString fixedName = name;
-        for (const QChar c : QString(":<>\"/\\|?*"))
-        {
-            fixedName.replace(c, "_");
-        }
+    QSize iconSize = this->gridViewWidget->iconSize();
+    QRect viewportRect = this->gridViewWidget->viewport()->rect();
 
-        // skip empty names,
-        // this can i.e happen
-        // when ROMs don't have 
-        // an internal ROM name
-        if (fixedName.isEmpty())
-        {
-            continue;
-        }
+    // also load the covers of the next page,
+    // so they're ready when scrolling down
+    viewportRect.setBottom(viewportRect.bottom() + viewportRect.height());
 
-        // we support jpg & png as file extensions
-        for (QString ext : { ".png", ".jpg", ".jpeg" })
-        {
-            QString coverPath = this->coversDirectory;
-            coverPath += "/";
-            coverPath += fixedName;
-            coverPath += ext;
+    for (int i = 0; i < this->model->rowCount(); i++)
+    {
+        QModelIndex index = this->model->index(i, 0);
+        QRect itemRect = this->gridViewWidget->visualRect(index);
 
-            if (QFile::exists(coverPath) && 
-                pixmap.load(coverPath))
+        if (!itemRect.intersects(viewportRect))
+        {
+            // items are laid out in order,
+            // so we can stop after the last one
+            if (itemRect.top() > viewportRect.bottom())
             {
-                coverFileName = coverPath;
-                foundCover = true;
                 break;
             }
+            continue;
         }
 
-        if (foundCover)
+        // only (re)load when the cover hasn't been
+        // requested at the current icon size or larger
+        QSize coverSize = this->model->GetRequestedCoverSize(index);
+        if (coverSize.isValid() &&
+            coverSize.width() >= iconSize.width() &&
+            coverSize.height() >= iconSize.height())
         {
-            break;
+            continue;
         }
+
+        this->loadCover(index);
     }
-    // fallback
-    if (!foundCover)
+}
+
+void RomBrowserWidget::loadCover(QModelIndex index)
+{
+    RomBrowserModelData data;
+    if (!this->model->GetRomData(index, data))
     {
-        pixmap.load(":Resource/CoverFallback.png");
+        return;
     }
 
-    return QIcon(pixmap);
+    int romId = this->model->GetRomId(index);
+    QStringList coverNames = get_cover_names(data.file, data.header, data.settings);
+    QString coversDirectory = this->coversDirectory;
+    QString thumbnailsDirectory = this->coverThumbnailsDirectory;
+    QSize coverSize = this->gridViewWidget->iconSize() * this->devicePixelRatio();
+
+    this->model->SetRequestedCoverSize(index, this->gridViewWidget->iconSize());
+
+    this->coverLoaderPool.start([this, romId, coverNames, coversDirectory, thumbnailsDirectory, coverSize]
+    {
+        QString coverFile;
+        QImage image = load_cover_image(coversDirectory, thumbnailsDirectory, coverNames, coverSize, coverFile);
+
+        // items can only be updated on the UI thread
+        QMetaObject::invokeMethod(this, [this, romId, coverFile, image]
+        {
+            this->setCover(romId, coverFile, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RomBrowserWidget::setCover(int romId, QString coverFile, QImage image)
+{
+    if (image.isNull())
+    {
+        this->model->SetCover(romId, this->coverFallbackIcon, coverFile);
+    }
+    else
+    {
+        this->model->SetCover(romId, QIcon(QPixmap::fromImage(image)), coverFile);
+    }
 }
 
 void RomBrowserWidget::timerEvent(QTimerEvent* event)
@@ -623,9 +690,8 @@ void RomBrowserWidget::on_DoubleClicked(const QModelIndex& index)
 
 void RomBrowserWidget::customContextMenuRequested(QPoint position)
 {
-    QStandardItemModel* model = this->getCurrentModel();
-    QAbstractItemView*  view = this->getCurrentModelView();
-    if (view == nullptr || model == nullptr)
+    QAbstractItemView* view = this->getCurrentModelView();
+    if (view == nullptr)
     {
         return;
     }
@@ -695,7 +761,7 @@ void RomBrowserWidget::generateColumnsMenu(void)
 {
     this->menu_Columns->clear();
 
-    for (int i = 0; i < this->listViewModel->columnCount(); i++)
+    for (int i = 0; i < this->model->columnCount(); i++)
     {
         int column = this->listViewWidget->horizontalHeader()->logicalIndex(i);
 
@@ -712,20 +778,12 @@ void RomBrowserWidget::generateColumnsMenu(void)
 void RomBrowserWidget::generatePlayWithDiskMenu(void)
 {
     QAction* playGameWithAction;
-    QStandardItemModel* model = this->getCurrentModel();
-    RomBrowserModelData modelData;
     int count = 0;
 
     this->menu_PlayGameWithDisk->clear();
 
-    if (model == nullptr)
-    {
-        return;
-    }
-
-    for (int i = 0; i < model->rowCount(); i++)
+    for (const RomBrowserModelData& modelData : this->model->GetAllRomData())
     {
-        modelData = model->item(i)->data().value<RomBrowserModelData>();
         if (modelData.type == CoreRomType::Disk)
         {
             if (count == 0)
@@ -735,8 +793,8 @@ void RomBrowserWidget::generatePlayWithDiskMenu(void)
             }
 
             playGameWithAction = new QAction(this);
-            playGameWithAction->setText(model->item(i)->text());
-            playGameWithAction->setData(model->item(i)->data());
+            playGameWithAction->setText(modelData.name);
+            playGameWithAction->setData(QVariant::fromValue<RomBrowserModelData>(modelData));
             this->menu_PlayGameWithDisk->addAction(playGameWithAction);
 
             // only add 10 disks to menu,
@@ -823,7 +881,7 @@ void RomBrowserWidget::on_listViewWidget_sectionResized(int logicalIndex, int ol
             CoreSettingsSetValue(SettingsID::RomBrowser_ColumnVisibility, columnVisibility);
 
             int lastVisibleColumn = -1;
-            for (int i = 0; i < this->listViewModel->columnCount(); i++)
+            for (int i = 0; i < this->model->columnCount(); i++)
             {
                 int column = this->listViewWidget->horizontalHeader()->logicalIndex(i);
                 if (!this->listViewWidget->horizontalHeader()->isSectionHidden(column))
@@ -863,6 +921,9 @@ void RomBrowserWidget::on_gridViewWidget_iconSizeChanged(const QSize& size)
 {
     CoreSettingsSetValue(SettingsID::RomBrowser_GridViewIconWidth, size.width());
     CoreSettingsSetValue(SettingsID::RomBrowser_GridViewIconHeight, size.height());
+
+    // covers might need to be reloaded at the new size
+    this->coverLoaderTimer.start();
 }
 
 void RomBrowserWidget::on_ZoomIn(void)
@@ -887,23 +948,97 @@ void RomBrowserWidget::on_ZoomOut(void)
     view->setIconSize(view->iconSize() - QSize(10, 10));
 }
 
+void RomBrowserWidget::on_romDirectoryWatcher_directoryChanged(const QString& path)
+{
+    this->changedRomDirectories.insert(path);
+    this->romDirectoryTimer.start();
+}
+
 void RomBrowserWidget::on_RomBrowserThread_RomsFound(QList<RomSearcherThreadData> data, int index, int count)
 {
+    bool firstRoms = this->model->rowCount() == 0;
+
     // add every item to our dataset
-    for (qsizetype i = 0; i < data.size(); i++)
+    this->model->AddRoms(data);
+
+    // all rows have the same height, so use the height
+    // of the first row instead of resizing every row
+    if (firstRoms && this->model->rowCount() > 0)
     {
-        this->addRomData(data[i].File, data[i].Type, data[i].Header, data[i].Settings);
+        this->listViewWidget->resizeRowToContents(0);
+        this->listViewWidget->verticalHeader()->setDefaultSectionSize(this->listViewWidget->rowHeight(0));
     }
 
     // update loading widget
     this->loadingWidget->SetCurrentRomIndex(index, count);
 }
 
+void RomBrowserWidget::on_RomBrowserThread_RomsRemoved(QStringList files)
+{
+    this->model->RemoveRoms(files);
+}
+
+void RomBrowserWidget::on_RomBrowserThread_DirectoriesFound(QStringList directories)
+{
+    // only watch the directories which were searched
+    QStringList   watchedDirectories = this->romDirectoryWatcher.directories();
+    QSet<QString> watchedDirectorySet(watchedDirectories.begin(), watchedDirectories.end());
+    QSet<QString> directorySet(directories.begin(), directories.end());
+    QStringList   removedDirectories;
+    QStringList   addedDirectories;
+
+    for (const QString& directory : watchedDirectories)
+    {
+        if (!directorySet.contains(directory))
+        {
+            removedDirectories.append(directory);
+        }
+    }
+
+    for (const QString& directory : directories)
+    {
+        if (!watchedDirectorySet.contains(directory))
+        {
+            addedDirectories.append(directory);
+        }
+    }
+
+    if (!removedDirectories.isEmpty())
+    {
+        this->romDirectoryWatcher.removePaths(removedDirectories);
+    }
+    if (!addedDirectories.isEmpty())
+    {
+        this->romDirectoryWatcher.addPaths(addedDirectories);
+    }
+}
+
 void RomBrowserWidget::on_RomBrowserThread_Finished(bool canceled)
 {
+    if (this->romSearcherIncremental)
+    {
+        this->romSearcherIncremental = false;
+
+        // when canceled, a refresh will
+        // be triggered later on anyways
+        if (canceled)
+        {
+            return;
+        }
+
+        this->model->sort(CoreSettingsGetIntValue(SettingsID::RomBrowser_ListViewSortSection),
+                          (Qt::SortOrder)CoreSettingsGetIntValue(SettingsID::RomBrowser_ListViewSortOrder));
+        this->generatePlayWithDiskMenu();
+
+        if (this->model->rowCount() == 0)
+        {
+            this->setCurrentWidget(this->emptyWidget);
+        }
+        return;
+    }
+
     // sort data
-    this->listViewModel->sort(this->listViewSortSection, (Qt::SortOrder)this->listViewSortOrder);
-    this->gridViewModel->sort(0, Qt::SortOrder::AscendingOrder);
+    this->model->sort(this->listViewSortSection, (Qt::SortOrder)this->listViewSortOrder);
 
     // retrieve column settings
     std::vector<int> columnSizes = CoreSettingsGetIntListValue(SettingsID::RomBrowser_ColumnSizes);
@@ -915,10 +1050,10 @@ void RomBrowserWidget::on_RomBrowserThread_Finished(bool canceled)
 
     // reset column sizes setting in config file if number of values is incorrect
     if (!columnSizes.empty() && 
-        columnSizes.size() != this->listViewModel->columnCount())
+        columnSizes.size() != this->model->columnCount())
     {
         columnSizes.clear();
-        columnSizes.resize(this->listViewModel->columnCount(), -1);
+        columnSizes.resize(this->model->columnCount(), -1);
         CoreSettingsSetValue(SettingsID::RomBrowser_ColumnSizes, columnSizes);
     }
 
@@ -941,10 +1076,10 @@ void RomBrowserWidget::on_RomBrowserThread_Finished(bool canceled)
 
     // reset column order setting in config file if number of values is incorrect
     if (!columnOrder.empty() &&
-        columnOrder.size() != this->listViewModel->columnCount())
+        columnOrder.size() != this->model->columnCount())
     {
         columnOrder.clear();
-        for (int i = 0; i < this->listViewModel->columnCount(); i++)
+        for (int i = 0; i < this->model->columnCount(); i++)
         {
             columnOrder.push_back(i);
         }
@@ -959,10 +1094,10 @@ void RomBrowserWidget::on_RomBrowserThread_Finished(bool canceled)
 
     // reset column visibility setting in config file if number of values is incorrect
     if (!columnVisibility.empty() &&
-        columnVisibility.size() != this->listViewModel->columnCount())
+        columnVisibility.size() != this->model->columnCount())
     {
         columnVisibility.clear();
-        columnVisibility.resize(this->listViewModel->columnCount(), 0);
+        columnVisibility.resize(this->model->columnCount(), 0);
         for (int i = 0; i < 3; i++)
         {
             columnVisibility.at(i) = 1;
@@ -993,7 +1128,9 @@ void RomBrowserWidget::on_RomBrowserThread_Finished(bool canceled)
         return;
     }
 
-    if (this->listViewModel->rowCount() == 0)
+    CoreTraceEnd("ROM List Refresh", this->romSearcherTraceStart);
+
+    if (this->model->rowCount() == 0)
     {
         this->setCurrentWidget(this->emptyWidget);
         return;
@@ -1109,7 +1246,7 @@ void RomBrowserWidget::on_Action_ResetColumnSizes(void)
     std::vector<int> columnVisibility = CoreSettingsGetIntListValue(SettingsID::RomBrowser_ColumnVisibility);
     this->listViewWidget->horizontalHeader()->setStretchLastSection(false);
 
-    for (int i = 0; i < this->listViewModel->columnCount(); i++)
+    for (int i = 0; i < this->model->columnCount(); i++)
     {
         this->listViewWidget->horizontalHeader()->setSectionHidden(i, false);
     }
@@ -1130,11 +1267,9 @@ void RomBrowserWidget::on_Action_SetCoverImage(void)
 {
     QString sourceFile;
     QFileInfo sourceFileInfo;
-    QString coverFile;
 
-    QStandardItemModel* model = this->getCurrentModel();
-    QAbstractItemView*  view  = this->getCurrentModelView();
-    if (model == nullptr || view == nullptr)
+    QAbstractItemView* view = this->getCurrentModelView();
+    if (view == nullptr)
     {
         return;
     }
@@ -1154,8 +1289,11 @@ void RomBrowserWidget::on_Action_SetCoverImage(void)
     sourceFileInfo = QFileInfo(sourceFile);
 
     QModelIndex         index = view->currentIndex();
-    QStandardItem*      item  = model->item(index.row(), index.column());
-    RomBrowserModelData data  = model->itemData(index).last().value<RomBrowserModelData>();
+    RomBrowserModelData data;
+    if (!this->model->GetRomData(index, data))
+    {
+        return;
+    }
 
     // construct new file name (for the cover)
     QString newFileName = this->coversDirectory;
@@ -1184,24 +1322,23 @@ void RomBrowserWidget::on_Action_SetCoverImage(void)
     QFile::copy(sourceFile, newFileName);
 
     // update item
-    item->setIcon(this->getCurrentCover(data.file, data.header, data.settings, coverFile));
-    data.coverFile = coverFile;
-    item->setData(QVariant::fromValue<RomBrowserModelData>(data));
+    this->loadCover(index);
 }
 
 void RomBrowserWidget::on_Action_RemoveCoverImage(void)
 {
-    QStandardItemModel* model = this->getCurrentModel();
-    QAbstractItemView*  view  = this->getCurrentModelView();
-    if (model == nullptr || view == nullptr)
+    QAbstractItemView* view = this->getCurrentModelView();
+    if (view == nullptr)
     {
         return;
     }
 
     QModelIndex         index = view->currentIndex();
-    QStandardItem*      item  = model->item(index.row(), index.column());
-    RomBrowserModelData data  = model->itemData(index).last().value<RomBrowserModelData>();
-    QString coverFile;
+    RomBrowserModelData data;
+    if (!this->model->GetRomData(index, data))
+    {
+        return;
+    }
 
     if (!data.coverFile.isEmpty() && QFile::exists(data.coverFile))
     {
@@ -1209,7 +1346,5 @@ void RomBrowserWidget::on_Action_RemoveCoverImage(void)
     }
 
     // update item
-    item->setIcon(this->getCurrentCover(data.file, data.header, data.settings, coverFile));
-    data.coverFile = coverFile;
-    item->setData(QVariant::fromValue<RomBrowserModelData>(data));
+    this->loadCover(index);
 }
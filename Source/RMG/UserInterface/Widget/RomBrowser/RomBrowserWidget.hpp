@@ -17,21 +17,26 @@
 #include "RomBrowserGridViewWidget.hpp"
 #include "RomBrowserLoadingWidget.hpp"
 #include "RomBrowserEmptyWidget.hpp"
+#include "RomBrowserModel.hpp"
 
-#include <QStandardItemModel>
+#include <QFileSystemWatcher>
 #include <QStackedWidget>
+#include <QThreadPool>
 #include <QGridLayout>
 #include <QListWidget>
 #include <QHeaderView>
 #include <QTableView>
 #include <QAction>
 #include <QString>
+#include <QTimer>
+#include <QImage>
+#include <QIcon>
 #include <QList>
 #include <QMenu>
 #include <QMap>
+#include <QSet>
 
-// forward declaration of internal struct
-struct RomBrowserModelData;
+#include <RMG-Core/Trace.hpp>
 
 namespace UserInterface
 {
@@ -45,7 +50,11 @@ class RomBrowserWidget : public QStackedWidget
     RomBrowserWidget(QWidget *);
     ~RomBrowserWidget(void);
 
-    void RefreshRomList(void);
+    // refreshes the ROM list, when useSnapshot is set,
+    // directories which haven't been modified since they
+    // were last listed aren't listed again, otherwise every
+    // directory is, in case a modification was missed
+    void RefreshRomList(bool useSnapshot = false);
     bool IsRefreshingRomList(void);
     void StopRefreshRomList(void);
 
@@ -61,14 +70,19 @@ class RomBrowserWidget : public QStackedWidget
     Widget::RomBrowserLoadingWidget*  loadingWidget  = nullptr;
 
     Widget::RomBrowserListViewWidget* listViewWidget = nullptr;
-    QStandardItemModel* listViewModel                = nullptr;
     Widget::RomBrowserGridViewWidget* gridViewWidget = nullptr;
-    QStandardItemModel* gridViewModel                = nullptr;
+    Widget::RomBrowserModel*          model          = nullptr;
 
     QWidget* currentViewWidget = nullptr;
 
     QElapsedTimer romSearcherTimer;
+    CoreTraceTime romSearcherTraceStart = 0;
     Thread::RomSearcherThread* romSearcherThread = nullptr;
+    bool romSearcherIncremental = false;
+
+    QFileSystemWatcher romDirectoryWatcher;
+    QTimer             romDirectoryTimer;
+    QSet<QString>      changedRomDirectories;
   
     int listViewSortSection = 0;
     int listViewSortOrder = 0;
@@ -95,16 +109,22 @@ class RomBrowserWidget : public QStackedWidget
     QAction* action_ColumnsMenuEntry;
 
     QString coversDirectory;
+    QString coverThumbnailsDirectory;
+    QIcon   coverFallbackIcon;
+
+    QThreadPool coverLoaderPool;
+    QTimer      coverLoaderTimer;
 
-    QStandardItemModel* getCurrentModel(void);
     QAbstractItemView*  getCurrentModelView(void);
     bool getCurrentData(RomBrowserModelData& data);
 
     QString getCurrentRom(void);
 
-    void addRomData(QString file, CoreRomType type, CoreRomHeader header, CoreRomSettings settings);
+    void updateRomList(void);
 
-    QIcon getCurrentCover(QString file, CoreRomHeader header, CoreRomSettings settings, QString& coverFileName);
+    void loadVisibleCovers(void);
+    void loadCover(QModelIndex index);
+    void setCover(int romId, QString coverFile, QImage image);
 
   protected:
     void timerEvent(QTimerEvent *event) Q_DECL_OVERRIDE;
@@ -126,7 +146,11 @@ class RomBrowserWidget : public QStackedWidget
     void on_ZoomIn(void);
     void on_ZoomOut(void);
 
+    void on_romDirectoryWatcher_directoryChanged(const QString& path);
+
     void on_RomBrowserThread_RomsFound(QList<RomSearcherThreadData> data, int index, int count);
+    void on_RomBrowserThread_RomsRemoved(QStringList files);
+    void on_RomBrowserThread_DirectoriesFound(QStringList directories);
     void on_RomBrowserThread_Finished(bool canceled);
 
     void on_Action_PlayGame(void);
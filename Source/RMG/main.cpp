@@ -23,6 +23,7 @@
 
 #include <RMG-Core/Directories.hpp>
 #include <RMG-Core/Version.hpp>
+#include <RMG-Core/Trace.hpp>
 
 //
 // Local Functions
@@ -133,7 +134,7 @@ int main(int argc, char **argv)
     pluginPathOption.setFlags(QCommandLineOption::HiddenFromHelp);
     sharedDataPathOption.setFlags(QCommandLineOption::HiddenFromHelp);
 #endif // PORTABLE_INSTALL
-    QCommandLineOption debugMessagesOption({"d", "debug-messages"}, "Prints debug callback messages to stdout");
+    QCommandLineOption debugMessagesOption({"d", "debug-messages"}, "Prints debug callback messages to stdout and saves a startup trace");
     QCommandLineOption fullscreenOption({"f", "fullscreen"}, "Launches ROM in fullscreen mode");
     QCommandLineOption noGuiOption({"n", "nogui"}, "Hides GUI elements (menubar, toolbar, statusbar)");
     QCommandLineOption quitAfterEmulationOption({"q", "quit-after-emulation"}, "Quits RMG when emulation has finished");
@@ -181,8 +182,10 @@ int main(int argc, char **argv)
     }
 #endif // PORTABLE_INSTALL
 
-    // print debug callbacks to stdout if needed
+    // print debug callbacks to stdout
+    // and record a startup trace if needed
     CoreSetPrintDebugCallback(parser.isSet(debugMessagesOption));
+    CoreSetTraceEnabled(parser.isSet(debugMessagesOption));
 
     // specified ROM path to launch
     QStringList args = parser.positionalArguments();